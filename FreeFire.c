@@ -10,23 +10,116 @@
  * @date Janeiro 2026
  */
 
-#include <stdio.h>  // Entrada/Saída padrão (printf, scanf, fgets)
-#include <stdlib.h> // Funções de alocação de memória (malloc, free)
-#include <string.h> // Funções de manipulação de strings (strcmp, strcpy, strcspn)
-#include <time.h>   // Medição de tempo (clock, CLOCKS_PER_SEC)
+#define _GNU_SOURCE // Habilita clock_gettime, strcasecmp e demais extensões POSIX
 
-/** @def MAX_COMPONENTES Capacidade máxima de componentes na mochila */
-#define MAX_COMPONENTES 20
+#include <fcntl.h>   // open (snapshot mapeado em memória)
+#include <pthread.h> // Pool de threads (ordenação e busca paralelas)
+#include <stddef.h>  // offsetof (acesso genérico aos campos de Componente)
+#include <stdint.h>  // Inteiros de largura fixa do formato binário do snapshot
+#include <stdio.h>   // Entrada/Saída padrão (printf, scanf, fgets)
+#include <stdlib.h>  // Funções de alocação de memória (malloc, free)
+#include <string.h>  // Funções de manipulação de strings (strcmp, strcpy, strcspn)
+#include <strings.h> // Comparação sem diferenciar maiúsculas (strcasecmp)
+#include <time.h>    // Medição de tempo (clock_gettime: CLOCK_MONOTONIC, CLOCK_PROCESS_CPUTIME_ID)
+#include <poll.h>    // Espera por conexões com tempo limite (servidor)
+#include <signal.h>  // SIGINT/SIGTERM encerram o servidor; SIGPIPE ignorado
+#include <sys/mman.h> // mmap do snapshot binário
+#include <sys/socket.h> // Servidor e gerador de carga (socket Unix)
+#include <sys/stat.h> // fstat (tamanho do snapshot)
+#include <sys/un.h>   // sockaddr_un
+#include <unistd.h>  // close, read, syscall, sysconf (núcleos disponíveis), fsync
+
+#ifdef __GLIBC__
+#include <malloc.h> // malloc_usable_size (memória real do armazenamento com malloc por item)
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h> // Contadores de hardware (perf_event_open)
+#include <sys/ioctl.h>        // Controle dos contadores (reset, enable, disable)
+#include <sys/syscall.h>      // SYS_perf_event_open (sem wrapper na glibc)
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // Intrínsecos SSE2/AVX2 dos kernels de comparação de nome e tipo
+#define COMPARACAO_SIMD_X86 1
+#endif
+
+/** @def CAPACIDADE_INICIAL Número de posições alocadas na primeira inserção da mochila dinâmica */
+#define CAPACIDADE_INICIAL 16
 
 /** @def MAX_STR_LEN Tamanho máximo para strings (nome e tipo) */
 #define MAX_STR_LEN 30
 
+/** @def CAPACIDADE_MOCHILA Limite padrão do menu interativo (regra do jogo); 0 = sem limite */
+#define CAPACIDADE_MOCHILA 10
+
+/** @def TAM_BLOCO_ORDENADO Capacidade de cada bloco do índice ordenado por nome */
+#define TAM_BLOCO_ORDENADO 512
+
+/** @def MAX_LINHA_LOTE Tamanho máximo de uma linha de comando no modo em lote */
+#define MAX_LINHA_LOTE 4096
+
+/** @def TAM_BLOCO_ES Tamanho dos blocos de leitura/escrita da importação e exportação */
+#define TAM_BLOCO_ES (1 << 20)
+
+/** @def TAM_BUFFER_LISTAGEM Buffer de saída da listagem: linhas formatadas à mão e gravadas com um write() por bloco */
+#define TAM_BUFFER_LISTAGEM (1 << 16)
+
+/** @def MAX_THREADS Teto do pool de threads (mesmo com --threads maior) */
+#define MAX_THREADS 64
+
+/** @def TAM_CHAVE_NOME Bytes de uma chave de busca preparada: nome (30) + folga zerada para leituras de 32 bytes */
+#define TAM_CHAVE_NOME 32
+
 /**
  * @brief Variável global para contar comparações em operações com vetores
  * @details Incrementada durante algoritmos de ordenação e busca
- *          Utilizada para análise de complexidade temporal O(n)
+ *          Utilizada para análise de complexidade temporal O(n).
+ *          Uma cópia por thread (threads do servidor buscam ao mesmo tempo) e
+ *          64 bits: o Bubble Sort com 10^5 itens já passa de 2^31 comparações.
+ *          Os totais acumulados ficam nas métricas (metricasRegistrar)
+ */
+_Thread_local long long comparacoesVetor = 0;
+
+/**
+ * @brief Variável global com o número de trocas/movimentos da última ordenação
+ * @details Complementa comparacoesVetor: trocas (Bubble/Selection/IntroSort),
+ *          deslocamentos (Insertion) ou registros movidos (MergeSort/RadixSort)
+ */
+_Thread_local long long trocasVetor = 0;
+
+/**
+ * @brief Variável global para bytes de registros/chaves copiados na última ordenação
+ * @details Mede o tráfego de memória das trocas: cada troca de Componente
+ *          copia 3 × sizeof(Componente) bytes (temp, a, b)
+ */
+_Thread_local long long bytesMovidosVetor = 0;
+
+/**
+ * @brief Flag global que liga os contadores de hardware (perf_event_open) nas medições
+ * @details Ativada pela opção --perf; desligada por padrão porque exige
+ *          permissão do kernel (perf_event_paranoid) e não existe fora do Linux
+ */
+int contadoresHardwareAtivos = 0;
+
+/**
+ * @brief Número de threads do pool (opção --threads N); 0 = um por núcleo disponível
+ */
+int threadsConfiguradas = 0;
+
+/**
+ * @brief Flag global que suprime a telemetria impressa pelos algoritmos
+ * @details Ativada no modo em lote (--batch), onde milhares de operações são
+ *          executadas em sequência e só o relatório agregado final interessa
+ */
+int modoSilencioso = 0;
+
+/**
+ * @brief Máximo de linhas das listagens automáticas e de LIST sem argumentos (--listar-max N); 0 = todas
+ * @details As tabelas exibidas após cada inserção e ordenação dominam o tempo
+ *          com inventários grandes; o restante continua acessível por página
  */
-int comparacoesVetor = 0;
+int limiteListagem = 0;
 
 /**
  * @struct Componente
@@ -43,6 +136,311 @@ typedef struct {
     int prioridade; /**< Prioridade de montagem (1-10) */
 } Componente;
 
+/**
+ * @struct IndiceHash
+ * @brief Índice hash nome -> posição no vetor de itens (endereçamento aberto)
+ * @details Sondagem linear em tabela com tamanho potência de 2 e fator de carga
+ *          máximo de 50%. A remoção usa deslocamento para trás (backward shift),
+ *          então não há marcadores de "apagado" degradando as buscas. O hash de
+ *          cada entrada fica guardado para evitar strcmp em colisões.
+ */
+typedef struct {
+    int *posicoes;           /**< slot -> posição em Mochila.itens (-1 = vazio) */
+    unsigned *hashes;        /**< Hash do nome armazenado em cada slot */
+    int capacidade;          /**< Número de slots (potência de 2, 0 = não alocado) */
+    int ocupados;            /**< Slots em uso */
+    long long buscas;        /**< Telemetria: buscas realizadas */
+    long long sondagens;     /**< Telemetria: slots visitados em buscas */
+    long long colisoes;      /**< Telemetria: inserções cujo slot inicial estava ocupado */
+    int maiorSondagem;       /**< Telemetria: maior sequência de slots visitados */
+    int sondagensUltimaBusca; /**< Telemetria: slots visitados na última busca */
+} IndiceHash;
+
+/**
+ * @struct BlocoOrdenado
+ * @brief Bloco do índice ordenado: até TAM_BLOCO_ORDENADO posições em ordem de nome
+ */
+typedef struct {
+    int *posicoes;  /**< Posições em Mochila.itens, ordenadas pelo nome */
+    int quantidade; /**< Posições em uso no bloco */
+} BlocoOrdenado;
+
+/**
+ * @struct IndiceOrdenado
+ * @brief Índice ordenado por nome em blocos (estilo folhas de B-tree)
+ * @details Mantém a ordem alfabética válida após cada inserção e descarte,
+ *          sem reordenar a mochila. A busca é binária em dois níveis (pelo
+ *          último nome de cada bloco e depois dentro do bloco); a inserção
+ *          desloca no máximo um bloco e o divide ao meio quando enche.
+ *          Custo por mutação: O(log n) comparações + O(B) movimentos.
+ */
+typedef struct {
+    BlocoOrdenado *blocos;          /**< Blocos em ordem de nome */
+    int numBlocos;                  /**< Blocos em uso */
+    int capacidadeBlocos;           /**< Blocos alocados */
+    int total;                      /**< Posições indexadas */
+    long long comparacoes;          /**< Contador de trabalho: comparações da operação em curso */
+    long long movimentos;           /**< Contador de trabalho: posições deslocadas na operação em curso */
+    long long comparacoesUltimaMutacao; /**< Telemetria: comparações da última inserção/descarte */
+    long long movimentosUltimaMutacao;  /**< Telemetria: movimentos da última inserção/descarte */
+    long long mutacoes;             /**< Telemetria: inserções + remoções + movimentações */
+    long long comparacoesMutacoes;  /**< Telemetria: comparações acumuladas em mutações */
+    long long movimentosMutacoes;   /**< Telemetria: movimentos acumulados em mutações */
+} IndiceOrdenado;
+
+/**
+ * @struct HeapPrioridade
+ * @brief Fila de prioridade (heap máximo) sobre as posições da mochila
+ * @details entradas[0] é sempre o componente mais urgente (maior prioridade;
+ *          empate: menor nome). posicaoNoHeap[pos] guarda onde a posição pos
+ *          está no heap, o que permite remover/atualizar qualquer item em
+ *          O(log n) quando a mochila descarta ou move componentes.
+ */
+typedef struct {
+    int *entradas;          /**< Posições em Mochila.itens, organizadas como heap binário */
+    int *posicaoNoHeap;     /**< Inverso de entradas: posição do item -> índice no heap */
+    int quantidade;         /**< Entradas em uso */
+    int capacidade;         /**< Entradas alocadas (vale para os dois vetores) */
+    long long comparacoes;  /**< Telemetria: comparações acumuladas na manutenção */
+    long long movimentos;   /**< Telemetria: entradas movidas na manutenção */
+} HeapPrioridade;
+
+/**
+ * @struct GrupoSecundario
+ * @brief Um valor distinto da chave secundária e as posições que o possuem
+ */
+typedef struct {
+    char tipo[20];            /**< Chave do grupo no índice por tipo */
+    int prioridade;           /**< Chave do grupo no índice por prioridade */
+    int *posicoes;            /**< Posições em Mochila.itens com esta chave (ordem de chegada, sem garantia) */
+    int quantidade;           /**< Posições em uso */
+    int capacidade;           /**< Posições alocadas */
+    long long somaQuantidade; /**< Agregado: soma de Componente.quantidade do grupo */
+} GrupoSecundario;
+
+/**
+ * @struct IndiceSecundario
+ * @brief Índice secundário por tipo ou por prioridade (chaves distintas ordenadas + grupos)
+ * @details Os valores distintos da chave ficam em um vetor ordenado (busca
+ *          binária em O(log g), g = número de grupos) e cada grupo guarda as
+ *          posições com aquela chave. slotNoGrupo[pos] diz onde pos está dentro
+ *          do seu grupo, então inserir, remover e mover custam O(log g) + O(1).
+ *          Consultas custam O(log g + k), k = tamanho do resultado, e o total de
+ *          quantidade de cada grupo é mantido a cada mutação.
+ */
+typedef struct {
+    int porPrioridade;          /**< 0 = chave tipo, 1 = chave prioridade */
+    GrupoSecundario *grupos;    /**< Grupos em ordem crescente de chave */
+    int numGrupos;              /**< Grupos em uso */
+    int capacidadeGrupos;       /**< Grupos alocados */
+    int *slotNoGrupo;           /**< Posição do item -> índice dentro de grupos[..].posicoes */
+    int capacidadeSlots;        /**< Entradas alocadas em slotNoGrupo */
+    long long comparacoes;      /**< Contador de trabalho: comparações da operação em curso */
+    long long movimentos;       /**< Contador de trabalho: entradas deslocadas na operação em curso */
+    long long comparacoesUltimaMutacao; /**< Telemetria: comparações da última inserção/descarte */
+    long long movimentosUltimaMutacao;  /**< Telemetria: movimentos da última inserção/descarte */
+    long long mutacoes;         /**< Telemetria: inserções + remoções */
+    long long comparacoesMutacoes; /**< Telemetria: comparações acumuladas em mutações */
+    long long movimentosMutacoes;  /**< Telemetria: movimentos acumulados em mutações */
+} IndiceSecundario;
+
+/**
+ * @struct IndiceEytzinger
+ * @brief Nomes em ordem de busca em largura (layout de Eytzinger) para buscas repetidas
+ * @details chaves[1] é a raiz e os filhos de k ficam em 2k e 2k+1, então os
+ *          primeiros níveis da árvore ocupam poucas linhas de cache e os
+ *          níveis seguintes podem ser pré-carregados. Cada chave tem 32 bytes
+ *          (duas por linha de 64 bytes) em vez do registro inteiro de 60: o
+ *          nome completado com zeros em 4 palavras big-endian, que comparadas
+ *          como inteiros dão a mesma ordem de strcmp, sem desvios.
+ */
+typedef struct {
+    uint64_t (*chaves)[4];          /**< chaves[1..tamanho]: nome em 4 palavras big-endian */
+    int *posicoes;                  /**< posicoes[k]: posição em Mochila.itens do nome em chaves[k] */
+    int tamanho;                    /**< Nomes indexados */
+    int capacidade;                 /**< Chaves alocadas (sem contar a posição 0) */
+    int valido;                     /**< 0 = a mochila mudou desde a construção */
+} IndiceEytzinger;
+
+/**
+ * @struct NoRadix
+ * @brief Nó da árvore radix por nome (trie comprimida), 20 bytes
+ * @details O rótulo é o trecho do nome entre o pai e o nó (cadeias sem
+ *          ramificação viram um único nó). Os filhos de um nó ficam contíguos
+ *          em nos[] e em ordem alfabética, e as folhas de qualquer subárvore
+ *          formam o intervalo [inicio, fim) de IndiceRadix.ordem: uma busca
+ *          por prefixo termina num nó e devolve o intervalo inteiro
+ */
+typedef struct {
+    uint32_t rotulo;        /**< Deslocamento do rótulo em IndiceRadix.rotulos */
+    uint32_t primeiroFilho; /**< Índice do primeiro filho em nos[] */
+    uint32_t inicio;        /**< Primeiro nome da subárvore em ordem[] */
+    uint32_t fim;           /**< Um após o último nome da subárvore */
+    uint16_t totalFilhos;   /**< Filhos (um por primeiro caractere distinto) */
+    uint8_t tamanhoRotulo;  /**< Caracteres do rótulo */
+    uint8_t terminal;       /**< 1 = nomes terminam aqui: ordem[inicio] em diante, até o primeiro filho */
+} NoRadix;
+
+/**
+ * @struct IndiceRadix
+ * @brief Árvore radix sobre os nomes: prefixo, autocompletar e busca aproximada
+ * @details Construída em O(n log n) a partir dos nomes já em ordem alfabética.
+ *          iniciais[k] repete o primeiro caractere do rótulo de nos[k]: como
+ *          os irmãos são contíguos, achar o filho certo é um memchr em poucos bytes
+ */
+typedef struct {
+    NoRadix *nos;             /**< nos[0] = raiz */
+    unsigned char *iniciais;  /**< iniciais[k]: primeiro caractere do rótulo de nos[k] */
+    char *rotulos;            /**< Rótulos concatenados, sem terminador */
+    int *ordem;               /**< Posições em Mochila.itens em ordem alfabética */
+    int totalNos;             /**< Nós usados */
+    int capacidadeNos;        /**< Nós alocados */
+    size_t totalRotulos;      /**< Bytes de rótulos usados */
+    size_t capacidadeRotulos; /**< Bytes de rótulos alocados */
+    int tamanho;              /**< Nomes indexados */
+    int valido;               /**< 0 = a mochila mudou desde a construção */
+} IndiceRadix;
+
+/** @def MAX_TIPOS_DISTINTOS Tipos distintos aceitos pelo dicionário (ids de 16 bits) */
+#define MAX_TIPOS_DISTINTOS 65535
+
+/**
+ * @struct EntradaTipo
+ * @brief Um tipo distinto do dicionário (32 bytes)
+ */
+typedef struct {
+    char texto[20];   /**< Tipo original, como em Componente.tipo */
+    unsigned hash;    /**< hashNome(texto) */
+    int contagem;     /**< Componentes com este tipo */
+    uint16_t posto;   /**< Posição do tipo em ordem alfabética (válida se DicionarioTipos.ordemValida) */
+} EntradaTipo;
+
+/**
+ * @struct DicionarioTipos
+ * @brief Dicionário tipo -> id compacto de 16 bits (0, 1, 2, ... na ordem de chegada)
+ * @details Inventários reais têm poucos tipos distintos: com o id de cada
+ *          registro calculado na inserção, ordenar ou agrupar por tipo vira
+ *          um Counting Sort O(n + k) sobre ids de 2 bytes, sem strcmp por
+ *          item. A ordem alfabética dos k tipos (posto) é calculada sob
+ *          demanda em O(k log k) e só é refeita quando surge um tipo novo.
+ *          O texto original continua disponível por id
+ */
+typedef struct {
+    EntradaTipo *entradas; /**< entradas[id] */
+    int total;             /**< Ids atribuídos */
+    int capacidade;        /**< Entradas alocadas */
+    uint16_t *slots;       /**< Tabela hash: id + 1 (0 = vazio), sondagem linear */
+    int capacidadeSlots;   /**< Potência de 2, fator de carga máximo de 50% */
+    int ordemValida;       /**< 1 = postos atualizados */
+    long long comparacoes; /**< Comparações de texto feitas (confirmação de hash e ordenação dos postos) */
+} DicionarioTipos;
+
+/**
+ * @struct Mochila
+ * @brief Inventário dinâmico de componentes (vetor redimensionável)
+ * @details Cresce dobrando a capacidade alocada, o que garante inserção no
+ *          final em O(1) amortizado. O campo limite permite reproduzir a regra
+ *          do jogo (10 itens) ou liberar o crescimento para testes de escala.
+ *          O vetor itens é contíguo, então continua compatível com todas as
+ *          funções que recebem (Componente arr[], int tamanho).
+ */
+typedef struct {
+    Componente *itens;   /**< Vetor alocado dinamicamente */
+    int quantidade;      /**< Número de componentes em uso */
+    int capacidade;      /**< Número de posições alocadas */
+    int limite;          /**< Máximo de componentes aceitos (0 = sem limite) */
+    int ordenadaPorNome; /**< Flag: 1 = itens ordenados por nome (busca binária válida) */
+    IndiceHash indiceNome; /**< Índice hash nome -> posição, atualizado a cada inserção/descarte */
+    IndiceOrdenado ordemNome; /**< Posições em ordem alfabética, mantida a cada inserção/descarte */
+    HeapPrioridade filaPrioridade; /**< Heap máximo por prioridade, mantido a cada inserção/descarte */
+    IndiceSecundario porTipo;       /**< Grupos por tipo (com total de quantidade), mantidos a cada mutação */
+    IndiceSecundario porPrioridade; /**< Grupos por prioridade, para consultas por faixa */
+    IndiceEytzinger eytzinger;      /**< Busca por nome sem desvios, reconstruída sob demanda após mutações */
+    IndiceRadix radix;              /**< Prefixo e busca aproximada por nome, reconstruída sob demanda após mutações */
+    DicionarioTipos tipos;          /**< Tipos distintos, com id compacto e contagem */
+    uint16_t *idsTipo;              /**< idsTipo[i]: id do tipo de itens[i] (mesma capacidade de itens) */
+    struct DiarioOperacoes *diario; /**< Diário que registra inserções/descartes (NULL = sem diário) */
+} Mochila;
+
+/**
+ * @enum CriterioOrdenacao
+ * @brief Campo usado como chave de ordenação
+ * @details NOME e TIPO em ordem alfabética crescente; PRIORIDADE em ordem
+ *          decrescente (maior urgência primeiro), como em selectionSortPrioridade
+ */
+typedef enum {
+    CRITERIO_NOME,       /**< Ordem alfabética por nome */
+    CRITERIO_TIPO,       /**< Ordem alfabética por tipo */
+    CRITERIO_PRIORIDADE, /**< Prioridade decrescente */
+    TOTAL_CRITERIOS
+} CriterioOrdenacao;
+
+/**
+ * @struct ChaveComposta
+ * @brief Um campo de uma ordenação com várias chaves e o seu sentido
+ */
+typedef struct {
+    CriterioOrdenacao campo; /**< Campo comparado */
+    int decrescente;         /**< 1 = do maior para o menor (Z-A, prioridade 10-1) */
+} ChaveComposta;
+
+/**
+ * @struct EspecificacaoOrdenacao
+ * @brief Lista de chaves aplicadas em sequência (ex: "tipo asc, prioridade desc, nome asc")
+ * @details A segunda chave só desempata a primeira, e assim por diante; cada
+ *          campo aparece no máximo uma vez
+ */
+typedef struct {
+    int total;                              /**< Chaves usadas (1..TOTAL_CRITERIOS) */
+    ChaveComposta chaves[TOTAL_CRITERIOS]; /**< Chaves em ordem de precedência */
+} EspecificacaoOrdenacao;
+
+/**
+ * @enum AlgoritmoOrdenacao
+ * @brief Estratégias disponíveis no motor de ordenação
+ * @details CLASSICO seleciona o algoritmo O(n²) histórico de cada critério:
+ *          Bubble Sort (nome), Insertion Sort (tipo), Selection Sort (prioridade)
+ */
+typedef enum {
+    ALGORITMO_CLASSICO,  /**< Bubble/Insertion/Selection - O(n²) */
+    ALGORITMO_INTROSORT, /**< Quicksort + Heapsort + Insertion - O(n log n), não estável */
+    ALGORITMO_MERGESORT, /**< Merge Sort top-down - O(n log n), estável */
+    ALGORITMO_RADIXSORT, /**< Radix Sort (LSD p/ prioridade, MSD p/ textos) - O(n·w), estável */
+    ALGORITMO_CHAVES,    /**< Ordena pares chave/índice compactos e permuta os registros uma vez, estável */
+    ALGORITMO_PARALELO,  /**< Merge Sort paralelo no pool de threads - O(n log n / p), estável */
+    ALGORITMO_CONTAGEM,  /**< Counting Sort sobre ids do dicionário de tipos - O(n + k), estável (nome/prioridade: Radix) */
+    ALGORITMO_ADAPTATIVO, /**< TimSort: detecta sequências já ordenadas - O(n) quase ordenado, O(n log n) no pior caso, estável */
+    TOTAL_ALGORITMOS
+} AlgoritmoOrdenacao;
+
+/**
+ * @struct ContextoOrdenacao
+ * @brief Estado de uma execução do motor de ordenação
+ * @details Os contadores ficam no contexto (e não em variáveis globais) para
+ *          que cada execução tenha sua própria telemetria; ao final eles são
+ *          copiados para comparacoesVetor / trocasVetor
+ */
+typedef struct {
+    CriterioOrdenacao criterio; /**< Chave de ordenação */
+    long long comparacoes;      /**< Comparações entre chaves */
+    long long trocas;           /**< Trocas ou registros movidos */
+    long long bytesMovidos;     /**< Bytes copiados (registros e chaves) */
+    const EspecificacaoOrdenacao *especificacao; /**< Várias chaves (NULL = só o critério) */
+} ContextoOrdenacao;
+
+/**
+ * @struct ChaveOrdenacao
+ * @brief Par chave/índice usado pelo layout de chaves extraídas (ALGORITMO_CHAVES)
+ * @details 16 bytes em vez dos sizeof(Componente) = 60: a ordenação move só
+ *          os pares e os registros são permutados uma única vez no final.
+ *          chave = 8 primeiros bytes do texto em big-endian (a ordem numérica
+ *          coincide com a de strcmp) ou a prioridade mapeada para ordem crescente
+ */
+typedef struct {
+    unsigned long long chave; /**< Prefixo normalizado ou prioridade codificada */
+    int indice;               /**< Posição original do registro */
+} ChaveOrdenacao;
+
 // ============================================================================
 // PROTÓTIPOS DAS FUNÇÕES OBRIGATÓRIAS - DESAFIO MESTRE
 // ============================================================================
@@ -93,6 +491,34 @@ void bubbleSortNome(Componente arr[], int tamanho);
  */
 int buscaBinariaPorNome(Componente arr[], int tamanho, char nome[]);
 
+/**
+ * @brief Resolve muitos nomes de uma vez em uma única passada pelo array
+ * @param arr Array de componentes ORDENADO POR NOME
+ * @param tamanho Número de elementos no array
+ * @param nomes Nomes procurados (qualquer ordem, repetições permitidas)
+ * @param totalConsultas Número de nomes
+ * @param resultados Índice de cada nome em arr (primeira ocorrência), ou -1 (SAÍDA)
+ * @return Número de nomes encontrados, ou -1 se faltou memória
+ * @details Algoritmo: ordena as consultas (Merge Sort) e resolve-as em uma
+ *          passada, da esquerda para a direita, em grupos de consultas vizinhas
+ *          cujas buscas binárias avançam intercaladas, nível a nível.
+ *          Complexidade: O(q log q + q log n) comparações (q = consultas)
+ *          Telemetria: comparacoesVetor recebe o total (ordenação + passada)
+ */
+int buscaEmLotePorNome(const Componente arr[], int tamanho, char nomes[][MAX_STR_LEN], int totalConsultas,
+                       int resultados[]);
+
+/**
+ * @struct EstatisticasListagem
+ * @brief Custo de uma listagem: linhas, bytes, chamadas write() e tempo
+ */
+typedef struct {
+    long long linhas;   /**< Linhas de componentes escritas */
+    long long bytes;    /**< Bytes gravados pelo buffer (linhas e rodapé; o cabeçalho vai pelo stdio) */
+    long long escritas; /**< Chamadas write() (ou fwrite, sem descritor) */
+    long long tempoNs;  /**< Tempo de parede da formatação + escrita */
+} EstatisticasListagem;
+
 /**
  * @brief Exibe tabela formatada com todos os componentes
  * @param arr Array de componentes a exibir
@@ -100,544 +526,10684 @@ int buscaBinariaPorNome(Componente arr[], int tamanho, char nome[]);
  * @details Formato: Tabela com 4 colunas (NOME | TIPO | QUANTIDADE | PRIORIDADE)
  *          Largura fixa para melhor legibilidade
  *          Inclui separadores visuais de linha
+ *          Respeita limiteListagem (--listar-max): as demais linhas ficam para mostrarComponentesPagina
  */
 void mostrarComponentes(Componente arr[], int tamanho);
 
 /**
- * @brief Mede o tempo de CPU gasto na execução de um algoritmo
+ * @brief Exibe uma página da tabela de componentes
+ * @param inicio Primeira linha exibida (0 = primeira)
+ * @param quantidade Linhas exibidas (0 = até o fim)
+ * @param est Custo da listagem (SAÍDA; pode ser NULL)
+ */
+void mostrarComponentesPagina(const Componente arr[], int tamanho, int inicio, int quantidade, EstatisticasListagem *est);
+
+/**
+ * @brief Escreve a tabela de componentes em um arquivo, sem printf por linha
+ * @param saida Destino (stdout, arquivo, /dev/null...)
+ * @param arr Array de componentes
+ * @param tamanho Total de componentes (exibido no cabeçalho)
+ * @param inicio Primeira linha exibida
+ * @param quantidade Linhas exibidas (0 = até o fim)
+ * @param est Custo da listagem (SAÍDA; pode ser NULL)
+ * @details Saída idêntica à do printf("%-20s | %-15s | %-11d | %-10d\n"): cada linha
+ *          é montada com memcpy, preenchimento de espaços e conversão de inteiros
+ *          própria em um buffer de TAM_BUFFER_LISTAGEM bytes, gravado com um único
+ *          write() quando enche. Listar 10⁶ linhas passa a custar o I/O, não a
+ *          interpretação do formato
+ */
+void escreverComponentes(FILE *saida, const Componente arr[], int tamanho, int inicio, int quantidade,
+                         EstatisticasListagem *est);
+
+/**
+ * @brief Exibe o custo de uma listagem (linhas/s, bytes e chamadas write)
+ */
+void mostrarCustoListagem(const EstatisticasListagem *est);
+
+/**
+ * @brief Mede e exibe o tempo gasto na execução de um algoritmo
  * @param algoritmo Ponteiro para função de ordenação (bubbleSortNome, insertionSortTipo ou selectionSortPrioridade)
  * @param arr Array de componentes
  * @param tamanho Número de elementos
  * @param descricao String descritiva do algoritmo (para exibição)
- * @details Usa clock() para medir tempo em ticks do processador
- *          Converte para segundos usando CLOCKS_PER_SEC
- *          Exibe resultado em formato legível (ex: 0.000123 segundos)
+ * @details Usa medirAlgoritmo(): tempo de parede e de CPU em nanossegundos
+ *          e, com --perf, contadores de hardware
  *          Integra com contagem de comparações para análise educacional
  */
 void medirTempo(void (*algoritmo)(Componente[], int), Componente arr[], int tamanho, const char descricao[]);
 
 // ============================================================================
-// FUNÇÃO PRINCIPAL - SISTEMA DE ORGANIZAÇÃO DA TORRE DE FUGA
+// KERNELS DE COMPARAÇÃO DE CAMPOS FIXOS (SIMD)
 // ============================================================================
+
 /**
- * @brief Menu interativo para gerenciar componentes da torre de fuga
- * @details Permite adicionar, remover, listar, ordenar (3 estratégias) e buscar componentes
- *          Integra análise de desempenho com contagem de comparações e medição de tempo
- * @return 0 ao encerrar o programa
+ * @enum KernelComparacao
+ * @brief Implementações da comparação de nome/tipo, escolhidas em tempo de execução
  */
-int main() {
-    // ======= Inicialização de Variáveis =======
-    Componente componentes[MAX_COMPONENTES]; // Array de estruturas para armazenar componentes
-    int quantidade = 0;                      // Contador de componentes adicionados (0-10)
-    int opcao;                               // Opção do menu escolhida pelo jogador
-    int mochilaOrdenada = 0;                 // Flag: 0 = não ordenado, 1 = ordenado por nome (necessário para busca binária)
-    char nomeBusca[MAX_STR_LEN];             // Buffer para nome a ser buscado
+typedef enum {
+    KERNEL_ESCALAR, /**< strcmp da libc (qualquer arquitetura) */
+    KERNEL_SSE2,    /**< Blocos de 16 bytes sobrepostos */
+    KERNEL_AVX2,    /**< Nome inteiro em um bloco de 32 bytes */
+    TOTAL_KERNELS
+} KernelComparacao;
 
-    // ======= Loop Principal do Menu =======
-    do {
-        // Exibe cabeçalho com status atual
-        printf("\n========================================================\n");
-        printf("    PLANO DE FUGA - CODIGO DA ILHA (NIVEL MESTRE)\n");
-        printf("========================================================\n");
-        printf("Itens na Mochila: %d/10\n", quantidade);
-        printf("Status da Ordenacao por Nome: %s\n", mochilaOrdenada ? "ORDENADO" : "NAO ORDENADO");
-        printf("\n");
+/**
+ * @brief Kernel ativo para comparar dois campos nome (mesmo resultado de strcmp)
+ * @details Os dois ponteiros precisam ter TAM_CHAVE_NOME bytes legíveis: o campo
+ *          nome de um Componente (seguido do tipo) ou uma chave preparada por
+ *          prepararChaveNome. Chamado no lugar de strcmp nas ordenações e buscas
+ */
+static int (*compararNomeFixo)(const char a[], const char b[]);
 
-        // Exibe opções disponíveis
-        printf("1. Adicionar Componente\n");
-        printf("2. Descartar Componente\n");
-        printf("3. Listar Componentes (Inventario)\n");
-        printf("4. Organizar Mochila (Ordenar Componentes)\n");
-        printf("5. Busca Binaria por Componente-Chave (por nome)\n");
-        printf("0. ATIVAR TORRE DE FUGA (Sair)\n");
-        printf("--------------------------------------------------------\n");
-        printf("\nEscolha uma opcao: ");
-        scanf("%d", &opcao);
-        while(getchar() != '\n')
-            ; // Limpa buffer de entrada
+/** @brief Kernel ativo para comparar dois campos tipo de 20 bytes (mesmo resultado de strcmp) */
+static int (*compararTipoFixo)(const char a[], const char b[]);
 
-        switch(opcao) {
-        // ============== CASO 1: ADICIONAR COMPONENTE ==============
-        case 1:
-            // Verifica limite de capacidade (máximo 10 componentes)
-            if(quantidade >= 10) {
-                printf("\n[ERRO] Mochila cheia! Capacidade maxima: 10 componentes.\n");
-            } else {
-                printf("\n--- Coletando Novo Componente ---\n");
+/** @brief 1 se a CPU (e o compilador) suportam o kernel */
+int kernelComparacaoDisponivel(KernelComparacao kernel);
 
-                // Entrada 1: Nome do componente (max 30 caracteres)
-                printf("Nome: ");
-                fgets(componentes[quantidade].nome, 30, stdin);
-                componentes[quantidade].nome[strcspn(componentes[quantidade].nome, "\n")] = 0;
+/**
+ * @brief Ativa um kernel de comparação
+ * @return 1 se ativado, 0 se não há suporte (o kernel atual é mantido)
+ */
+int selecionarKernelComparacao(KernelComparacao kernel);
 
-                // Entrada 2: Tipo/Categoria do componente
-                printf("Tipo (Estrutural, Eletronico, Energia): ");
-                fgets(componentes[quantidade].tipo, 20, stdin);
-                componentes[quantidade].tipo[strcspn(componentes[quantidade].tipo, "\n")] = 0;
+/** @brief Ativa o melhor kernel disponível (AVX2 > SSE2 > escalar) e o retorna */
+KernelComparacao selecionarMelhorKernelComparacao(void);
 
-                // Entrada 3: Quantidade de unidades (inteiro)
-                printf("Quantidade: ");
-                scanf("%d", &componentes[quantidade].quantidade);
-                while(getchar() != '\n')
-                    ;
+/** @brief Kernel em uso */
+KernelComparacao kernelComparacaoAtivo(void);
 
-                // Entrada 4: Prioridade (1-10, onde 10 é máxima urgência)
-                printf("Prioridade de Montagem (1-10): ");
-                scanf("%d", &componentes[quantidade].prioridade);
-                while(getchar() != '\n')
-                    ;
+/** @brief Nome do kernel ("escalar", "sse2", "avx2") */
+const char *nomeKernelComparacao(KernelComparacao kernel);
 
-                // Incrementa contador e marca como não ordenado
-                quantidade++;
-                mochilaOrdenada = 0; // Novo componente desordeniza a lista
-                printf("\nComponente '%s' adicionado!\n", componentes[quantidade - 1].nome);
+/**
+ * @brief Copia um nome de busca para um buffer de TAM_CHAVE_NOME bytes zerado
+ * @details Só os 30 primeiros bytes importam: nenhum nome guardado tem mais que
+ *          isso, então a comparação truncada dá o mesmo sinal que strcmp
+ */
+void prepararChaveNome(char chave[TAM_CHAVE_NOME], const char nome[]);
 
-                // Exibe tabela atualizada
-                mostrarComponentes(componentes, quantidade);
-            }
-            break;
+// ============================================================================
+// ARMAZENAMENTO EM ARENA - REGISTROS E STRINGS
+// ============================================================================
 
-        case 2: // Descartar Componente
-            if(quantidade == 0) {
-                printf("\n[AVISO] Mochila vazia. Nada para descartar.\n");
-            } else {
-                printf("\n--- Descartando Componente ---\n");
-                printf("Nome do componente a descartar: ");
-                fgets(nomeBusca, MAX_STR_LEN, stdin);
-                nomeBusca[strcspn(nomeBusca, "\n")] = 0;
+/** @def TAM_BLOCO_ARENA_MIN Bytes do primeiro bloco da arena; cada bloco novo dobra até TAM_BLOCO_ARENA_MAX */
+#define TAM_BLOCO_ARENA_MIN (4 * 1024)
 
-                // Busca sequencial (O(n)) pelo nome do componente
-                int encontrado = -1;
-                for(int i = 0; i < quantidade; i++) {
-                    if(strcmp(componentes[i].nome, nomeBusca) == 0) {
-                        encontrado = i;
-                        break;
-                    }
-                }
+/** @def TAM_BLOCO_ARENA_MAX Maior bloco pedido ao sistema (pedidos maiores ganham bloco próprio) */
+#define TAM_BLOCO_ARENA_MAX (1024 * 1024)
 
-                if(encontrado == -1) {
-                    printf("\n[ERRO] Componente '%s' nao encontrado na mochila.\n", nomeBusca);
-                } else {
-                    // Remove o componente deslocando os elementos posteriores (O(n))
-                    for(int i = encontrado; i < quantidade - 1; i++) {
-                        componentes[i] = componentes[i + 1];
-                    }
-                    quantidade--;
-                    mochilaOrdenada = 0; // Marca como não ordenado
-                    printf("\n[SUCESSO] Componente descartado da mochila.\n");
-                }
-            }
-            break;
+/**
+ * @struct BlocoArena
+ * @brief Bloco de memória da arena, entregue aos poucos por incremento de ponteiro
+ * @details Os blocos formam uma lista encadeada e só voltam ao sistema todos
+ *          juntos, em armazemLiberar
+ */
+typedef struct BlocoArena {
+    struct BlocoArena *anterior;            /**< Bloco alocado antes deste */
+    size_t usado;                           /**< Bytes de dados já entregues */
+    size_t capacidade;                      /**< Bytes de dados do bloco */
+    _Alignas(max_align_t) unsigned char dados[]; /**< Área entregue pela arena */
+} BlocoArena;
 
-        case 3: // Listar Componentes (Inventário)
-            // Exibe tabela formatada com todos os componentes
-            mostrarComponentes(componentes, quantidade);
-            break;
+/**
+ * @struct RegistroArena
+ * @brief Componente cujo nome e tipo apontam para o pool de strings da arena
+ * @details Sem o limite de 30/20 bytes dos campos fixos de Componente e com
+ *          24 bytes por registro em vez de 60; cada tipo distinto é guardado
+ *          uma única vez
+ */
+typedef struct {
+    const char *nome; /**< Nome internado */
+    const char *tipo; /**< Tipo internado */
+    int quantidade;   /**< Quantidade disponível */
+    int prioridade;   /**< Prioridade de montagem (1-10) */
+} RegistroArena;
 
-        case 4: // Organizar Mochila (Ordenar)
-            // Submenu com 3 estratégias de ordenação diferentes
-            if(quantidade == 0) {
-                printf("\n[AVISO] Mochila vazia. Nada para organizar.\n");
-            } else {
-                printf("\n--- Estrategia de Organizacao ---\n");
-                printf("Como deseja ordenar os componentes?\n");
-                printf("1. Por Nome (Ordem Alfabetica)\n");
-                printf("2. Por Tipo\n");
-                printf("3. Por Prioridade de Montagem\n");
-                printf("4. Cancelar\n");
-                printf("Escolha o criterio: ");
-                int subOpcao;
-                scanf("%d", &subOpcao);
-                while(getchar() != '\n')
-                    ;
+/** @brief Posição do pool de registros: ocupada por um registro ou elo da lista de livres */
+typedef union NoRegistroArena {
+    RegistroArena registro;               /**< Registro em uso */
+    union NoRegistroArena *proximoLivre;  /**< Próximo registro descartado */
+} NoRegistroArena;
 
-                switch(subOpcao) {
-                // -------- Subopcão 1: Bubble Sort por Nome --------
-                case 1:
-                    printf("\n[PROCESSANDO] Organizando mochila por NOME...\n");
-                    // Usa medirTempo para executar e medir bubbleSortNome O(n²)
-                    medirTempo(bubbleSortNome, componentes, quantidade, "BUBBLE SORT - Por Nome");
-                    mochilaOrdenada = 1; // IMPORTANTE: Marca como ordenado (necessário para busca binária)
-                    mostrarComponentes(componentes, quantidade);
-                    break;
+/**
+ * @struct ArmazemArena
+ * @brief Armazém de componentes sobre uma arena: strings internadas e registros reaproveitados
+ * @details Nomes e tipos são copiados para a arena. Tipos se repetem e são
+ *          internados (uma cópia por tipo, achada por uma tabela hash); nomes
+ *          já são chaves únicas, então vão direto para o pool, sem pagar a
+ *          tabela (24 bytes e uma sondagem aleatória por item). Registros
+ *          descartados entram numa lista de livres e são reaproveitados antes
+ *          de a arena crescer. Nada é devolvido ao sistema item a item:
+ *          armazemLiberar solta todos os blocos de uma vez. Strings de
+ *          registros descartados continuam no pool até a liberação
+ */
+typedef struct {
+    BlocoArena *blocos;           /**< Bloco atual (os anteriores, menores, encadeados a partir dele) */
+    NoRegistroArena *livres;      /**< Registros descartados prontos para reuso */
+    const char **strings;         /**< Tabela de internação (endereçamento aberto; NULL = vazio) */
+    unsigned *hashes;             /**< Hash de cada slot (evita strcmp em colisões) */
+    int capacidadeStrings;        /**< Slots da tabela (potência de 2) */
+    int totalStrings;             /**< Strings distintas internadas (tipos) */
+    int registrosAtivos;          /**< Registros em uso */
+    long long registrosCriados;   /**< Registros retirados da arena (nunca diminui) */
+    long long reaproveitados;     /**< Registros entregues a partir da lista de livres */
+    long long alocacoesSistema;   /**< Chamadas a malloc feitas pelo armazém */
+    size_t bytesReservados;       /**< Bytes pedidos ao sistema e ainda em posse do armazém */
+    size_t bytesStrings;          /**< Bytes de texto no pool (com '\0') */
+} ArmazemArena;
 
-                // -------- Subopcão 2: Insertion Sort por Tipo --------
-                case 2:
-                    printf("\n[PROCESSANDO] Organizando mochila por TIPO...\n");
-                    // Usa medirTempo para executar e medir insertionSortTipo O(n²)
-                    medirTempo(insertionSortTipo, componentes, quantidade, "INSERTION SORT - Por Tipo");
-                    mochilaOrdenada = 0; // Não está ordenado por nome (busca binária não é válida)
-                    mostrarComponentes(componentes, quantidade);
-                    break;
+/** @brief Inicializa um armazém vazio (sem alocar memória) */
+void armazemIniciar(ArmazemArena *a);
 
-                // -------- Subopcão 3: Selection Sort por Prioridade --------
-                case 3:
-                    printf("\n[PROCESSANDO] Organizando mochila por PRIORIDADE...\n");
-                    // Usa medirTempo para executar e medir selectionSortPrioridade O(n²)
-                    medirTempo(selectionSortPrioridade, componentes, quantidade, "SELECTION SORT - Por Prioridade");
-                    mochilaOrdenada = 0; // Não está ordenado por nome (busca binária não é válida)
-                    mostrarComponentes(componentes, quantidade);
-                    break;
+/**
+ * @brief Devolve a cópia única de texto no pool de strings, criando-a se preciso
+ * @return Ponteiro estável até armazemLiberar, ou NULL se faltou memória
+ */
+const char *armazemInternar(ArmazemArena *a, const char texto[]);
 
-                // -------- Subopcão 4: Cancelar operação --------
-                case 4:
-                    printf("\nOperacao cancelada.\n");
-                    break;
+/**
+ * @brief Cria um registro (reaproveitando um descartado, se houver)
+ * @return Registro com nome copiado e tipo internado no pool, ou NULL se faltou memória
+ */
+RegistroArena *armazemCriar(ArmazemArena *a, const char nome[], const char tipo[], int quantidade, int prioridade);
 
-                default:
-                    printf("Opcao invalida!\n");
-                }
-            }
-            break;
+/** @brief Devolve o registro à lista de livres do armazém (O(1), sem free) */
+void armazemDescartar(ArmazemArena *a, RegistroArena *r);
 
-        // ============== CASO 5: BUSCA BINÁRIA ==============
-        case 5:
-            // Requisitos: Array deve estar ordenado por nome (bubbleSortNome)
-            if(quantidade == 0) {
-                printf("\n[AVISO] Mochila vazia. Nada para buscar.\n");
-            } else if(!mochilaOrdenada) {
-                // Validação: mochilaOrdenada = 1 só depois de bubbleSortNome
-                printf("\n");
-                printf("ALERTA: A busca binaria requer que a mochila esteja ordenada por NOME.\n");
-                printf("Use a Opcao 4 para organizar a mochila primeiro.\n");
-            } else {
-                // Entrada: Nome do componente a buscar
-                printf("\n--- Busca Binaria por Componente-Chave ---\n");
-                printf("Nome do componente a buscar: ");
-                fgets(nomeBusca, MAX_STR_LEN, stdin);
-                nomeBusca[strcspn(nomeBusca, "\n")] = 0;
+/** @brief Libera de uma vez todos os blocos e a tabela de strings e reinicia o armazém */
+void armazemLiberar(ArmazemArena *a);
 
-                // Executa busca binária O(log n) - retorna índice ou -1
-                int pos = buscaBinariaPorNome(componentes, quantidade, nomeBusca);
+/** @brief Bytes em posse do armazém (blocos da arena + tabela de internação) */
+size_t armazemMemoriaBytes(const ArmazemArena *a);
 
-                if(pos == -1) {
-                    // Componente não encontrado
-                    printf("\n[FALHA] Componente-chave '%s' nao encontrado na mochila.\n", nomeBusca);
-                } else {
-                    // Componente encontrado - exibe dados
-                    printf("\n--- Componente-Chave Encontrado! ---\n");
-                    printf("Nome: %s, Tipo: %s, Qtd: %d, Prio: %d\n",
-                           componentes[pos].nome, componentes[pos].tipo,
-                           componentes[pos].quantidade, componentes[pos].prioridade);
-                }
-                // Telemetria: exibe número de comparações realizadas
-                printf("-> Comparacoes realizadas: %d (Complexidade O(log n))\n", comparacoesVetor);
-            }
+// ============================================================================
+// MEDIÇÃO DE DESEMPENHO - RELÓGIOS E CONTADORES DE HARDWARE
+// ============================================================================
+
+/**
+ * @struct Medicao
+ * @brief Resultado estruturado de uma medição
+ * @details Contadores de hardware valem -1 quando indisponíveis (sem --perf,
+ *          sem permissão do kernel ou fora do Linux)
+ */
+typedef struct {
+    long long tempoParedeNs; /**< Relógio monotônico (CLOCK_MONOTONIC) */
+    long long tempoCpuNs;    /**< Tempo de CPU do processo (CLOCK_PROCESS_CPUTIME_ID) */
+    long long ciclos;        /**< Ciclos de CPU */
+    long long instrucoes;    /**< Instruções executadas */
+    long long falhasCache;   /**< Falhas de cache (último nível) */
+    long long falhasDesvio;  /**< Desvios previstos incorretamente */
+    long long comparacoes;   /**< comparacoesVetor ao final da execução */
+    long long trocas;        /**< trocasVetor ao final da execução */
+    long long bytesMovidos;  /**< bytesMovidosVetor ao final da execução */
+    long long inicioParede;  /**< Uso interno: marca inicial do relógio de parede */
+    long long inicioCpu;     /**< Uso interno: marca inicial do relógio de CPU */
+} Medicao;
+
+/**
+ * @brief Inicia uma medição manual (para trechos que não são um único algoritmo)
+ * @param med Medição a iniciar
+ */
+void medicaoIniciar(Medicao *med);
+
+/**
+ * @brief Finaliza a medição iniciada com medicaoIniciar
+ * @param med Medição (preenchida com tempos e contadores)
+ */
+void medicaoFinalizar(Medicao *med);
+
+/**
+ * @brief Executa e mede qualquer algoritmo compatível com medirTempo
+ * @param algoritmo Função do tipo void (*)(Componente[], int)
+ * @param arr Array de componentes (MODIFICADO pelo algoritmo)
+ * @param tamanho Número de elementos
+ * @param med Resultado (SAÍDA)
+ * @details Não imprime nada: o chamador decide como exibir ou agregar
+ */
+void medirAlgoritmo(void (*algoritmo)(Componente[], int), Componente arr[], int tamanho, Medicao *med);
+
+/**
+ * @brief Exibe uma medição em formato legível (ns, µs ou ms conforme a escala)
+ */
+void mostrarMedicao(const Medicao *med);
+
+// ============================================================================
+// MÉTRICAS DE OPERAÇÃO - CONTADORES POR THREAD E HISTOGRAMAS DE LATÊNCIA
+// ============================================================================
+
+/** @def BALDES_HISTOGRAMA Baldes de latência em potências de 2: o balde i conta durações <= 2^i ns */
+#define BALDES_HISTOGRAMA 40
+
+/** @def AMOSTRAGEM_METRICAS_PADRAO Uma a cada N buscas/inserções/descartes tem a latência medida */
+#define AMOSTRAGEM_METRICAS_PADRAO 64
+
+/**
+ * @enum TipoMetrica
+ * @brief Série de métricas: operação + estrutura que a atendeu
+ * @details As ordenações ocupam uma série por algoritmo, a partir de
+ *          METRICA_ORDENACAO (METRICA_ORDENACAO + ALGORITMO_...)
+ */
+typedef enum {
+    METRICA_BUSCA_HASH,       /**< mochilaBuscarPorNome (índice hash) */
+    METRICA_BUSCA_BINARIA,    /**< buscaBinariaPorNome e FIND do servidor (vetor ordenado) */
+    METRICA_BUSCA_ORDENADO,   /**< mochilaBuscaBinariaIndexada (índice ordenado em blocos) */
+    METRICA_BUSCA_EYTZINGER,  /**< mochilaBuscaEytzinger */
+    METRICA_BUSCA_INTERVALO,  /**< mochilaBuscarIntervalo (acertos = componentes retornados) */
+    METRICA_BUSCA_LOTE,       /**< Busca em lote / paralela (acertos e falhas contam nomes) */
+    METRICA_BUSCA_SNAPSHOT,   /**< snapshotBuscarPorNome (arquivo mapeado) */
+    METRICA_BUSCA_PREFIXO,    /**< mochilaBuscarPorPrefixo (árvore radix; acertos = nomes devolvidos) */
+    METRICA_BUSCA_APROXIMADA, /**< mochilaBuscarAproximado (árvore radix; acertos = sugestões) */
+    METRICA_ADICAO,           /**< adicionarComponente (acerto = aceito) */
+    METRICA_DESCARTE,         /**< descartarComponente (acerto = encontrado e removido) */
+    METRICA_ORDENACAO,        /**< Primeira série de ordenação (ALGORITMO_CLASSICO) */
+    TOTAL_METRICAS = METRICA_ORDENACAO + TOTAL_ALGORITMOS
+} TipoMetrica;
+
+/**
+ * @struct MetricasOperacao
+ * @brief Contadores de uma série (monotônicos, 64 bits)
+ * @details chamadas conta todas as operações; amostras/somaNs/baldes só as
+ *          que tiveram a latência medida (ordenações: todas)
+ */
+typedef struct {
+    uint64_t chamadas;      /**< Operações registradas */
+    uint64_t comparacoes;   /**< Comparações de chave (ou sondagens do hash) */
+    uint64_t trocas;        /**< Trocas ou registros movidos (ordenações) */
+    uint64_t bytesMovidos;  /**< Bytes copiados (ordenações) */
+    uint64_t acertos;       /**< Buscas que encontraram / escritas aceitas */
+    uint64_t falhas;        /**< Buscas sem resultado / escritas recusadas */
+    uint64_t amostras;      /**< Operações com latência medida */
+    uint64_t somaNs;        /**< Soma das latências medidas */
+    uint64_t baldes[BALDES_HISTOGRAMA]; /**< Histograma (não cumulativo) das latências medidas */
+} MetricasOperacao;
+
+/**
+ * @brief Define a amostragem de latência das operações curtas
+ * @param intervalo 1 = mede todas, N = uma a cada N por thread, 0 = não mede
+ * @details Chamar antes de criar threads. Os contadores (chamadas,
+ *          comparações, acertos...) são sempre atualizados
+ */
+void metricasConfigurar(int intervalo);
+
+/**
+ * @brief Marca o início de uma operação
+ * @param tipo Série da operação
+ * @return Relógio monotônico em ns, ou -1 se esta operação não será cronometrada
+ * @details Ordenações são sempre cronometradas (o custo do relógio some
+ *          diante da ordenação); as demais seguem a amostragem
+ */
+long long metricasInicio(TipoMetrica tipo);
+
+/**
+ * @brief Registra uma operação no fragmento de métricas da thread atual
+ * @param tipo Série da operação
+ * @param inicio Valor devolvido por metricasInicio (-1 = sem latência)
+ * @param comparacoes Comparações de chave da operação
+ * @param acertos Consultas que encontraram algo / escritas aceitas (uma por consulta, não por resultado)
+ * @param falhas Consultas sem resultado / escritas recusadas
+ * @details Sem trava e sem instruções atômicas de leitura-modificação-escrita:
+ *          cada thread só escreve no próprio fragmento
+ */
+void metricasRegistrar(TipoMetrica tipo, long long inicio, long long comparacoes, int acertos, int falhas);
+
+/**
+ * @brief Registra uma ordenação a partir de comparacoesVetor, trocasVetor e bytesMovidosVetor
+ * @param algoritmo Algoritmo que efetivamente ordenou
+ * @param inicio Valor devolvido por metricasInicio
+ */
+void metricasRegistrarOrdenacao(AlgoritmoOrdenacao algoritmo, long long inicio);
+
+/**
+ * @brief Suspende (1) ou retoma (0) o registro de métricas na thread atual
+ * @details Para trabalho interno que distorceria as séries de produção, como
+ *          as milhares de ordenações da calibração
+ */
+void metricasPausar(int pausar);
+
+/**
+ * @brief Soma os fragmentos de todas as threads (inclusive as já encerradas)
+ * @param destino Vetor com TOTAL_METRICAS séries (SAÍDA)
+ */
+void metricasSomar(MetricasOperacao destino[]);
+
+/** @enum FormatoMetricas @brief Formatos de exportação das métricas */
+typedef enum {
+    METRICAS_PROMETHEUS, /**< Formato de texto do Prometheus (exposition format 0.0.4) */
+    METRICAS_JSON        /**< Um objeto JSON com uma entrada por série */
+} FormatoMetricas;
+
+/**
+ * @brief Exporta as métricas no formato de texto do Prometheus ou em JSON
+ * @param saida Fluxo de destino
+ * @param formato Formato de saída
+ * @details Prometheus: contadores *_total e o histograma
+ *          freefire_operacao_duracao_segundos (baldes cumulativos, _sum, _count)
+ *          por operacao/estrutura. JSON: os mesmos contadores, taxa de acerto
+ *          e p50/p99 estimados pelos baldes. Séries sem chamadas são omitidas
+ */
+void metricasExportar(FILE *saida, FormatoMetricas formato);
+
+/**
+ * @brief Grava as métricas em arquivo (".json" => JSON, demais => Prometheus), ou "-" para stdout
+ * @return 1 em caso de sucesso, 0 se o arquivo não pôde ser gravado
+ */
+int metricasGravar(const char caminho[]);
+
+/**
+ * @brief Agenda (atexit) a gravação das métricas em caminho quando o programa terminar
+ * @details Usado por --metricas: vale para o menu, o lote, o servidor e o benchmark
+ */
+void metricasGravarAoSair(const char caminho[]);
+
+/**
+ * @brief Exibe um resumo legível: chamadas, taxa de acerto e p50/p99 por série
+ */
+void mostrarMetricas(void);
+
+// ============================================================================
+// MOTOR DE ORDENAÇÃO O(n log n)
+// ============================================================================
+
+/**
+ * @brief Ordena componentes com o algoritmo e o critério escolhidos
+ * @param arr Array de componentes (MODIFICADO in-place)
+ * @param tamanho Número de elementos
+ * @param algoritmo Estratégia de ordenação (CLASSICO usa as funções O(n²) originais)
+ * @param criterio Campo usado como chave
+ * @details Atualiza comparacoesVetor e trocasVetor e imprime a telemetria
+ *          no mesmo formato dos algoritmos clássicos (exceto em modoSilencioso)
+ */
+void ordenarComponentes(Componente arr[], int tamanho, AlgoritmoOrdenacao algoritmo, CriterioOrdenacao criterio);
+
+/**
+ * @brief Retorna a função de ordenação (compatível com medirTempo) para o par algoritmo/critério
+ * @param algoritmo Estratégia de ordenação
+ * @param criterio Campo usado como chave
+ * @return Ponteiro para função do tipo void (*)(Componente[], int)
+ */
+void (*funcaoOrdenacao(AlgoritmoOrdenacao algoritmo, CriterioOrdenacao criterio))(Componente[], int);
+
+/**
+ * @brief Retorna a descrição legível do par algoritmo/critério (ex: "INTROSORT - Por Nome")
+ */
+const char *descricaoOrdenacao(AlgoritmoOrdenacao algoritmo, CriterioOrdenacao criterio);
+
+/**
+ * @brief Converte o nome de um algoritmo (CLASSICO, INTRO, MERGE, RADIX, CHAVES, PARALELO, CONTAGEM, ADAPTATIVO...) no enum correspondente
+ * @param nome Texto informado pelo usuário (sem diferenciar maiúsculas)
+ * @param algoritmo Resultado (SAÍDA)
+ * @return 1 se reconhecido, 0 caso contrário
+ */
+int algoritmoPorNome(const char nome[], AlgoritmoOrdenacao *algoritmo);
+
+/** @brief Nome curto do algoritmo, aceito por algoritmoPorNome (ex: "introsort") */
+const char *nomeAlgoritmo(AlgoritmoOrdenacao algoritmo);
+
+/** @brief IntroSort por nome (O(n log n), compatível com medirTempo) */
+void introSortNome(Componente arr[], int tamanho);
+/** @brief IntroSort por tipo (O(n log n), compatível com medirTempo) */
+void introSortTipo(Componente arr[], int tamanho);
+/** @brief IntroSort por prioridade decrescente (O(n log n), compatível com medirTempo) */
+void introSortPrioridade(Componente arr[], int tamanho);
+/** @brief Merge Sort estável por nome (O(n log n), memória auxiliar O(n)) */
+void mergeSortNome(Componente arr[], int tamanho);
+/** @brief Merge Sort estável por tipo (O(n log n), memória auxiliar O(n)) */
+void mergeSortTipo(Componente arr[], int tamanho);
+/** @brief Merge Sort estável por prioridade decrescente (O(n log n), memória auxiliar O(n)) */
+void mergeSortPrioridade(Componente arr[], int tamanho);
+/** @brief Radix Sort MSD por nome (O(n·w), w = comprimento dos nomes) */
+void radixSortNome(Componente arr[], int tamanho);
+/** @brief Radix Sort MSD por tipo (O(n·w), w = comprimento dos tipos) */
+void radixSortTipo(Componente arr[], int tamanho);
+/** @brief Radix Sort LSD por prioridade decrescente (O(n), 4 passadas de 8 bits no máximo) */
+void radixSortPrioridade(Componente arr[], int tamanho);
+/** @brief Ordenação por chaves extraídas por nome (pares de 16 bytes + uma permutação) */
+void chavesSortNome(Componente arr[], int tamanho);
+/** @brief Ordenação por chaves extraídas por tipo (pares de 16 bytes + uma permutação) */
+void chavesSortTipo(Componente arr[], int tamanho);
+/** @brief Ordenação por chaves extraídas por prioridade decrescente (pares de 16 bytes + uma permutação) */
+void chavesSortPrioridade(Componente arr[], int tamanho);
+/** @brief Merge Sort paralelo por nome (pool de threads, estável) */
+void mergeParaleloNome(Componente arr[], int tamanho);
+/** @brief Merge Sort paralelo por tipo (pool de threads, estável) */
+void mergeParaleloTipo(Componente arr[], int tamanho);
+/** @brief Merge Sort paralelo por prioridade decrescente (pool de threads, estável) */
+void mergeParaleloPrioridade(Componente arr[], int tamanho);
+/** @brief Contagem por nome: nomes são únicos, então usa o Radix Sort MSD */
+void contagemSortNome(Componente arr[], int tamanho);
+/** @brief Counting Sort por tipo com dicionário temporário (O(n) hashes + O(n + k)) */
+void contagemSortTipo(Componente arr[], int tamanho);
+/** @brief Contagem por prioridade decrescente (Radix Sort LSD, que já é contagem por byte) */
+void contagemSortPrioridade(Componente arr[], int tamanho);
+/** @brief TimSort por nome (estável, O(n) em entradas quase ordenadas) */
+void adaptativoSortNome(Componente arr[], int tamanho);
+/** @brief TimSort por tipo (estável, O(n) em entradas quase ordenadas) */
+void adaptativoSortTipo(Componente arr[], int tamanho);
+/** @brief TimSort por prioridade decrescente (estável, O(n) em entradas quase ordenadas) */
+void adaptativoSortPrioridade(Componente arr[], int tamanho);
+
+/**
+ * @brief Interpreta uma especificação de várias chaves (ex: "tipo asc, prioridade desc, nome asc")
+ * @param texto Campos separados por vírgula: NOME, TIPO ou PRIORIDADE, seguidos opcionalmente
+ *              de ASC ou DESC (sem sentido: nome/tipo crescentes, prioridade decrescente)
+ * @param espec Resultado (SAÍDA)
+ * @return 1 se válida, 0 se vazia, com campo desconhecido ou repetido
+ */
+int especificacaoPorTexto(const char texto[], EspecificacaoOrdenacao *espec);
+
+/**
+ * @brief Escreve a especificação em texto normalizado (ex: "tipo asc, prioridade desc")
+ */
+void descreverEspecificacao(const EspecificacaoOrdenacao *espec, char destino[], size_t tamanho);
+
+/**
+ * @brief Ordena por várias chaves numa única passada do TimSort (estável)
+ * @param arr Array de componentes (MODIFICADO in-place)
+ * @param tamanho Número de elementos
+ * @param espec Chaves em ordem de precedência
+ * @details Equivale a ordenações estáveis sucessivas da última chave para a primeira,
+ *          mas percorre e move os registros uma vez só. Atualiza comparacoesVetor /
+ *          trocasVetor e imprime a telemetria (exceto em modoSilencioso)
+ */
+void ordenarPorEspecificacao(Componente arr[], int tamanho, const EspecificacaoOrdenacao *espec);
+
+// ============================================================================
+// PARALELISMO - POOL DE THREADS
+// ============================================================================
+
+/**
+ * @brief Número de threads usadas pelas operações paralelas
+ * @return threadsConfiguradas, ou o número de núcleos disponíveis (sysconf) se 0
+ */
+int threadsTrabalho(void);
+
+/**
+ * @brief Executa tarefas independentes no pool de threads e espera todas terminarem
+ * @param tarefa Função executada uma vez por tarefa
+ * @param argumentos Vetor com totalTarefas argumentos de tamanhoArgumento bytes cada
+ * @param tamanhoArgumento sizeof de um argumento
+ * @param totalTarefas Número de tarefas
+ * @details O pool é criado na primeira chamada (threadsTrabalho() - 1
+ *          threads auxiliares; a thread chamadora também executa tarefas)
+ *          e encerrado na saída do programa. Cada tarefa deve escrever só no
+ *          próprio argumento: contadores são somados depois pelo chamador
+ */
+void executarEmParalelo(void (*tarefa)(void *), void *argumentos, size_t tamanhoArgumento, int totalTarefas);
+
+/**
+ * @brief Responde muitas buscas binárias por nome de uma vez, divididas entre as threads
+ * @param arr Array ORDENADO por nome (somente leitura)
+ * @param tamanho Número de elementos
+ * @param nomes Nomes procurados
+ * @param totalConsultas Número de nomes
+ * @param resultados Índice de cada nome em arr, ou -1 (SAÍDA)
+ * @return Número de nomes encontrados
+ * @details Mesmo algoritmo de buscaBinariaPorNome, sem estado global durante
+ *          a busca: cada thread conta as próprias comparações e a soma é
+ *          publicada em comparacoesVetor ao final
+ */
+int buscaBinariaParalela(const Componente arr[], int tamanho, char nomes[][MAX_STR_LEN], int totalConsultas,
+                         int resultados[]);
+
+// ============================================================================
+// MOCHILA DINÂMICA - ARMAZENAMENTO REDIMENSIONÁVEL
+// ============================================================================
+
+/**
+ * @brief Inicializa uma mochila vazia
+ * @param m Mochila a inicializar
+ * @param limite Número máximo de componentes aceitos (0 = sem limite)
+ * @details Nenhuma memória é alocada até a primeira inserção
+ */
+void mochilaIniciar(Mochila *m, int limite);
+
+/**
+ * @brief Libera a memória da mochila e a deixa vazia
+ * @param m Mochila a liberar
+ */
+void mochilaLiberar(Mochila *m);
+
+/**
+ * @brief Garante espaço alocado para pelo menos minimo componentes
+ * @param m Mochila
+ * @param minimo Número de posições necessárias
+ * @return 1 em caso de sucesso, 0 se a alocação falhou
+ * @details Dobra a capacidade até atingir minimo (crescimento geométrico)
+ */
+int mochilaReservar(Mochila *m, int minimo);
+
+/**
+ * @brief Calcula a memória ocupada pela mochila
+ * @param m Mochila
+ * @return Bytes alocados (estrutura + vetor de itens, incluindo posições livres)
+ */
+size_t mochilaMemoriaBytes(const Mochila *m);
+
+/**
+ * @brief Exibe o uso de memória da mochila (usado x alocado)
+ * @param m Mochila
+ */
+void mostrarUsoMemoria(const Mochila *m);
+
+/**
+ * @brief Adiciona um componente ao final da mochila
+ * @param m Mochila (MODIFICADA)
+ * @param novo Componente a ser copiado para a mochila
+ * @return 1 se adicionado, 0 se a mochila atingiu o limite ou faltou memória
+ * @details Complexidade: O(1) amortizado. Usado tanto pelo menu quanto pelo modo em lote
+ */
+int adicionarComponente(Mochila *m, const Componente *novo);
+
+/**
+ * @brief Remove da mochila o componente com o nome informado
+ * @param m Mochila (MODIFICADA)
+ * @param nome Nome do componente a descartar
+ * @return 1 se removido, 0 se não encontrado
+ * @details Localiza pelo índice hash (O(1) médio) e move o último componente
+ *          para a posição liberada (O(1)); a ordem dos demais itens muda
+ */
+int descartarComponente(Mochila *m, const char nome[]);
+
+/**
+ * @brief Localiza um componente pelo nome usando o índice hash
+ * @param m Mochila
+ * @param nome Nome buscado
+ * @return Posição em m->itens, ou -1 se não encontrado
+ * @details O(1) em média, não exige a mochila ordenada. Atualiza
+ *          comparacoesVetor com o número de slots visitados
+ */
+int mochilaBuscarPorNome(Mochila *m, const char nome[]);
+
+/**
+ * @brief Reconstrói os índices após uma reordenação de m->itens
+ * @param m Mochila
+ * @details Deve ser chamada depois de qualquer ordenação in-place: O(n) se
+ *          m->ordenadaPorNome, O(n log n) caso contrário (índice ordenado)
+ */
+void mochilaReindexar(Mochila *m);
+
+/**
+ * @brief Copia os componentes da mochila em ordem de nome
+ * @param m Mochila
+ * @param destino Vetor com espaço para m->quantidade componentes
+ * @details O(n) sem comparar nomes: lê a ordem do índice ordenado (ou copia
+ *          direto, se a mochila já está ordenada por nome)
+ */
+void mochilaCopiarEmOrdemDeNome(const Mochila *m, Componente destino[]);
+
+/**
+ * @brief Busca binária por nome sobre o índice ordenado
+ * @param m Mochila (não precisa estar ordenada)
+ * @param nome Nome buscado
+ * @return Posição em m->itens, ou -1
+ * @details O(log n); atualiza comparacoesVetor como buscaBinariaPorNome
+ */
+int mochilaBuscaBinariaIndexada(Mochila *m, const char nome[]);
+
+/**
+ * @brief Busca por intervalo: componentes com de <= nome <= ate, em ordem alfabética
+ * @param m Mochila (não precisa estar ordenada)
+ * @param de Limite inferior (inclusivo)
+ * @param ate Limite superior (inclusivo)
+ * @param total Número de posições retornadas (SAÍDA)
+ * @return Vetor de posições alocado com malloc (liberar com free), ou NULL se vazio
+ * @details O(log n + k), k = tamanho do resultado
+ */
+int *mochilaBuscarIntervalo(Mochila *m, const char de[], const char ate[], int *total);
+
+// ============================================================================
+// BUSCA EYTZINGER (LAYOUT EM LARGURA, SEM DESVIOS)
+// ============================================================================
+
+/**
+ * @brief Constrói o layout de Eytzinger a partir de nomes em ordem alfabética
+ * @param idx Índice (alocações anteriores são reaproveitadas)
+ * @param itens Vetor de componentes
+ * @param ordem Posições de itens em ordem de nome, ou NULL se itens já está ordenado por nome
+ * @param tamanho Número de posições
+ * @return 1 em caso de sucesso, 0 se faltou memória
+ * @details O(n): percurso em ordem da árvore implícita
+ */
+int eytzingerConstruir(IndiceEytzinger *idx, const Componente itens[], const int ordem[], int tamanho);
+
+/**
+ * @brief Busca um nome no layout de Eytzinger
+ * @return Posição em itens, ou -1
+ * @details Lower bound sem desvios: a cada nível k = 2k + (chave[k] < nome),
+ *          com a comparação feita em aritmética sobre as 4 palavras e prefetch dos netos. Sempre desce a altura toda (sem saída
+ *          antecipada), então comparacoesVetor = altura + 1 (igualdade final)
+ */
+int eytzingerBuscar(const IndiceEytzinger *idx, const char nome[]);
+
+/** @brief Libera as chaves e posições */
+void eytzingerLiberar(IndiceEytzinger *idx);
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t eytzingerMemoriaBytes(const IndiceEytzinger *idx);
+
+/**
+ * @brief Busca por nome pelo layout de Eytzinger da mochila
+ * @details Reconstrói o layout (O(n), a partir do índice ordenado) só se a
+ *          mochila mudou desde a última busca: O(log n) por consulta depois disso
+ */
+int mochilaBuscaEytzinger(Mochila *m, const char nome[]);
+
+// ============================================================================
+// ÍNDICE RADIX POR NOME (PREFIXO, AUTOCOMPLETAR E BUSCA APROXIMADA)
+// ============================================================================
+
+/** @def DISTANCIA_APROXIMADA_MAXIMA Maior distância de edição aceita pela busca aproximada */
+#define DISTANCIA_APROXIMADA_MAXIMA 2
+
+/**
+ * @struct SugestaoNome
+ * @brief Resultado da busca aproximada: componente e distância de edição até o nome buscado
+ */
+typedef struct {
+    int posicao;   /**< Posição em Mochila.itens (ou no vetor indexado) */
+    int distancia; /**< Distância de Levenshtein (inserções, remoções e substituições) */
+} SugestaoNome;
+
+/**
+ * @brief Constrói a árvore radix a partir de nomes em ordem alfabética
+ * @param idx Índice (alocações anteriores são reaproveitadas)
+ * @param itens Vetor de componentes
+ * @param ordem Posições de itens em ordem de nome, ou NULL se itens já está ordenado por nome
+ * @param tamanho Número de posições
+ * @return 1 em caso de sucesso, 0 se faltou memória
+ * @details Cada nó acha as fronteiras dos filhos por busca binária sobre o
+ *          caractere seguinte ao prefixo comum: O(nós · log n), no máximo 2n nós
+ */
+int radixConstruir(IndiceRadix *idx, const Componente itens[], const int ordem[], int tamanho);
+
+/**
+ * @brief Busca exata na árvore radix
+ * @return Posição em itens, ou -1
+ * @details O(comprimento do nome), independente de n; comparacoesVetor = nós visitados
+ */
+int radixBuscar(const IndiceRadix *idx, const char nome[]);
+
+/**
+ * @brief Nomes que começam com prefixo
+ * @param primeiro Primeiro resultado em idx->ordem (SAÍDA)
+ * @return Quantidade de nomes com o prefixo: idx->ordem[primeiro..primeiro+total), em ordem alfabética
+ * @details O(comprimento do prefixo): a contagem vem pronta no nó
+ */
+int radixPrefixo(const IndiceRadix *idx, const char prefixo[], int *primeiro);
+
+/**
+ * @brief Nomes a até distanciaMaxima edições (Levenshtein) do nome buscado
+ * @param distanciaMaxima 0 a DISTANCIA_APROXIMADA_MAXIMA
+ * @param resultado Vetor alocado com malloc (liberar com free), ou NULL se vazio (SAÍDA)
+ * @return Número de sugestões, da menor para a maior distância (empates em ordem alfabética)
+ * @details Percorre a árvore calculando uma linha da matriz de edição por
+ *          caractere do rótulo; um ramo é abandonado quando a linha inteira
+ *          passa de distanciaMaxima, então só os prefixos viáveis são visitados.
+ *          comparacoesVetor = nós visitados
+ */
+int radixAproximado(const IndiceRadix *idx, const char nome[], int distanciaMaxima, SugestaoNome **resultado);
+
+/** @brief Libera nós, rótulos e ordem */
+void radixLiberar(IndiceRadix *idx);
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t radixMemoriaBytes(const IndiceRadix *idx);
+
+/**
+ * @brief Autocompletar: componentes cujo nome começa com prefixo, em ordem alfabética
+ * @param m Mochila (não precisa estar ordenada)
+ * @param prefixo Início do nome ("" = todos)
+ * @param maximo Máximo de posições devolvidas (0 = todas)
+ * @param total Posições devolvidas (SAÍDA)
+ * @param correspondencias Nomes com o prefixo, mesmo além de maximo (SAÍDA, pode ser NULL)
+ * @return Vetor de posições alocado com malloc (liberar com free), ou NULL se vazio
+ * @details Reconstrói a árvore (a partir do índice ordenado) só se a mochila
+ *          mudou desde a última consulta
+ */
+int *mochilaBuscarPorPrefixo(Mochila *m, const char prefixo[], int maximo, int *total, int *correspondencias);
+
+/**
+ * @brief Busca tolerante a erros de digitação (Levenshtein <= distanciaMaxima)
+ * @param m Mochila (não precisa estar ordenada)
+ * @param maximo Máximo de sugestões devolvidas (0 = todas), as mais próximas primeiro
+ * @param total Sugestões devolvidas (SAÍDA)
+ * @return Vetor alocado com malloc (liberar com free), ou NULL se nenhuma
+ */
+SugestaoNome *mochilaBuscarAproximado(Mochila *m, const char nome[], int distanciaMaxima, int maximo, int *total);
+
+// ============================================================================
+// ÍNDICE ORDENADO POR NOME (BLOCOS ORDENADOS)
+// ============================================================================
+
+/** @brief Insere a posição pos (nome em itens[pos]) mantendo a ordem; 0 se faltou memória */
+int indiceOrdenadoInserir(IndiceOrdenado *idx, const Componente itens[], int pos);
+
+/** @brief Remove a entrada que aponta para pos */
+void indiceOrdenadoRemover(IndiceOrdenado *idx, const Componente itens[], int pos);
+
+/** @brief Atualiza a entrada de um componente movido de de para para */
+void indiceOrdenadoMover(IndiceOrdenado *idx, const Componente itens[], int de, int para);
+
+/**
+ * @brief Reconstrói o índice a partir de itens[0..quantidade-1]
+ * @param jaOrdenado 1 se itens já está em ordem de nome (construção linear)
+ * @return 1 em caso de sucesso, 0 se faltou memória
+ */
+int indiceOrdenadoReconstruir(IndiceOrdenado *idx, const Componente itens[], int quantidade, int jaOrdenado);
+
+/** @brief Libera todos os blocos */
+void indiceOrdenadoLiberar(IndiceOrdenado *idx);
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t indiceOrdenadoMemoriaBytes(const IndiceOrdenado *idx);
+
+/** @brief Exibe o custo da última mutação e o custo médio acumulado */
+void mostrarCustoIndiceOrdenado(const IndiceOrdenado *idx);
+
+// ============================================================================
+// ÍNDICE HASH POR NOME
+// ============================================================================
+
+/**
+ * @brief Insere no índice a posição pos (o nome é lido de itens[pos])
+ * @return 1 em caso de sucesso, 0 se faltou memória para crescer a tabela
+ */
+int indiceHashInserir(IndiceHash *h, const Componente itens[], int pos);
+
+/**
+ * @brief Busca a posição do componente com o nome informado
+ * @return Posição em itens, ou -1 se não encontrado
+ */
+int indiceHashBuscar(IndiceHash *h, const Componente itens[], const char nome[]);
+
+/**
+ * @brief Remove do índice a entrada que aponta para pos
+ * @details A entrada é localizada pelo hash do nome de itens[pos], então
+ *          nomes repetidos não confundem a remoção
+ */
+void indiceHashRemover(IndiceHash *h, const Componente itens[], int pos);
+
+/**
+ * @brief Atualiza a entrada de um componente que mudou de posição
+ * @param itens Vetor onde itens[para] já contém o componente movido
+ */
+void indiceHashMover(IndiceHash *h, const Componente itens[], int de, int para);
+
+/**
+ * @brief Descarta todas as entradas e reinsere as posições 0..quantidade-1
+ */
+void indiceHashReconstruir(IndiceHash *h, const Componente itens[], int quantidade);
+
+/** @brief Libera a memória do índice */
+void indiceHashLiberar(IndiceHash *h);
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t indiceHashMemoriaBytes(const IndiceHash *h);
+
+/**
+ * @brief Exibe estatísticas do índice: fator de carga, colisões e sondagens
+ * @details Exibido junto da telemetria de comparacoesVetor
+ */
+void mostrarEstatisticasHash(const IndiceHash *h);
+
+// ============================================================================
+// FILA DE PRIORIDADE (HEAP MÁXIMO POR PRIORIDADE)
+// ============================================================================
+
+/** @brief Insere a posição pos no heap; 0 se faltou memória */
+int heapPrioridadeInserir(HeapPrioridade *h, const Componente itens[], int pos);
+
+/** @brief Remove do heap a entrada da posição pos (O(log n)) */
+void heapPrioridadeRemover(HeapPrioridade *h, const Componente itens[], int pos);
+
+/** @brief Atualiza a entrada de um componente movido de de para para (O(1), a chave não muda) */
+void heapPrioridadeMover(HeapPrioridade *h, int de, int para);
+
+/**
+ * @brief Reconstrói o heap com as posições 0..quantidade-1 (heapify O(n))
+ * @return 1 em caso de sucesso, 0 se faltou memória
+ */
+int heapPrioridadeReconstruir(HeapPrioridade *h, const Componente itens[], int quantidade);
+
+/** @brief Libera a memória do heap */
+void heapPrioridadeLiberar(HeapPrioridade *h);
+
+/** @brief Memória ocupada pelo heap em bytes */
+size_t heapPrioridadeMemoriaBytes(const HeapPrioridade *h);
+
+/**
+ * @brief Os K componentes mais urgentes, em ordem, sem alterar a mochila
+ * @param m Mochila
+ * @param k Quantidade desejada (limitada a m->quantidade)
+ * @param total Número de posições retornadas (SAÍDA)
+ * @return Vetor de posições alocado com malloc (liberar com free), ou NULL se vazio
+ * @details O(K log K): percorre o heap com um heap auxiliar de candidatos
+ *          (a raiz, e a cada retirada os dois filhos da entrada retirada),
+ *          sem tocar nos demais n - K itens. Atualiza comparacoesVetor
+ */
+int *mochilaTopK(Mochila *m, int k, int *total);
+
+/**
+ * @brief Retira da mochila o componente mais urgente
+ * @param m Mochila (MODIFICADA)
+ * @param retirado Componente removido (SAÍDA)
+ * @return 1 se havia componente, 0 se a mochila está vazia
+ * @details O(log n): topo do heap + descarte por troca com o último item
+ */
+int mochilaRetirarMaisUrgente(Mochila *m, Componente *retirado);
+
+// ============================================================================
+// ÍNDICES SECUNDÁRIOS (TIPO E PRIORIDADE)
+// ============================================================================
+
+/** @brief Insere a posição pos no grupo da sua chave; 0 se faltou memória */
+int indiceSecundarioInserir(IndiceSecundario *idx, const Componente itens[], int pos);
+
+/** @brief Remove a posição pos do seu grupo (itens[pos] ainda válido); grupos vazios são descartados */
+void indiceSecundarioRemover(IndiceSecundario *idx, const Componente itens[], int pos);
+
+/** @brief Atualiza a entrada de um componente movido de de para para (itens[para] já copiado) */
+void indiceSecundarioMover(IndiceSecundario *idx, const Componente itens[], int de, int para);
+
+/**
+ * @brief Reconstrói os grupos a partir de itens[0..quantidade-1]
+ * @return 1 em caso de sucesso, 0 se faltou memória
+ */
+int indiceSecundarioReconstruir(IndiceSecundario *idx, const Componente itens[], int quantidade);
+
+/** @brief Libera os grupos (o tipo de chave e a telemetria são preservados) */
+void indiceSecundarioLiberar(IndiceSecundario *idx);
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t indiceSecundarioMemoriaBytes(const IndiceSecundario *idx);
+
+/** @brief Exibe o custo da última mutação e o custo médio acumulado */
+void mostrarCustoIndiceSecundario(const IndiceSecundario *idx);
+
+/**
+ * @brief Todos os componentes de um tipo
+ * @param m Mochila (não precisa estar ordenada)
+ * @param tipo Tipo buscado (comparação exata)
+ * @param total Número de posições retornadas (SAÍDA)
+ * @param somaQuantidade Soma de quantidade do tipo (SAÍDA, pode ser NULL)
+ * @return Posições do grupo, válidas até a próxima mutação da mochila (não liberar),
+ *         ou NULL se o tipo não existe
+ * @details O(log g): o resultado já está pronto no grupo. Atualiza comparacoesVetor
+ */
+const int *mochilaBuscarPorTipo(Mochila *m, const char tipo[], int *total, long long *somaQuantidade);
+
+/**
+ * @brief Componentes com min <= prioridade <= max, em ordem crescente de prioridade
+ * @param total Número de posições retornadas (SAÍDA)
+ * @return Vetor de posições alocado com malloc (liberar com free), ou NULL se vazio
+ * @details O(log g + k); atualiza comparacoesVetor
+ */
+int *mochilaBuscarFaixaPrioridade(Mochila *m, int min, int max, int *total);
+
+/**
+ * @brief Exibe, por tipo, o número de componentes e o total de quantidade
+ * @details O(g): os agregados são mantidos pelo índice, sem percorrer os itens
+ */
+void mostrarTotaisPorTipo(const Mochila *m);
+
+// ============================================================================
+// DICIONÁRIO DE TIPOS (IDS COMPACTOS)
+// ============================================================================
+
+/**
+ * @brief Id do tipo, criando-o se ainda não existe, e soma 1 à sua contagem
+ * @return Id (0..MAX_TIPOS_DISTINTOS-1), ou -1 se faltou memória ou o dicionário está cheio
+ */
+int dicionarioTiposRegistrar(DicionarioTipos *d, const char tipo[]);
+
+/** @brief Subtrai 1 da contagem do id (o id continua reservado até a próxima reconstrução) */
+void dicionarioTiposSoltar(DicionarioTipos *d, int id);
+
+/** @brief Id do tipo, ou -1 se ele não está no dicionário */
+int dicionarioTiposBuscar(DicionarioTipos *d, const char tipo[]);
+
+/** @brief Texto original do id */
+const char *dicionarioTiposTexto(const DicionarioTipos *d, int id);
+
+/**
+ * @brief Calcula o posto alfabético de cada id, se algum tipo novo surgiu desde a última vez
+ * @return 1 em caso de sucesso, 0 se faltou memória
+ * @details O(k log k) com k tipos distintos; soma as comparações em d->comparacoes
+ */
+int dicionarioTiposOrdenar(DicionarioTipos *d);
+
+/**
+ * @brief Refaz o dicionário a partir de itens[0..quantidade-1], gravando o id de cada item em ids
+ * @return 1 em caso de sucesso, 0 se faltou memória
+ * @details Tipos sem nenhum componente deixam de ocupar ids
+ */
+int dicionarioTiposReconstruir(DicionarioTipos *d, const Componente itens[], int quantidade, uint16_t ids[]);
+
+/** @brief Libera o dicionário */
+void dicionarioTiposLiberar(DicionarioTipos *d);
+
+/** @brief Memória ocupada pelo dicionário em bytes */
+size_t dicionarioTiposMemoriaBytes(const DicionarioTipos *d);
+
+/**
+ * @brief Ordena a mochila por tipo com Counting Sort sobre os ids calculados na inserção
+ * @param m Mochila (MODIFICADA)
+ * @return 1 em caso de sucesso, 0 se faltou memória (a mochila fica como estava)
+ * @details O(n + k): conta os itens de cada posto, acumula e distribui de
+ *          forma estável. Nenhum tipo é comparado ou hasheado por item; as
+ *          comparações relatadas são só as dos k tipos ao recalcular os postos
+ */
+int mochilaOrdenarPorTipo(Mochila *m);
+
+// ============================================================================
+// PERSISTÊNCIA - SNAPSHOT BINÁRIO MAPEADO EM MEMÓRIA
+// ============================================================================
+
+/** @def MAGICA_SNAPSHOT Identificação dos 8 primeiros bytes de um snapshot */
+#define MAGICA_SNAPSHOT "FFMOCHIL"
+
+/** @def VERSAO_SNAPSHOT Versão atual do formato binário */
+#define VERSAO_SNAPSHOT 1
+
+/** @def SNAPSHOT_ORDENADO_POR_NOME Flag: os registros estão em ordem de nome (sem índice separado) */
+#define SNAPSHOT_ORDENADO_POR_NOME 0x1u
+
+/** @def SNAPSHOT_COM_INDICE Flag: há um vetor uint32 com as posições em ordem de nome */
+#define SNAPSHOT_COM_INDICE 0x2u
+
+/**
+ * @struct CabecalhoSnapshot
+ * @brief Início do arquivo de snapshot (72 bytes, ordem de bytes nativa)
+ *
+ * Layout do arquivo:
+ * [cabeçalho][quantidade × Componente][quantidade × uint32 (se SNAPSHOT_COM_INDICE)]
+ *
+ * Os registros são gravados exatamente como na memória, então o arquivo
+ * mapeado é usado diretamente como vetor de Componente.
+ */
+typedef struct {
+    char magica[8];                 /**< MAGICA_SNAPSHOT (sem '\0') */
+    uint32_t versao;                /**< VERSAO_SNAPSHOT */
+    uint32_t flags;                 /**< SNAPSHOT_ORDENADO_POR_NOME | SNAPSHOT_COM_INDICE */
+    uint64_t quantidade;            /**< Número de registros */
+    uint64_t tamanhoRegistro;       /**< sizeof(Componente) de quem gravou (valida o layout) */
+    uint64_t deslocamentoRegistros; /**< Início dos registros no arquivo */
+    uint64_t deslocamentoIndice;    /**< Início do índice por nome (0 = ausente) */
+    uint64_t lsn;                   /**< Última entrada de diário incluída no snapshot (0 = sem diário) */
+    uint64_t reservado[2];          /**< Reservado para extensões (gravado como zero) */
+} CabecalhoSnapshot;
+
+/**
+ * @struct SnapshotMapeado
+ * @brief Snapshot aberto com mmap (somente leitura, sem desserializar)
+ */
+typedef struct {
+    void *mapa;                   /**< Região mapeada */
+    size_t tamanhoMapa;           /**< Bytes mapeados */
+    const CabecalhoSnapshot *cabecalho;
+    const Componente *registros;  /**< Registros diretamente no arquivo mapeado */
+    const uint32_t *indiceNome;   /**< Posições em ordem de nome, ou NULL se os registros já estão ordenados */
+    int quantidade;               /**< Número de registros */
+} SnapshotMapeado;
+
+/**
+ * @brief Grava a mochila em um snapshot binário
+ * @param m Mochila
+ * @param caminho Arquivo de destino (substituído de forma atômica)
+ * @return 1 em caso de sucesso, 0 em caso de erro de E/S
+ * @details Se a mochila não estiver ordenada por nome, grava também a ordem
+ *          do índice ordenado, para que o arquivo aceite busca binária
+ */
+int mochilaSalvar(const Mochila *m, const char caminho[]);
+
+/**
+ * @brief Mapeia um snapshot em memória e valida o cabeçalho
+ * @param caminho Arquivo do snapshot
+ * @param snap Snapshot mapeado (SAÍDA)
+ * @return 1 em caso de sucesso, 0 se o arquivo não existe ou é inválido (motivo em stderr)
+ */
+int snapshotMapear(const char caminho[], SnapshotMapeado *snap);
+
+/** @brief Desfaz o mapeamento do snapshot */
+void snapshotDesmapear(SnapshotMapeado *snap);
+
+/**
+ * @brief Busca binária por nome diretamente no arquivo mapeado
+ * @param snap Snapshot mapeado
+ * @param nome Nome buscado
+ * @return Posição do registro em snap->registros, ou -1
+ * @details O(log n) páginas tocadas; atualiza comparacoesVetor como buscaBinariaPorNome
+ */
+int snapshotBuscarPorNome(const SnapshotMapeado *snap, const char nome[]);
+
+/**
+ * @brief Substitui o conteúdo da mochila pelo de um snapshot
+ * @param m Mochila (MODIFICADA)
+ * @param caminho Arquivo do snapshot
+ * @return 1 em caso de sucesso, 0 se o arquivo é inválido, excede o limite da mochila ou faltou memória
+ * @details Copia os registros mapeados em bloco e reconstrói os índices
+ */
+int mochilaCarregar(Mochila *m, const char caminho[]);
+
+/**
+ * @brief Opção --consultar: busca nomes direto no snapshot mapeado, sem carregar a mochila
+ * @param caminho Arquivo do snapshot
+ * @param totalNomes Número de nomes
+ * @param nomes Nomes buscados
+ * @return 0 em caso de sucesso, 1 se o snapshot não pôde ser aberto
+ */
+int consultarSnapshot(const char caminho[], int totalNomes, char *nomes[]);
+
+// ============================================================================
+// DIÁRIO DE OPERAÇÕES (WRITE-AHEAD LOG) - RECUPERAÇÃO E COMPACTAÇÃO
+// ============================================================================
+
+/** @def MAGICA_DIARIO Identificação dos 8 primeiros bytes do diário */
+#define MAGICA_DIARIO "FFDIARIO"
+
+/** @def VERSAO_DIARIO Versão atual do formato do diário */
+#define VERSAO_DIARIO 1
+
+/** @def DIARIO_GRUPO_PADRAO Operações por fsync (group commit), salvo --diario-grupo */
+#define DIARIO_GRUPO_PADRAO 64
+
+/** @def DIARIO_INTERVALO_PADRAO_MS Espera máxima de uma operação antes do fsync do seu grupo */
+#define DIARIO_INTERVALO_PADRAO_MS 20
+
+/** @def DIARIO_LIMITE_PADRAO Tamanho do diário (bytes) que dispara a compactação, salvo --diario-limite */
+#define DIARIO_LIMITE_PADRAO (4LL << 20)
+
+/** @enum OperacaoDiario @brief Operações registradas no diário */
+typedef enum {
+    OPERACAO_DIARIO_ADICIONAR = 1, /**< Registro completo do componente inserido */
+    OPERACAO_DIARIO_DESCARTAR = 2  /**< Só o nome do componente removido */
+} OperacaoDiario;
+
+/**
+ * @struct CabecalhoDiario
+ * @brief Início do arquivo do diário (32 bytes, ordem de bytes nativa)
+ *
+ * Layout do arquivo: [cabeçalho][registros de tamanho fixo, em ordem de LSN]
+ */
+typedef struct {
+    char magica[8];           /**< MAGICA_DIARIO (sem '\0') */
+    uint32_t versao;          /**< VERSAO_DIARIO */
+    uint32_t tamanhoRegistro; /**< sizeof(RegistroDiario) de quem gravou (valida o layout) */
+    uint64_t lsnBase;         /**< LSN do snapshot de base quando o arquivo foi criado */
+    uint64_t reservado;       /**< Gravado como zero */
+} CabecalhoDiario;
+
+/**
+ * @struct RegistroDiario
+ * @brief Uma operação do diário (80 bytes)
+ * @details O registro é zerado antes de preenchido, então a verificação cobre
+ *          bytes determinísticos; um registro com verificação errada marca o
+ *          fim do diário (escrita interrompida por queda)
+ */
+typedef struct {
+    uint32_t verificacao;  /**< FNV-1a dos bytes seguintes do registro */
+    uint32_t operacao;     /**< OperacaoDiario */
+    uint64_t lsn;          /**< Número de sequência (1, 2, 3... nunca reutilizado) */
+    Componente componente; /**< ADICIONAR: registro completo; DESCARTAR: só o nome */
+} RegistroDiario;
+
+/**
+ * @struct DiarioOperacoes
+ * @brief Diário de inserções e descartes com group commit e compactação em segundo plano
+ * @details A thread principal só acrescenta registros à fila (sob a trava) e
+ *          segue; a thread escritora grava a fila inteira com um write() e um
+ *          fdatasync() quando o grupo enche, quando a operação mais antiga
+ *          espera intervaloMs ou quando alguém pede sincronização. Uma queda
+ *          perde no máximo essa janela. Quando o arquivo passa de limiteBytes,
+ *          a thread principal copia os itens e a escritora grava um snapshot
+ *          com o LSN da cópia e reescreve o diário só com as operações posteriores
+ */
+typedef struct DiarioOperacoes {
+    char caminhoDiario[1024];   /**< "<base>.wal" */
+    char caminhoSnapshot[1024]; /**< "<base>.snap" (base da recuperação) */
+    int fd;                     /**< Diário aberto em O_APPEND (usado só pela escritora) */
+    pthread_t escritor;         /**< Thread do group commit e da compactação */
+    pthread_mutex_t trava;      /**< Protege fila, LSNs, pedidos e contadores */
+    pthread_cond_t haTrabalho;  /**< Principal -> escritora */
+    pthread_cond_t progresso;   /**< Escritora -> principal (fsync ou compactação concluídos) */
+    RegistroDiario *fila;       /**< Registros ainda não gravados */
+    int totalFila;              /**< Registros na fila */
+    int capacidadeFila;         /**< Registros alocados */
+    long long inicioFilaNs;     /**< Chegada do registro mais antigo da fila */
+    uint64_t ultimoLsn;         /**< Último LSN atribuído */
+    uint64_t lsnDuravel;        /**< Maior LSN já com fdatasync */
+    uint64_t lsnPedido;         /**< Maior LSN que alguém espera ver durável */
+    uint64_t lsnBase;           /**< LSN do snapshot de base (entradas até ele são ignoradas) */
+    int grupoMaximo;            /**< Operações por fsync */
+    int intervaloMs;            /**< Espera máxima por um grupo cheio */
+    long long limiteBytes;      /**< Tamanho do diário que dispara a compactação */
+    long long tamanhoArquivo;   /**< Bytes atuais do diário */
+    Componente *copiaCompactacao; /**< Itens copiados para o próximo snapshot (NULL = nenhum pedido) */
+    int quantidadeCompactacao;  /**< Itens da cópia */
+    uint64_t lsnCompactacao;    /**< LSN refletido na cópia */
+    int compactando;            /**< 1 = pedido aceito e ainda não concluído */
+    int encerrar;               /**< 1 = a escritora grava o restante e termina */
+    int falha;                  /**< 1 = erro de E/S (diário deixa de ser durável) */
+    long long operacoes;        /**< Operações registradas */
+    long long bytesLogicos;     /**< Bytes das operações (sizeof(Componente) por operação) */
+    long long bytesGravados;    /**< Bytes escritos no disco: diário, snapshots e reescritas */
+    long long sincronizacoes;   /**< Chamadas fdatasync/fsync do diário */
+    long long maiorGrupo;       /**< Maior número de operações gravadas por um fsync */
+    long long compactacoes;     /**< Compactações concluídas */
+    long long tempoCompactacaoNs; /**< Tempo da última compactação (na escritora) */
+    long long tempoReplayNs;    /**< Tempo da recuperação (snapshot + diário) */
+    long long registrosReaplicados; /**< Operações do diário aplicadas na recuperação */
+    long long registrosIgnorados;   /**< Operações já contidas no snapshot */
+    long long bytesDescartados;     /**< Cauda inválida truncada na recuperação */
+} DiarioOperacoes;
+
+/**
+ * @struct ConfiguracaoDiario
+ * @brief Opções --diario, --diario-grupo, --diario-intervalo e --diario-limite
+ */
+typedef struct {
+    const char *base;       /**< Prefixo dos arquivos (NULL = sem diário) */
+    int grupo;              /**< Operações por fsync (0 = padrão) */
+    int intervaloMs;        /**< Espera máxima do group commit (0 = padrão) */
+    long long limiteBytes;  /**< Tamanho que dispara a compactação (0 = padrão) */
+} ConfiguracaoDiario;
+
+/**
+ * @brief Recupera a mochila e passa a registrar as mutações em um diário
+ * @param d Diário (SAÍDA)
+ * @param m Mochila (MODIFICADA: recebe o snapshot e as operações do diário)
+ * @param base Prefixo dos arquivos: "<base>.snap" e "<base>.wal"
+ * @param grupo Operações por fsync (<= 0 = DIARIO_GRUPO_PADRAO)
+ * @param intervaloMs Espera máxima de uma operação não gravada (<= 0 = DIARIO_INTERVALO_PADRAO_MS)
+ * @param limiteBytes Tamanho que dispara a compactação (<= 0 = DIARIO_LIMITE_PADRAO)
+ * @return 1 em caso de sucesso, 0 se o diário não pôde ser aberto ou está corrompido no cabeçalho
+ * @details Recuperação: carrega o snapshot (se existir), reaplica as operações
+ *          com LSN maior que o dele e trunca uma cauda incompleta. O limite da
+ *          mochila é ignorado durante a reaplicação
+ */
+int diarioAbrir(DiarioOperacoes *d, Mochila *m, const char base[], int grupo, int intervaloMs, long long limiteBytes);
+
+/**
+ * @brief Acrescenta uma operação à fila do group commit (chamada pela mochila)
+ * @return 1 se o diário passou do limite e pede compactação, 0 caso contrário
+ */
+int diarioRegistrar(DiarioOperacoes *d, OperacaoDiario operacao, const Componente *c);
+
+/** @brief Último LSN atribuído (gravado no cabeçalho dos snapshots) */
+uint64_t diarioLsnAtual(const DiarioOperacoes *d);
+
+/**
+ * @brief Espera até que todas as operações registradas estejam em disco
+ * @return 1 se duráveis, 0 se houve erro de E/S
+ */
+int diarioSincronizar(DiarioOperacoes *d);
+
+/**
+ * @brief Pede a compactação: snapshot do estado atual + diário só com as operações posteriores
+ * @param aguardar 1 = espera a conclusão (checkpoint); 0 = segue em segundo plano
+ * @return 1 se o pedido foi aceito (ou concluído, com aguardar), 0 se já havia um em andamento ou faltou memória
+ */
+int diarioCompactar(DiarioOperacoes *d, const Mochila *m, int aguardar);
+
+/**
+ * @brief Grava o restante da fila, encerra a escritora e desliga o diário da mochila
+ */
+void diarioFechar(DiarioOperacoes *d, Mochila *m);
+
+/**
+ * @brief Exibe recuperação, group commit, tamanho do diário e amplificação de escrita
+ * @details Amplificação = bytes escritos no disco / bytes das operações
+ */
+void mostrarEstatisticasDiario(DiarioOperacoes *d);
+
+// ============================================================================
+// IMPORTAÇÃO E EXPORTAÇÃO EM FLUXO (CSV E JSON LINES)
+// ============================================================================
+
+/** @enum FormatoArquivo @brief Formatos textuais aceitos na importação/exportação */
+typedef enum {
+    ARQUIVO_CSV,   /**< nome,tipo,quantidade,prioridade (cabeçalho opcional, aspas RFC 4180) */
+    ARQUIVO_JSONL  /**< Um objeto {"nome": ..., "tipo": ..., "quantidade": ..., "prioridade": ...} por linha */
+} FormatoArquivo;
+
+/**
+ * @struct EstatisticasTransferencia
+ * @brief Resultado de uma importação ou exportação
+ */
+typedef struct {
+    long long bytes;      /**< Bytes lidos ou gravados */
+    long long registros;  /**< Componentes importados ou exportados */
+    long long rejeitados; /**< Linhas inválidas (formato, campos ausentes, linha longa demais) */
+    long long recusados;  /**< Linhas válidas recusadas pela mochila (limite ou memória) */
+    long long tempoNs;    /**< Tempo de parede da operação */
+} EstatisticasTransferencia;
+
+/**
+ * @brief Deduz o formato pela extensão: .jsonl/.json => JSON Lines; demais => CSV
+ */
+FormatoArquivo formatoPorCaminho(const char caminho[]);
+
+/**
+ * @brief Importa componentes de um arquivo CSV ou JSON Lines
+ * @param m Mochila (MODIFICADA: componentes adicionados ao final)
+ * @param caminho Arquivo de origem, ou "-" para a entrada padrão
+ * @param formato Formato do arquivo
+ * @param est Estatísticas (SAÍDA)
+ * @return 1 se o arquivo foi lido até o fim, 0 se não pôde ser aberto ou houve erro de leitura
+ * @details Lê blocos de TAM_BLOCO_ES bytes com fread e separa as linhas no
+ *          próprio bloco: a memória usada não depende do tamanho do arquivo
+ */
+int mochilaImportar(Mochila *m, const char caminho[], FormatoArquivo formato, EstatisticasTransferencia *est);
+
+/**
+ * @brief Exporta a mochila para CSV ou JSON Lines
+ * @param m Mochila
+ * @param caminho Arquivo de destino, ou "-" para a saída padrão
+ * @param formato Formato do arquivo
+ * @param est Estatísticas (SAÍDA)
+ * @return 1 em caso de sucesso, 0 em caso de erro de E/S
+ * @details Formata os registros em um bloco de TAM_BLOCO_ES bytes e grava
+ *          um bloco por vez
+ */
+int mochilaExportar(const Mochila *m, const char caminho[], FormatoArquivo formato, EstatisticasTransferencia *est);
+
+/**
+ * @brief Exibe vazão da transferência em MB/s e registros/s
+ * @param operacao "Importacao" ou "Exportacao"
+ */
+void mostrarEstatisticasTransferencia(const char operacao[], const EstatisticasTransferencia *est);
+
+// ============================================================================
+// MODO EM LOTE (HEADLESS) - REPRODUÇÃO DE CARGA SEM MENU
+// ============================================================================
+
+/**
+ * @struct EstatisticasLote
+ * @brief Contadores agregados de uma execução em lote
+ */
+typedef struct {
+    long long linhas;      /**< Linhas lidas do fluxo de comandos */
+    long long adicoes;     /**< Comandos ADD executados */
+    long long descartes;   /**< Comandos DEL executados */
+    long long ordenacoes;  /**< Comandos SORT/SORTBY executados */
+    long long buscas;      /**< Comandos FIND executados (FINDMANY/FINDMERGE contam um por nome) */
+    long long listagens;   /**< Comandos LIST executados */
+    long long linhasListadas;  /**< Linhas de componentes escritas pelos LIST */
+    long long tempoListagemNs; /**< Tempo de parede somado dos LIST */
+    long long falhas;      /**< Operações rejeitadas (mochila cheia, nome inexistente...) */
+    long long encontrados; /**< Buscas que localizaram o componente */
+    long long intervalos;  /**< Comandos RANGE executados */
+    long long resultadosIntervalo; /**< Componentes retornados pelos RANGE */
+    long long consultasAproximadas; /**< Comandos PREFIX/FUZZY executados */
+    long long sugestoes;   /**< Nomes retornados pelos PREFIX/FUZZY */
+    long long snapshots;   /**< Comandos SAVE/LOAD executados */
+    long long transferencias; /**< Comandos IMPORT/EXPORT executados */
+    long long consultasTopK; /**< Comandos TOPK executados */
+    long long retiradas;   /**< Comandos POP executados */
+    long long consultasSecundarias;  /**< Comandos TYPE/PRIORANGE/TOTALS executados */
+    long long resultadosSecundarios; /**< Componentes retornados pelos TYPE/PRIORANGE */
+    long long comandosDiario; /**< Comandos SYNC/COMPACT executados */
+    long long escolhasAutomaticas[TOTAL_ALGORITMOS]; /**< SORT ... AUTO: vezes que cada algoritmo foi escolhido */
+    EstatisticasTransferencia importacao; /**< Soma de todos os IMPORT (bytes, registros, tempo) */
+    long long invalidas;   /**< Linhas com comando ou argumentos inválidos */
+} EstatisticasLote;
+
+/**
+ * @brief Executa um comando do modo em lote sobre a mochila
+ * @param linha Linha de comando já sem o '\n' final
+ * @param m Mochila (MODIFICADA)
+ * @param est Estatísticas agregadas (MODIFICADAS)
+ * @details Comandos aceitos (sem diferenciar maiúsculas):
+ *          ADD nome;tipo;quantidade;prioridade | DEL nome | FIND nome
+ *          FINDMANY nome1;nome2;... (buscas em paralelo se ordenada por nome)
+ *          FINDMERGE nome1;nome2;... (nomes ordenados, uma passada pelo vetor)
+ *          FINDMANY/FINDMERGE @arquivo (um nome por linha, sem limite de quantidade)
+ *          SORT NOME|TIPO|PRIORIDADE [CLASSICO|INTRO|MERGE|RADIX|CHAVES|PARALELO|CONTAGEM|ADAPTATIVO]
+ *          SORTBY campo [asc|desc], ... (várias chaves numa passada estável)
+ *          LIST [inicio [quantidade]] (página da tabela; linhas a partir de 1)
+ *          RANGE de;ate (busca por intervalo de nomes)
+ *          PREFIX prefixo[;k] | FUZZY nome[;d] (árvore radix: autocompletar e distância de edição <= d)
+ *          SAVE arquivo | LOAD arquivo (snapshot binário)
+ *          IMPORT arquivo | EXPORT arquivo (CSV ou .jsonl, em fluxo)
+ *          TOPK k (mais urgentes, via heap) | POP (retira o mais urgente)
+ *          TYPE tipo | PRIORANGE min;max | TOTALS (índices secundários)
+ *          SYNC (espera o fsync do diário) | COMPACT (snapshot + diário reescrito)
+ *          METRICS [arquivo] (métricas de operação; sem arquivo: Prometheus na saída padrão)
+ *          Linhas vazias e iniciadas por '#' são ignoradas
+ */
+void executarComandoLote(char linha[], Mochila *m, EstatisticasLote *est);
+
+/**
+ * @brief Modo não interativo: lê comandos de um arquivo (ou stdin) e os executa em sequência
+ * @param caminho Arquivo de comandos, ou NULL / "-" para ler da entrada padrão
+ * @param limite Limite de componentes da mochila (0 = sem limite)
+ * @param snapshotInicial Snapshot carregado antes do primeiro comando (NULL = mochila vazia)
+ * @param configDiario Diário de operações (NULL ou base NULL = sem diário)
+ * @return 0 em caso de sucesso, 1 se o arquivo não pôde ser aberto
+ * @details Não exibe prompts nem a tabela após cada operação; ao final imprime
+ *          o total de operações por tipo e a vazão agregada (operações/segundo).
+ *          Com diário, a vazão inclui o fsync final de todas as operações
+ */
+int executarLote(const char caminho[], int limite, const char snapshotInicial[], const ConfiguracaoDiario *configDiario);
+
+// ============================================================================
+// SERVIDOR LOCAL (SOCKET UNIX) - LEITURAS SEM TRAVA
+// ============================================================================
+
+/** @def MAX_CLIENTES_SERVIDOR Conexões simultâneas (cada uma com um slot de leitor) */
+#define MAX_CLIENTES_SERVIDOR 64
+
+/** @def LOTE_PUBLICACAO Escritas seguidas que podem adiar a publicação de uma nova visão */
+#define LOTE_PUBLICACAO 64
+
+/**
+ * @struct VisaoInventario
+ * @brief Cópia imutável da mochila em ordem de nome, lida sem trava
+ * @details Cada publicação cria uma visão nova e troca o ponteiro atual de
+ *          forma atômica; a antiga só é liberada quando nenhum leitor que
+ *          possa tê-la visto ainda está lendo (recuperação por épocas)
+ */
+typedef struct VisaoInventario {
+    uint64_t versao;                          /**< Escritas refletidas nesta visão */
+    uint64_t epocaRetirada;                   /**< Época global quando deixou de ser a atual */
+    struct VisaoInventario *proximaRetirada;  /**< Lista de visões aguardando liberação */
+    int quantidade;                           /**< Componentes da visão */
+    Componente itens[];                       /**< Ordenados por nome (busca binária direta) */
+} VisaoInventario;
+
+/**
+ * @struct SlotLeitor
+ * @brief Época anunciada por uma conexão enquanto lê uma visão (0 = fora de leitura)
+ * @details Um slot por linha de cache: leitores de conexões diferentes não
+ *          disputam a mesma linha ao anunciar a época
+ */
+typedef struct {
+    uint64_t epoca;
+    int ocupado;
+    int fd;
+    char preenchimento[48];
+} SlotLeitor;
+
+/**
+ * @struct ServidorInventario
+ * @brief Estado compartilhado do servidor
+ * @details Escritas (ADD/DEL) passam pela trava de escrita e pelos mesmos
+ *          caminhos do menu (índices e diário incluídos). Leituras (FIND,
+ *          LIST, COUNT) usam só a visão publicada: nunca esperam um escritor
+ */
+typedef struct {
+    Mochila *mochila;                 /**< Estado mutável (só sob travaEscrita) */
+    pthread_mutex_t travaEscrita;     /**< Serializa escritas e publicações */
+    VisaoInventario *visao;           /**< Visão atual (acesso atômico) */
+    VisaoInventario *retiradas;       /**< Visões antigas ainda não liberadas (sob travaEscrita) */
+    uint64_t epocaGlobal;             /**< Época atual (acesso atômico; começa em 1) */
+    uint64_t versaoEscrita;           /**< Escritas aplicadas (sob travaEscrita) */
+    int escritoresEsperando;          /**< Escritores na fila da trava (acesso atômico) */
+    SlotLeitor leitores[MAX_CLIENTES_SERVIDOR]; /**< Slots das conexões */
+    pthread_mutex_t travaConexoes;    /**< Protege ocupado/fd dos slots e conexoesAtivas */
+    pthread_cond_t semConexoes;       /**< Sinalizada quando a última conexão termina */
+    int conexoesAtivas;               /**< Threads de conexão em execução */
+    int encerrar;                     /**< 1 = parar de aceitar conexões (acesso atômico) */
+    long long leituras;               /**< Leituras atendidas (acesso atômico) */
+    long long escritas;               /**< Escritas aplicadas (acesso atômico) */
+    long long publicacoes;            /**< Visões publicadas */
+    long long visoesLiberadas;        /**< Visões antigas liberadas */
+    long long conexoes;               /**< Conexões aceitas */
+} ServidorInventario;
+
+/**
+ * @brief Modo servidor: atende comandos de vários clientes em um socket Unix
+ * @param caminho Caminho do socket (recriado se já existir)
+ * @param limite Limite de componentes (0 = sem limite)
+ * @param snapshotInicial Snapshot carregado antes de atender (NULL = mochila vazia)
+ * @param configDiario Diário de operações (NULL ou base NULL = sem diário)
+ * @return 0 ao encerrar (SIGINT, SIGTERM ou comando SHUTDOWN), 1 em caso de erro
+ * @details Protocolo de texto, um comando por linha (mesma sintaxe do lote):
+ *          ADD nome;tipo;quantidade;prioridade -> OK versao | ERRO motivo
+ *          DEL nome -> OK versao | NAO
+ *          FIND nome -> OK nome;tipo;quantidade;prioridade;comparacoes | NAO comparacoes
+ *          LIST [inicio [quantidade]] -> OK linhas bytes, seguido de bytes da tabela em ordem de nome
+ *          COUNT -> OK quantidade versao | QUIT | SHUTDOWN
+ *          METRICS [json] -> OK bytes, seguido das métricas (Prometheus ou JSON)
+ *          Cada conexão lê as próprias escritas: se a visão atual é mais
+ *          antiga que a última escrita da conexão, ela é publicada antes da leitura
+ */
+int executarServidor(const char caminho[], int limite, const char snapshotInicial[],
+                     const ConfiguracaoDiario *configDiario);
+
+/**
+ * @struct ConfiguracaoCarga
+ * @brief Parâmetros do gerador de carga (--carga caminho [opções])
+ */
+typedef struct {
+    const char *caminho;    /**< Socket do servidor */
+    int clientes;           /**< Conexões simultâneas (uma thread cada) */
+    int operacoes;          /**< Operações por cliente */
+    int percentualEscritas; /**< Porcentagem de ADD/DEL; o restante é FIND (90%) e LIST (10%) */
+    int itensIniciais;      /**< Componentes inseridos antes da medição */
+    unsigned long long semente; /**< Semente do xorshift64 (cada cliente deriva a sua) */
+} ConfiguracaoCarga;
+
+/**
+ * @brief Gerador de carga: vários clientes concorrentes contra um servidor
+ * @return 0 em caso de sucesso, 1 se não foi possível conectar
+ * @details Mede a latência de cada requisição (ida e volta) e informa a
+ *          vazão total e p50/p99/máximo por tipo de operação
+ */
+int executarCarga(const ConfiguracaoCarga *cfg);
+
+// ============================================================================
+// BENCHMARK - DADOS SINTÉTICOS E REGRESSÃO DE DESEMPENHO
+// ============================================================================
+
+/**
+ * @enum DistribuicaoDados
+ * @brief Formato dos inventários sintéticos gerados para o benchmark
+ */
+typedef enum {
+    DIST_ALEATORIA,            /**< Nomes, tipos (24) e prioridades (1-10) uniformes */
+    DIST_ORDENADA,             /**< Já em ordem por nome, tipo e prioridade (decrescente) */
+    DIST_REVERSA,              /**< Ordem inversa da DIST_ORDENADA */
+    DIST_POUCOS_TIPOS,         /**< Aleatória, mas com apenas 3 tipos distintos */
+    DIST_PRIORIDADE_ENVIESADA, /**< Aleatória, com 60% das prioridades = 1 */
+    DIST_QUASE_ORDENADA,       /**< DIST_ORDENADA com 1% dos itens trocados de lugar */
+    TOTAL_DISTRIBUICOES
+} DistribuicaoDados;
+
+/** @enum FormatoSaida @brief Formato do relatório do benchmark */
+typedef enum { SAIDA_CSV, SAIDA_JSON } FormatoSaida;
+
+/**
+ * @struct ConfiguracaoBenchmark
+ * @brief Parâmetros do modo --bench
+ */
+typedef struct {
+    int tamanhoMaximo;      /**< Maior n testado (potências de 10 a partir de 10) */
+    int repeticoes;         /**< Execuções por medição (mediana e p99 sobre elas) */
+    int limiteQuadratico;   /**< Maior n para os algoritmos O(n²) */
+    int consultas;          /**< Consultas por repetição nas medições de busca */
+    unsigned long long semente; /**< Semente do gerador (mesma semente => mesmos dados) */
+    FormatoSaida formato;   /**< CSV ou JSON */
+    const char *arquivoSaida; /**< Arquivo de saída (NULL = stdout) */
+} ConfiguracaoBenchmark;
+
+/**
+ * @brief Gera um inventário sintético determinístico
+ * @param arr Destino com pelo menos tamanho posições
+ * @param tamanho Número de componentes
+ * @param distribuicao Formato dos dados
+ * @param semente Semente do gerador xorshift64 (mesma semente => mesmo inventário)
+ */
+void gerarComponentes(Componente arr[], int tamanho, DistribuicaoDados distribuicao, unsigned long long semente);
+
+/** @brief Nome legível da distribuição (ex: "aleatoria") */
+const char *nomeDistribuicao(DistribuicaoDados distribuicao);
+
+/**
+ * @brief Executa o benchmark completo: todas as ordenações e buscas
+ * @param cfg Parâmetros (tamanhos, repetições, formato)
+ * @return 0 em caso de sucesso, 1 em caso de erro de E/S ou memória ou se uma verificação falhou
+ * @details Para cada tamanho (10, 100, ..., tamanhoMaximo) e distribuição,
+ *          mede cada par algoritmo/critério e cada busca (binária no vetor,
+ *          índice hash, índice ordenado) e grava mediana/p99 do tempo de
+ *          parede, comparações e trocas em CSV ou JSON
+ */
+int executarBenchmark(const ConfiguracaoBenchmark *cfg);
+
+// ============================================================================
+// ORDENAÇÃO AUTOMÁTICA - ESCOLHA DO ALGORITMO POR CALIBRAÇÃO
+// ============================================================================
+
+/** @def MAX_TAMANHOS_CALIBRACAO Tamanhos medidos na calibração: 10, 100, ..., 10^8 */
+#define MAX_TAMANHOS_CALIBRACAO 8
+
+/** @def CALIBRACAO_MAX_PADRAO Maior n medido por --calibrar, salvo --calibrar-max */
+#define CALIBRACAO_MAX_PADRAO 100000
+
+/** @def CALIBRACAO_RAPIDA_MAX Maior n da calibração feita na primeira ordenação automática sem arquivo */
+#define CALIBRACAO_RAPIDA_MAX 10000
+
+/** @def CALIBRACAO_LIMITE_QUADRATICO Maior n medido para os algoritmos O(n²) (acima disso nunca vencem) */
+#define CALIBRACAO_LIMITE_QUADRATICO 1000
+
+/** @def AMOSTRAS_PERFIL Pares vizinhos (e chaves) examinados pela amostragem */
+#define AMOSTRAS_PERFIL 512
+
+/**
+ * @struct PerfilDados
+ * @brief Formato do inventário para um critério, estimado por amostragem
+ * @details Pares vizinhos igualmente espaçados medem o quanto o vetor já está
+ *          em ordem; as chaves desses pares medem a cardinalidade
+ */
+typedef struct {
+    int tamanho;             /**< n */
+    int paresAmostrados;     /**< Pares vizinhos comparados */
+    double descidas;         /**< Fração de pares fora de ordem no critério */
+    double subidas;          /**< Fração de pares em ordem estrita (o resto empata) */
+    int chavesAmostradas;    /**< Chaves examinadas */
+    int chavesDistintas;     /**< Chaves distintas entre as examinadas */
+    double maiorFrequencia;  /**< Fração da chave mais comum entre as examinadas */
+    DistribuicaoDados forma; /**< Distribuição calibrada mais parecida */
+} PerfilDados;
+
+/**
+ * @struct CalibracaoOrdenacao
+ * @brief Mediana do tempo de cada algoritmo, por critério, distribuição e tamanho, nesta máquina
+ */
+typedef struct {
+    int totalTamanhos; /**< Tamanhos medidos: 10^1 .. 10^totalTamanhos */
+    int repeticoes;    /**< Execuções por medição */
+    char maquina[96];  /**< Arquitetura, kernel de comparação e threads de quem mediu */
+    char origem[64];   /**< Arquivo carregado ou "medicao rapida" */
+    double medianaNs[TOTAL_CRITERIOS][TOTAL_DISTRIBUICOES][MAX_TAMANHOS_CALIBRACAO][TOTAL_ALGORITMOS]; /**< 0 = não medido */
+} CalibracaoOrdenacao;
+
+/**
+ * @struct DecisaoOrdenacao
+ * @brief Escolha da ordenação automática e os custos previstos
+ */
+typedef struct {
+    PerfilDados perfil;           /**< Amostragem que guiou a escolha */
+    AlgoritmoOrdenacao algoritmo; /**< Menor tempo previsto */
+    double previstoNs;            /**< Tempo previsto do escolhido */
+    AlgoritmoOrdenacao segundo;   /**< Segundo menor tempo previsto */
+    double segundoNs;             /**< Tempo previsto do segundo (-1 se não houver) */
+    long long custoDecisaoNs;     /**< Amostragem + consulta à tabela */
+} DecisaoOrdenacao;
+
+/**
+ * @brief Amostra o vetor e classifica o formato dos dados para o critério
+ * @param arr Componentes (não modificados)
+ * @param tamanho Número de elementos
+ * @param criterio Chave de ordenação
+ * @param perfil Resultado (SAÍDA)
+ * @details O(AMOSTRAS_PERFIL), qualquer que seja n
+ */
+void amostrarPerfil(const Componente arr[], int tamanho, CriterioOrdenacao criterio, PerfilDados *perfil);
+
+/**
+ * @brief Mede todos os algoritmos nas distribuições sintéticas e preenche a calibração ativa
+ * @param tamanhoMaximo Maior n (potências de 10 a partir de 10)
+ * @param repeticoes Execuções por medição (mediana)
+ * @param semente Semente dos dados sintéticos
+ * @return 1 em caso de sucesso, 0 sem memória
+ */
+int calibrarOrdenacao(int tamanhoMaximo, int repeticoes, unsigned long long semente);
+
+/** @brief Garante uma calibração ativa: sem arquivo carregado, faz a medição rápida (n até CALIBRACAO_RAPIDA_MAX) */
+void calibracaoGarantir(void);
+
+/**
+ * @brief Carrega uma calibração salva por --calibrar
+ * @return 1 em caso de sucesso, 0 se o arquivo não existe ou é inválido
+ * @details Formato texto (independe de endianness e do tamanho dos tipos);
+ *          calibração de outra máquina é aceita com aviso
+ */
+int calibracaoCarregar(const char caminho[]);
+
+/**
+ * @brief Grava a calibração ativa: medições e pontos de cruzamento
+ * @return 1 em caso de sucesso, 0 em caso de erro de E/S
+ */
+int calibracaoSalvar(const char caminho[]);
+
+/**
+ * @brief Tempo previsto (ns) de um algoritmo para n itens de uma distribuição
+ * @return Previsão, ou -1 se o algoritmo não foi medido
+ * @details Interpola o custo por item entre as potências de 10 medidas;
+ *          acima da maior, extrapola com o crescimento da última década
+ */
+double preverTempoOrdenacao(CriterioOrdenacao criterio, DistribuicaoDados forma, AlgoritmoOrdenacao algoritmo,
+                            int tamanho);
+
+/**
+ * @brief Amostra o vetor e escolhe o algoritmo de menor tempo previsto
+ * @param decisao Resultado (SAÍDA)
+ */
+void escolherOrdenacao(const Componente arr[], int tamanho, CriterioOrdenacao criterio, DecisaoOrdenacao *decisao);
+
+/**
+ * @brief Ordenação automática: escolhe, registra a decisão, ordena e compara previsto x real
+ * @param arr Array de componentes (MODIFICADO)
+ * @return Algoritmo usado
+ * @details Exibe o bloco de medirTempo com as linhas [AUTO] antes e depois
+ *          (nada em modoSilencioso)
+ */
+AlgoritmoOrdenacao ordenarAutomatico(Componente arr[], int tamanho, CriterioOrdenacao criterio);
+
+/**
+ * @brief Modo --calibrar: mede esta máquina, exibe o relatório comparativo e salva
+ * @param caminho Arquivo de calibração a gravar
+ * @param tamanhoMaximo Maior n medido
+ * @param semente Semente dos dados sintéticos
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int executarCalibracao(const char caminho[], int tamanhoMaximo, unsigned long long semente);
+
+// ============================================================================
+// FUNÇÃO PRINCIPAL - SISTEMA DE ORGANIZAÇÃO DA TORRE DE FUGA
+// ============================================================================
+/**
+ * @brief Menu interativo para gerenciar componentes da torre de fuga
+ * @details Permite adicionar, remover, listar, ordenar (3 estratégias) e buscar componentes
+ *          Integra análise de desempenho com contagem de comparações e medição de tempo
+ * @return 0 ao encerrar o programa
+ */
+int main(int argc, char *argv[]) {
+    // ======= Argumentos de linha de comando =======
+    int limite = -1;                 // --limite N (0 = sem limite)
+    int modoLote = 0;                // --batch [arquivo]
+    const char *arquivoLote = NULL;
+    int modoBenchmark = 0;           // --bench [opções]
+    const char *arquivoInicial = NULL; // --carregar arquivo (snapshot carregado na inicialização)
+    ConfiguracaoBenchmark bench = {1000000, 5, 20000, 10000, 2026, SAIDA_CSV, NULL};
+    const char *kernelSolicitado = "auto"; // --simd auto|escalar|sse2|avx2
+    ConfiguracaoDiario configDiario = {NULL, 0, 0, 0}; // --diario base [--diario-grupo N ...]
+    const char *socketServidor = NULL; // --servidor caminho
+    ConfiguracaoCarga carga = {NULL, 8, 10000, 10, 10000, 2026}; // --carga caminho [--carga-clientes N ...]
+    const char *arquivoCalibrar = NULL;    // --calibrar arquivo (mede, salva e sai)
+    int maximoCalibracao = CALIBRACAO_MAX_PADRAO; // --calibrar-max N
+    const char *arquivoCalibracao = NULL;  // --calibracao arquivo (usada pela ordenação automática)
+    const char *arquivoMetricas = NULL;    // --metricas arquivo (gravado ao sair; .json => JSON)
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--limite") == 0 && i + 1 < argc) {
+            limite = atoi(argv[++i]);
+            if(limite < 0)
+                limite = 0;
+        } else if(strcmp(argv[i], "--batch") == 0) {
+            modoLote = 1;
+            if(i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0)
+                arquivoLote = argv[++i];
+        } else if(strcmp(argv[i], "--carregar") == 0 && i + 1 < argc) {
+            arquivoInicial = argv[++i];
+        } else if(strcmp(argv[i], "--consultar") == 0 && i + 2 < argc) {
+            // --consultar arquivo nome...: busca direto no snapshot mapeado, sem carregar a mochila
+            return consultarSnapshot(argv[i + 1], argc - i - 2, argv + i + 2);
+        } else if(strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadsConfiguradas = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--listar-max") == 0 && i + 1 < argc) {
+            limiteListagem = atoi(argv[++i]);
+            if(limiteListagem < 0)
+                limiteListagem = 0;
+        } else if(strcmp(argv[i], "--diario") == 0 && i + 1 < argc) {
+            configDiario.base = argv[++i];
+        } else if(strcmp(argv[i], "--diario-grupo") == 0 && i + 1 < argc) {
+            configDiario.grupo = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--diario-intervalo") == 0 && i + 1 < argc) {
+            configDiario.intervaloMs = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--diario-limite") == 0 && i + 1 < argc) {
+            configDiario.limiteBytes = atoll(argv[++i]) * 1024; // KB
+        } else if(strcmp(argv[i], "--servidor") == 0 && i + 1 < argc) {
+            socketServidor = argv[++i];
+        } else if(strcmp(argv[i], "--carga") == 0 && i + 1 < argc) {
+            carga.caminho = argv[++i];
+        } else if(strcmp(argv[i], "--carga-clientes") == 0 && i + 1 < argc) {
+            carga.clientes = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--carga-operacoes") == 0 && i + 1 < argc) {
+            carga.operacoes = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--carga-escritas") == 0 && i + 1 < argc) {
+            carga.percentualEscritas = atoi(argv[++i]); // % de ADD/DEL
+        } else if(strcmp(argv[i], "--carga-itens") == 0 && i + 1 < argc) {
+            carga.itensIniciais = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--calibrar") == 0 && i + 1 < argc) {
+            arquivoCalibrar = argv[++i];
+        } else if(strcmp(argv[i], "--calibrar-max") == 0 && i + 1 < argc) {
+            maximoCalibracao = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--calibracao") == 0 && i + 1 < argc) {
+            arquivoCalibracao = argv[++i];
+        } else if(strcmp(argv[i], "--metricas") == 0 && i + 1 < argc) {
+            arquivoMetricas = argv[++i];
+        } else if(strcmp(argv[i], "--metricas-amostragem") == 0 && i + 1 < argc) {
+            metricasConfigurar(atoi(argv[++i])); // 1 = toda operação, 0 = sem latência
+        } else if(strcmp(argv[i], "--perf") == 0) {
+            contadoresHardwareAtivos = 1;
+        } else if(strcmp(argv[i], "--simd") == 0 && i + 1 < argc) {
+            kernelSolicitado = argv[++i];
+        } else if(strcmp(argv[i], "--bench") == 0) {
+            modoBenchmark = 1;
+        } else if(strcmp(argv[i], "--bench-max") == 0 && i + 1 < argc) {
+            bench.tamanhoMaximo = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--bench-repeticoes") == 0 && i + 1 < argc) {
+            bench.repeticoes = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--bench-quadratico") == 0 && i + 1 < argc) {
+            bench.limiteQuadratico = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--bench-consultas") == 0 && i + 1 < argc) {
+            bench.consultas = atoi(argv[++i]);
+        } else if(strcmp(argv[i], "--bench-semente") == 0 && i + 1 < argc) {
+            bench.semente = strtoull(argv[++i], NULL, 10);
+        } else if(strcmp(argv[i], "--bench-json") == 0) {
+            bench.formato = SAIDA_JSON;
+        } else if(strcmp(argv[i], "--bench-saida") == 0 && i + 1 < argc) {
+            bench.arquivoSaida = argv[++i];
+        }
+    }
+
+    // ======= Kernel de comparação de nome/tipo: o melhor que a CPU suporta =======
+    selecionarMelhorKernelComparacao();
+    if(strcmp(kernelSolicitado, "auto") != 0) {
+        int k = 0;
+        while(k < TOTAL_KERNELS && strcasecmp(kernelSolicitado, nomeKernelComparacao((KernelComparacao)k)) != 0)
+            k++;
+        if(k == TOTAL_KERNELS || !selecionarKernelComparacao((KernelComparacao)k))
+            fprintf(stderr, "[AVISO] Kernel '%s' indisponivel; usando %s.\n", kernelSolicitado,
+                    nomeKernelComparacao(kernelComparacaoAtivo()));
+    }
+
+    if(arquivoMetricas != NULL)
+        metricasGravarAoSair(arquivoMetricas);
+
+    // ======= Calibração da ordenação automática (depois do kernel: ela mede o kernel ativo) =======
+    if(arquivoCalibrar != NULL)
+        return executarCalibracao(arquivoCalibrar, maximoCalibracao, bench.semente);
+    if(arquivoCalibracao != NULL && !calibracaoCarregar(arquivoCalibracao))
+        fprintf(stderr, "[AVISO] Ordenacao automatica vai medir esta maquina na primeira vez.\n");
+
+    // ======= Benchmark: dados sintéticos, sem menu =======
+    if(modoBenchmark)
+        return executarBenchmark(&bench);
+
+    // ======= Servidor local e gerador de carga =======
+    if(socketServidor != NULL)
+        return executarServidor(socketServidor, limite >= 0 ? limite : 0, arquivoInicial, &configDiario);
+    if(carga.caminho != NULL) {
+        if(carga.operacoes < 1 || carga.itensIniciais < 0 || carga.percentualEscritas < 0 ||
+           carga.percentualEscritas > 100) {
+            fprintf(stderr, "[ERRO] Parametros de carga invalidos.\n");
+            return 1;
+        }
+        return executarCarga(&carga);
+    }
+
+    // ======= Modo em lote: sem limite, salvo se --limite for informado =======
+    if(modoLote)
+        return executarLote(arquivoLote, limite >= 0 ? limite : 0, arquivoInicial, &configDiario);
+    if(limite < 0)
+        limite = CAPACIDADE_MOCHILA; // Regra do jogo no menu interativo
+
+    // ======= Inicialização de Variáveis =======
+    Mochila mochila;                 // Inventário dinâmico de componentes
+    Componente *componentes;         // Atalho para mochila.itens (pode mudar após realocação)
+    int opcao;                       // Opção do menu escolhida pelo jogador
+    char nomeBusca[MAX_STR_LEN];     // Buffer para nome a ser buscado
+    DiarioOperacoes diario;          // Diário de operações (só com --diario)
+
+    mochilaIniciar(&mochila, limite);
+    if(configDiario.base != NULL) {
+        // Recuperação antes de tudo: o --carregar seguinte vira um checkpoint do diário
+        if(!diarioAbrir(&diario, &mochila, configDiario.base, configDiario.grupo, configDiario.intervaloMs,
+                        configDiario.limiteBytes)) {
+            mochilaLiberar(&mochila);
+            return 1;
+        }
+        printf("\n[OK] Diario '%s' recuperado: %d componente(s), %lld operacao(oes) reaplicada(s) em %.3f ms.\n",
+               diario.caminhoDiario, mochila.quantidade, diario.registrosReaplicados, diario.tempoReplayNs / 1e6);
+    }
+    if(arquivoInicial != NULL && mochilaCarregar(&mochila, arquivoInicial))
+        printf("\n[OK] %d componente(s) carregado(s) de '%s'.\n", mochila.quantidade, arquivoInicial);
+
+    // ======= Loop Principal do Menu =======
+    do {
+        // Exibe cabeçalho com status atual
+        printf("\n========================================================\n");
+        printf("    PLANO DE FUGA - CODIGO DA ILHA (NIVEL MESTRE)\n");
+        printf("========================================================\n");
+        if(mochila.limite > 0)
+            printf("Itens na Mochila: %d/%d\n", mochila.quantidade, mochila.limite);
+        else
+            printf("Itens na Mochila: %d (sem limite)\n", mochila.quantidade);
+        printf("Status da Ordenacao por Nome: %s\n", mochila.ordenadaPorNome ? "ORDENADO" : "NAO ORDENADO");
+        printf("\n");
+
+        // Exibe opções disponíveis
+        printf("1. Adicionar Componente\n");
+        printf("2. Descartar Componente\n");
+        printf("3. Listar Componentes (Inventario)\n");
+        printf("4. Organizar Mochila (Ordenar Componentes)\n");
+        printf("5. Busca Binaria por Componente-Chave (por nome)\n");
+        printf("6. Buscar Componentes por Intervalo de Nomes\n");
+        printf("7. Salvar Inventario (snapshot binario)\n");
+        printf("8. Carregar Inventario (snapshot binario)\n");
+        printf("9. Importar Componentes (CSV / JSON Lines)\n");
+        printf("10. Exportar Componentes (CSV / JSON Lines)\n");
+        printf("11. Top-K Mais Urgentes (heap de prioridade)\n");
+        printf("12. Retirar Componente Mais Urgente\n");
+        printf("13. Listar Componentes por Tipo (indice secundario)\n");
+        printf("14. Buscar por Faixa de Prioridade (indice secundario)\n");
+        printf("15. Totais de Quantidade por Tipo\n");
+        printf("16. Busca em Lote por Nomes (passada unica)\n");
+        printf("17. Listar Pagina do Inventario (linha inicial e quantidade)\n");
+        printf("18. Diario de Operacoes (estatisticas e compactacao)\n");
+        printf("19. Metricas de Operacao (contadores e latencias)\n");
+        printf("20. Autocompletar / Busca Aproximada por Nome (arvore radix)\n");
+        printf("0. ATIVAR TORRE DE FUGA (Sair)\n");
+        printf("--------------------------------------------------------\n");
+        printf("\nEscolha uma opcao: ");
+        scanf("%d", &opcao);
+        while(getchar() != '\n')
+            ; // Limpa buffer de entrada
+
+        componentes = mochila.itens;
+
+        switch(opcao) {
+        // ============== CASO 1: ADICIONAR COMPONENTE ==============
+        case 1:
+            // Verifica limite de capacidade (padrão: 10 componentes)
+            if(mochila.limite > 0 && mochila.quantidade >= mochila.limite) {
+                printf("\n[ERRO] Mochila cheia! Capacidade maxima: %d componentes.\n", mochila.limite);
+            } else {
+                Componente novo; // Componente sendo coletado
+                printf("\n--- Coletando Novo Componente ---\n");
+
+                // Entrada 1: Nome do componente (max 30 caracteres)
+                printf("Nome: ");
+                fgets(novo.nome, 30, stdin);
+                novo.nome[strcspn(novo.nome, "\n")] = 0;
+
+                // Entrada 2: Tipo/Categoria do componente
+                printf("Tipo (Estrutural, Eletronico, Energia): ");
+                fgets(novo.tipo, 20, stdin);
+                novo.tipo[strcspn(novo.tipo, "\n")] = 0;
+
+                // Entrada 3: Quantidade de unidades (inteiro)
+                printf("Quantidade: ");
+                scanf("%d", &novo.quantidade);
+                while(getchar() != '\n')
+                    ;
+
+                // Entrada 4: Prioridade (1-10, onde 10 é máxima urgência)
+                printf("Prioridade de Montagem (1-10): ");
+                scanf("%d", &novo.prioridade);
+                while(getchar() != '\n')
+                    ;
+
+                // Insere no final e marca como não ordenado
+                if(!adicionarComponente(&mochila, &novo)) {
+                    printf("\n[ERRO] Memoria insuficiente para adicionar o componente.\n");
+                    break;
+                }
+                mochila.ordenadaPorNome = 0; // Novo componente desordeniza a lista
+                printf("\nComponente '%s' adicionado!\n", novo.nome);
+                mostrarCustoIndiceOrdenado(&mochila.ordemNome);
+                mostrarCustoIndiceSecundario(&mochila.porTipo);
+                mostrarCustoIndiceSecundario(&mochila.porPrioridade);
+
+                // Exibe tabela atualizada
+                mostrarComponentes(mochila.itens, mochila.quantidade);
+            }
+            break;
+
+        case 2: // Descartar Componente
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia. Nada para descartar.\n");
+            } else {
+                printf("\n--- Descartando Componente ---\n");
+                printf("Nome do componente a descartar: ");
+                fgets(nomeBusca, MAX_STR_LEN, stdin);
+                nomeBusca[strcspn(nomeBusca, "\n")] = 0;
+
+                // Localiza pelo índice hash e preenche o buraco com o último item (O(1))
+                if(!descartarComponente(&mochila, nomeBusca)) {
+                    printf("\n[ERRO] Componente '%s' nao encontrado na mochila.\n", nomeBusca);
+                } else {
+                    mochila.ordenadaPorNome = 0; // Marca como não ordenado
+                    printf("\n[SUCESSO] Componente descartado da mochila.\n");
+                    mostrarEstatisticasHash(&mochila.indiceNome);
+                    mostrarCustoIndiceOrdenado(&mochila.ordemNome);
+                    mostrarCustoIndiceSecundario(&mochila.porTipo);
+                    mostrarCustoIndiceSecundario(&mochila.porPrioridade);
+                }
+            }
+            break;
+
+        case 3: { // Listar Componentes (Inventário)
+            // Exibe tabela formatada com todos os componentes (até --listar-max) e o custo da escrita
+            EstatisticasListagem custo;
+            mostrarComponentesPagina(componentes, mochila.quantidade, 0, limiteListagem, &custo);
+            if(custo.linhas > 0)
+                mostrarCustoListagem(&custo);
+            mostrarUsoMemoria(&mochila);
+            break;
+        }
+
+        case 4: // Organizar Mochila (Ordenar)
+            // Submenu com 3 estratégias de ordenação diferentes
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia. Nada para organizar.\n");
+            } else {
+                printf("\n--- Estrategia de Organizacao ---\n");
+                printf("Como deseja ordenar os componentes?\n");
+                printf("1. Por Nome (Ordem Alfabetica)\n");
+                printf("2. Por Tipo\n");
+                printf("3. Por Prioridade de Montagem\n");
+                printf("4. Cancelar\n");
+                printf("5. Varias Chaves (ex: tipo asc, prioridade desc, nome asc)\n");
+                printf("Escolha o criterio: ");
+                int subOpcao = 0; // Entrada não numérica cai em "Opcao invalida!"
+                scanf("%d", &subOpcao);
+                while(getchar() != '\n')
+                    ;
+
+                // Segunda escolha: algoritmo (clássico O(n²), motor O(n log n) ou automático)
+                AlgoritmoOrdenacao algoritmo = ALGORITMO_CLASSICO;
+                int automatico = 0;
+                if(subOpcao >= 1 && subOpcao <= 3) {
+                    printf("\nQual algoritmo deseja usar?\n");
+                    printf("1. Classico (Bubble/Insertion/Selection) - O(n^2)\n");
+                    printf("2. IntroSort - O(n log n)\n");
+                    printf("3. Merge Sort (estavel) - O(n log n)\n");
+                    printf("4. Radix Sort (estavel) - O(n*w)\n");
+                    printf("5. Chaves extraidas (estavel) - O(n log n), move so pares de 16 bytes\n");
+                    printf("6. Merge Sort paralelo (estavel, %d threads) - O(n log n / p)\n", threadsTrabalho());
+                    printf("7. Contagem por dicionario de tipos (estavel) - O(n + k); nome/prioridade: Radix\n");
+                    printf("8. Adaptativo TimSort (estavel) - O(n) quase ordenado, O(n log n) no pior caso\n");
+                    printf("9. Automatico - amostra o inventario e usa o mais rapido medido nesta maquina\n");
+                    printf("Escolha o algoritmo: ");
+                    int escolhaAlgoritmo = 0;
+                    int lido = scanf("%d", &escolhaAlgoritmo) == 1;
+                    if(lido && escolhaAlgoritmo >= 1 && escolhaAlgoritmo <= TOTAL_ALGORITMOS)
+                        algoritmo = (AlgoritmoOrdenacao)(escolhaAlgoritmo - 1);
+                    else if(lido && escolhaAlgoritmo == TOTAL_ALGORITMOS + 1)
+                        automatico = 1;
+                    else
+                        subOpcao = 0; // Algoritmo inválido: não ordena (cai em "Opcao invalida!")
+                    while(getchar() != '\n')
+                        ;
+                }
+
+                switch(subOpcao) {
+                // -------- Subopcão 1: Ordenação por Nome (padrão: Bubble Sort) --------
+                case 1:
+                    printf("\n[PROCESSANDO] Organizando mochila por NOME...\n");
+                    // Usa medirTempo para executar e medir o algoritmo escolhido
+                    if(automatico)
+                        ordenarAutomatico(componentes, mochila.quantidade, CRITERIO_NOME);
+                    else
+                        medirTempo(funcaoOrdenacao(algoritmo, CRITERIO_NOME), componentes, mochila.quantidade,
+                                   descricaoOrdenacao(algoritmo, CRITERIO_NOME));
+                    mochila.ordenadaPorNome = 1; // IMPORTANTE: Marca como ordenado (necessário para busca binária)
+                    mochilaReindexar(&mochila);  // Posições mudaram: atualiza o índice hash
+                    mostrarComponentes(componentes, mochila.quantidade);
+                    break;
+
+                // -------- Subopcão 2: Ordenação por Tipo (padrão: Insertion Sort) --------
+                case 2:
+                    printf("\n[PROCESSANDO] Organizando mochila por TIPO...\n");
+                    if(algoritmo == ALGORITMO_CONTAGEM) {
+                        // Ids de tipo já calculados na inserção: só contagem e distribuição
+                        Medicao med;
+                        printf("\n=== INICIANDO: %s ===\n", descricaoOrdenacao(algoritmo, CRITERIO_TIPO));
+                        medicaoIniciar(&med);
+                        mochilaOrdenarPorTipo(&mochila);
+                        medicaoFinalizar(&med);
+                        mostrarMedicao(&med);
+                        printf("=================================\n");
+                    } else {
+                        if(automatico)
+                            ordenarAutomatico(componentes, mochila.quantidade, CRITERIO_TIPO);
+                        else
+                            medirTempo(funcaoOrdenacao(algoritmo, CRITERIO_TIPO), componentes, mochila.quantidade,
+                                       descricaoOrdenacao(algoritmo, CRITERIO_TIPO));
+                        mochila.ordenadaPorNome = 0; // Não está ordenado por nome (busca binária não é válida)
+                        mochilaReindexar(&mochila);
+                    }
+                    mostrarComponentes(componentes, mochila.quantidade);
+                    break;
+
+                // -------- Subopcão 3: Ordenação por Prioridade (padrão: Selection Sort) --------
+                case 3:
+                    printf("\n[PROCESSANDO] Organizando mochila por PRIORIDADE...\n");
+                    if(automatico)
+                        ordenarAutomatico(componentes, mochila.quantidade, CRITERIO_PRIORIDADE);
+                    else
+                        medirTempo(funcaoOrdenacao(algoritmo, CRITERIO_PRIORIDADE), componentes, mochila.quantidade,
+                                   descricaoOrdenacao(algoritmo, CRITERIO_PRIORIDADE));
+                    mochila.ordenadaPorNome = 0; // Não está ordenado por nome (busca binária não é válida)
+                    mochilaReindexar(&mochila);
+                    mostrarComponentes(componentes, mochila.quantidade);
+                    break;
+
+                // -------- Subopcão 4: Cancelar operação --------
+                case 4:
+                    printf("\nOperacao cancelada.\n");
+                    break;
+
+                // -------- Subopcão 5: Várias chaves numa passada (TimSort estável) --------
+                case 5: {
+                    char textoEspec[MAX_LINHA_LOTE];
+                    EspecificacaoOrdenacao espec;
+                    printf("Chaves (campo [asc|desc], separadas por virgula): ");
+                    fgets(textoEspec, sizeof(textoEspec), stdin);
+                    textoEspec[strcspn(textoEspec, "\n")] = 0;
+                    if(!especificacaoPorTexto(textoEspec, &espec)) {
+                        printf("\n[ERRO] Especificacao invalida. Campos: nome, tipo, prioridade (sem repetir).\n");
+                        break;
+                    }
+                    Medicao med;
+                    printf("\n[PROCESSANDO] Organizando mochila por VARIAS CHAVES...\n");
+                    medicaoIniciar(&med);
+                    ordenarPorEspecificacao(componentes, mochila.quantidade, &espec);
+                    medicaoFinalizar(&med);
+                    mostrarMedicao(&med);
+                    // Busca binária continua válida se a primeira chave for nome crescente
+                    mochila.ordenadaPorNome = espec.chaves[0].campo == CRITERIO_NOME && !espec.chaves[0].decrescente;
+                    mochilaReindexar(&mochila);
+                    mostrarComponentes(componentes, mochila.quantidade);
+                    break;
+                }
+
+                default:
+                    printf("Opcao invalida!\n");
+                }
+            }
+            break;
+
+        // ============== CASO 5: BUSCA BINÁRIA ==============
+        case 5:
+            // Ordenada por nome: busca binária no vetor. Caso contrário: no índice ordenado
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia. Nada para buscar.\n");
+            } else {
+                // Entrada: Nome do componente a buscar
+                printf("\n--- Busca Binaria por Componente-Chave ---\n");
+                printf("Nome do componente a buscar: ");
+                fgets(nomeBusca, MAX_STR_LEN, stdin);
+                nomeBusca[strcspn(nomeBusca, "\n")] = 0;
+
+                // Executa busca binária O(log n) - retorna índice ou -1
+                // O índice ordenado dispensa reordenar a mochila após inserções/descartes
+                int pos = mochila.ordenadaPorNome ? buscaBinariaPorNome(componentes, mochila.quantidade, nomeBusca)
+                                                  : mochilaBuscaBinariaIndexada(&mochila, nomeBusca);
+
+                if(pos == -1) {
+                    // Componente não encontrado: sugere nomes próximos (distância de edição <= 2)
+                    long long comparacoes = comparacoesVetor;
+                    int totalSugestoes = 0;
+                    SugestaoNome *sugestoes = mochilaBuscarAproximado(&mochila, nomeBusca, DISTANCIA_APROXIMADA_MAXIMA, 5,
+                                                                      &totalSugestoes);
+                    printf("\n[FALHA] Componente-chave '%s' nao encontrado na mochila.\n", nomeBusca);
+                    if(totalSugestoes > 0) {
+                        printf("Voce quis dizer:");
+                        for(int i = 0; i < totalSugestoes; i++)
+                            printf("%s '%s'", i ? "," : "", componentes[sugestoes[i].posicao].nome);
+                        printf("?\n");
+                    }
+                    free(sugestoes);
+                    comparacoesVetor = comparacoes;
+                } else {
+                    // Componente encontrado - exibe dados
+                    printf("\n--- Componente-Chave Encontrado! ---\n");
+                    printf("Nome: %s, Tipo: %s, Qtd: %d, Prio: %d\n",
+                           componentes[pos].nome, componentes[pos].tipo,
+                           componentes[pos].quantidade, componentes[pos].prioridade);
+                }
+                // Telemetria: exibe número de comparações realizadas
+                printf("-> Comparacoes realizadas: %lld (Complexidade O(log n)%s)\n", comparacoesVetor,
+                       mochila.ordenadaPorNome ? "" : ", indice ordenado");
+            }
+            break;
+
+        // ============== CASO 6: BUSCA POR INTERVALO ==============
+        case 6:
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia. Nada para buscar.\n");
+            } else {
+                char nomeFim[MAX_STR_LEN];
+                printf("\n--- Busca por Intervalo de Nomes ---\n");
+                printf("Nome inicial (inclusivo): ");
+                fgets(nomeBusca, MAX_STR_LEN, stdin);
+                nomeBusca[strcspn(nomeBusca, "\n")] = 0;
+                printf("Nome final (inclusivo): ");
+                fgets(nomeFim, MAX_STR_LEN, stdin);
+                nomeFim[strcspn(nomeFim, "\n")] = 0;
+
+                // O(log n + k): localiza o início pelo índice ordenado e percorre em ordem
+                int total = 0;
+                int *posicoes = mochilaBuscarIntervalo(&mochila, nomeBusca, nomeFim, &total);
+                printf("\n%d componente(s) entre '%s' e '%s':\n", total, nomeBusca, nomeFim);
+                for(int i = 0; i < total; i++) {
+                    Componente *c = &componentes[posicoes[i]];
+                    printf("Nome: %s, Tipo: %s, Qtd: %d, Prio: %d\n", c->nome, c->tipo, c->quantidade, c->prioridade);
+                }
+                printf("-> Comparacoes realizadas: %lld (Complexidade O(log n + k))\n", comparacoesVetor);
+                free(posicoes);
+            }
+            break;
+
+        // ============== CASOS 7 e 8: SNAPSHOT BINÁRIO ==============
+        case 7:
+        case 8: {
+            char arquivo[256];
+            printf("\nArquivo do snapshot: ");
+            fgets(arquivo, sizeof(arquivo), stdin);
+            arquivo[strcspn(arquivo, "\n")] = 0;
+
+            Medicao med;
+            medicaoIniciar(&med);
+            int ok = opcao == 7 ? mochilaSalvar(&mochila, arquivo) : mochilaCarregar(&mochila, arquivo);
+            medicaoFinalizar(&med);
+            if(ok) {
+                printf("\n[OK] %d componente(s) %s '%s'.\n", mochila.quantidade,
+                       opcao == 7 ? "salvo(s) em" : "carregado(s) de", arquivo);
+                mostrarMedicao(&med);
+            } else {
+                printf("\n[FALHA] Snapshot '%s' nao foi %s.\n", arquivo, opcao == 7 ? "gravado" : "carregado");
+            }
+            break;
+        }
+
+        // ============== CASOS 9 e 10: IMPORTAÇÃO / EXPORTAÇÃO ==============
+        case 9:
+        case 10: {
+            char arquivo[256];
+            printf("\nArquivo (.csv ou .jsonl): ");
+            fgets(arquivo, sizeof(arquivo), stdin);
+            arquivo[strcspn(arquivo, "\n")] = 0;
+
+            EstatisticasTransferencia est;
+            FormatoArquivo formato = formatoPorCaminho(arquivo);
+            if(opcao == 9) {
+                if(mochilaImportar(&mochila, arquivo, formato, &est)) {
+                    if(est.registros > 0)
+                        mochila.ordenadaPorNome = 0; // Novos componentes desordenam a lista
+                    mostrarEstatisticasTransferencia("Importacao", &est);
+                }
+            } else if(mochilaExportar(&mochila, arquivo, formato, &est)) {
+                mostrarEstatisticasTransferencia("Exportacao", &est);
+            }
+            break;
+        }
+
+        // ============== CASO 11: TOP-K POR PRIORIDADE ==============
+        case 11:
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia.\n");
+            } else {
+                int k = 0;
+                printf("\nQuantos componentes (K)? ");
+                if(scanf("%d", &k) != 1)
+                    k = 0;
+                while(getchar() != '\n')
+                    ;
+                // O(K log K) sobre o heap mantido a cada inserção/descarte: a mochila não é reordenada
+                int total = 0;
+                int *posicoes = mochilaTopK(&mochila, k, &total);
+                printf("\n--- %d Componente(s) Mais Urgente(s) ---\n", total);
+                for(int i = 0; i < total; i++) {
+                    Componente *c = &componentes[posicoes[i]];
+                    printf("%d. Nome: %s, Tipo: %s, Qtd: %d, Prio: %d\n", i + 1, c->nome, c->tipo, c->quantidade,
+                           c->prioridade);
+                }
+                printf("-> Comparacoes realizadas: %lld (Complexidade O(K log K), sem ordenar a mochila)\n",
+                       comparacoesVetor);
+                free(posicoes);
+            }
+            break;
+
+        // ============== CASO 12: RETIRAR O MAIS URGENTE ==============
+        case 12: {
+            Componente retirado;
+            if(mochilaRetirarMaisUrgente(&mochila, &retirado)) {
+                mochila.ordenadaPorNome = 0; // O último item ocupa a posição liberada
+                printf("\n[OK] Retirado: %s (Tipo: %s, Qtd: %d, Prio: %d)\n", retirado.nome, retirado.tipo,
+                       retirado.quantidade, retirado.prioridade);
+            } else {
+                printf("\n[AVISO] Mochila vazia.\n");
+            }
+            break;
+        }
+
+        // ============== CASO 13: COMPONENTES DE UM TIPO ==============
+        case 13:
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia. Nada para buscar.\n");
+            } else {
+                char tipoBusca[MAX_STR_LEN];
+                printf("\nTipo: ");
+                fgets(tipoBusca, MAX_STR_LEN, stdin);
+                tipoBusca[strcspn(tipoBusca, "\n")] = 0;
+
+                // O(log g): o grupo do tipo já contém as posições e o total de quantidade
+                int total = 0;
+                long long somaQuantidade = 0;
+                const int *posicoes = mochilaBuscarPorTipo(&mochila, tipoBusca, &total, &somaQuantidade);
+                printf("\n%d componente(s) do tipo '%s' (quantidade total: %lld):\n", total, tipoBusca, somaQuantidade);
+                for(int i = 0; i < total; i++) {
+                    Componente *c = &componentes[posicoes[i]];
+                    printf("Nome: %s, Qtd: %d, Prio: %d\n", c->nome, c->quantidade, c->prioridade);
+                }
+                printf("-> Comparacoes realizadas: %lld (Complexidade O(log g + k), sem insertionSortTipo)\n",
+                       comparacoesVetor);
+            }
+            break;
+
+        // ============== CASO 14: FAIXA DE PRIORIDADE ==============
+        case 14:
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia. Nada para buscar.\n");
+            } else {
+                int minimo = 0, maximo = 0;
+                printf("\nPrioridade minima e maxima (ex.: 7 10): ");
+                if(scanf("%d %d", &minimo, &maximo) != 2)
+                    minimo = 1, maximo = 0; // Faixa vazia
+                while(getchar() != '\n')
+                    ;
+
+                int total = 0;
+                int *posicoes = mochilaBuscarFaixaPrioridade(&mochila, minimo, maximo, &total);
+                printf("\n%d componente(s) com prioridade entre %d e %d:\n", total, minimo, maximo);
+                for(int i = 0; i < total; i++) {
+                    Componente *c = &componentes[posicoes[i]];
+                    printf("Nome: %s, Tipo: %s, Qtd: %d, Prio: %d\n", c->nome, c->tipo, c->quantidade, c->prioridade);
+                }
+                printf("-> Comparacoes realizadas: %lld (Complexidade O(log g + k))\n", comparacoesVetor);
+                free(posicoes);
+            }
+            break;
+
+        // ============== CASO 15: TOTAIS POR TIPO ==============
+        case 15:
+            mostrarTotaisPorTipo(&mochila);
+            break;
+
+        // ============== CASO 16: BUSCA EM LOTE ==============
+        case 16:
+            if(!mochila.ordenadaPorNome) {
+                printf("\n[ALERTA] A busca em lote requer ordenacao por NOME.\n");
+                printf("Use a opcao 4 para ordenar primeiro!\n");
+            } else {
+                char linhaNomes[MAX_LINHA_LOTE];
+                char(*nomes)[MAX_STR_LEN] = malloc(sizeof(char[MAX_LINHA_LOTE / 2][MAX_STR_LEN]));
+                int *resultados = malloc(sizeof(int[MAX_LINHA_LOTE / 2]));
+                int total = 0;
+                printf("\nNomes separados por ';': ");
+                fgets(linhaNomes, sizeof(linhaNomes), stdin);
+                linhaNomes[strcspn(linhaNomes, "\n")] = 0;
+                for(char *campo = linhaNomes; nomes != NULL && total < MAX_LINHA_LOTE / 2;) {
+                    size_t tamanho = strcspn(campo, ";");
+                    if(tamanho > 0) {
+                        snprintf(nomes[total], MAX_STR_LEN, "%.*s", (int)tamanho, campo);
+                        total++;
+                    }
+                    if(campo[tamanho] == '\0')
+                        break;
+                    campo += tamanho + 1;
+                }
+                if(total == 0 || resultados == NULL) {
+                    printf("\n[AVISO] Nenhum nome informado.\n");
+                    free(nomes);
+                    free(resultados);
+                    break;
+                }
+
+                // Uma passada pelo vetor x uma busca binária por nome
+                Medicao emLote, individual;
+                medicaoIniciar(&emLote);
+                int encontrados = buscaEmLotePorNome(componentes, mochila.quantidade, nomes, total, resultados);
+                medicaoFinalizar(&emLote);
+                long long comparacoesLote = comparacoesVetor;
+                long long comparacoesIndividuais = 0;
+                medicaoIniciar(&individual);
+                for(int q = 0; q < total; q++) {
+                    buscaBinariaPorNome(componentes, mochila.quantidade, nomes[q]);
+                    comparacoesIndividuais += comparacoesVetor;
+                }
+                medicaoFinalizar(&individual);
+
+                printf("\n--- Busca em Lote (%d nomes, %d encontrados) ---\n", total, encontrados);
+                for(int q = 0; q < total; q++) {
+                    if(resultados[q] == -1)
+                        printf("%s: nao encontrado\n", nomes[q]);
+                    else
+                        printf("%s: posicao %d (Tipo: %s, Qtd: %d, Prio: %d)\n", nomes[q], resultados[q],
+                               componentes[resultados[q]].tipo, componentes[resultados[q]].quantidade,
+                               componentes[resultados[q]].prioridade);
+                }
+                printf("-> Em lote: %lld comparacoes, %.3f us | buscaBinariaPorNome em laco: %lld comparacoes, %.3f us\n",
+                       comparacoesLote, emLote.tempoParedeNs / 1e3, comparacoesIndividuais,
+                       individual.tempoParedeNs / 1e3);
+                free(nomes);
+                free(resultados);
+            }
+            break;
+
+        // ============== CASO 17: PÁGINA DO INVENTÁRIO ==============
+        case 17:
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia.\n");
+            } else {
+                int inicio = 1, quantidade = 0;
+                printf("\nLinha inicial (1 = primeira) e quantidade (0 = ate o fim): ");
+                if(scanf("%d %d", &inicio, &quantidade) != 2)
+                    inicio = 1, quantidade = 0;
+                while(getchar() != '\n')
+                    ;
+                EstatisticasListagem custo;
+                mostrarComponentesPagina(componentes, mochila.quantidade, inicio - 1, quantidade, &custo);
+                mostrarCustoListagem(&custo);
+            }
+            break;
+
+        // ============== CASO 18: DIÁRIO DE OPERAÇÕES ==============
+        case 18:
+            if(mochila.diario == NULL) {
+                printf("\n[AVISO] Diario desativado (inicie com --diario base).\n");
+            } else {
+                char resposta[16];
+                printf("\n--- Diario de Operacoes ---\n");
+                mostrarEstatisticasDiario(mochila.diario);
+                printf("Compactar agora (snapshot + diario reescrito)? (s/n): ");
+                if(fgets(resposta, sizeof(resposta), stdin) != NULL && (resposta[0] == 's' || resposta[0] == 'S')) {
+                    if(diarioCompactar(mochila.diario, &mochila, 1)) {
+                        printf("\n[OK] Diario compactado.\n");
+                        mostrarEstatisticasDiario(mochila.diario);
+                    } else {
+                        printf("\n[FALHA] Compactacao nao concluida.\n");
+                    }
+                }
+            }
+            break;
+
+        // ============== CASO 19: MÉTRICAS DE OPERAÇÃO ==============
+        case 19: {
+            char arquivo[MAX_STR_LEN * 4];
+            printf("\n--- Metricas de Operacao ---\n");
+            mostrarMetricas();
+            printf("\nExportar para arquivo (.prom = Prometheus, .json = JSON; ENTER = nao): ");
+            if(fgets(arquivo, sizeof(arquivo), stdin) != NULL) {
+                arquivo[strcspn(arquivo, "\r\n")] = '\0';
+                if(arquivo[0] != '\0' && metricasGravar(arquivo))
+                    printf("\n[OK] Metricas gravadas em '%s'.\n", arquivo);
+            }
+            break;
+        }
+
+        // ============== CASO 20: AUTOCOMPLETAR / BUSCA APROXIMADA ==============
+        case 20:
+            if(mochila.quantidade == 0) {
+                printf("\n[AVISO] Mochila vazia. Nada para buscar.\n");
+            } else {
+                char entrada[MAX_STR_LEN];
+                printf("\n--- Autocompletar / Busca Aproximada ---\n");
+                printf("Prefixo ou nome aproximado: ");
+                fgets(nomeBusca, MAX_STR_LEN, stdin);
+                nomeBusca[strcspn(nomeBusca, "\n")] = 0;
+                printf("Distancia maxima de edicao (0 = apenas prefixo, ate %d): ", DISTANCIA_APROXIMADA_MAXIMA);
+                fgets(entrada, sizeof(entrada), stdin);
+                int distancia = atoi(entrada);
+
+                // O(comprimento do prefixo + k): a subárvore do prefixo já está em ordem alfabética
+                int total = 0, correspondencias = 0;
+                int *posicoes = mochilaBuscarPorPrefixo(&mochila, nomeBusca, 10, &total, &correspondencias);
+                printf("\n%d componente(s) comecam com '%s'%s\n", correspondencias, nomeBusca,
+                       correspondencias > total ? " (exibindo os 10 primeiros):" : ":");
+                for(int i = 0; i < total; i++) {
+                    Componente *c = &componentes[posicoes[i]];
+                    printf("Nome: %s, Tipo: %s, Qtd: %d, Prio: %d\n", c->nome, c->tipo, c->quantidade, c->prioridade);
+                }
+                printf("-> Nos visitados: %lld\n", comparacoesVetor);
+                free(posicoes);
+
+                if(distancia > 0) {
+                    // Percorre só os ramos cuja linha de edição ainda cabe na distância
+                    SugestaoNome *sugestoes = mochilaBuscarAproximado(&mochila, nomeBusca, distancia, 10, &total);
+                    printf("\n%d nome(s) a distancia <= %d de '%s':\n", total,
+                           distancia > DISTANCIA_APROXIMADA_MAXIMA ? DISTANCIA_APROXIMADA_MAXIMA : distancia, nomeBusca);
+                    for(int i = 0; i < total; i++)
+                        printf("[%d] %s\n", sugestoes[i].distancia, componentes[sugestoes[i].posicao].nome);
+                    printf("-> Nos visitados: %lld\n", comparacoesVetor);
+                    free(sugestoes);
+                }
+            }
+            break;
+
+        // ============== CASO 0: ENCERRAR PROGRAMA ==============
+        case 0:
+            printf("\n");
+            printf("========================================================\n");
+            printf("  TORRE DE FUGA ATIVADA! Preparando para evacuacao...\n");
+            printf("========================================================\n");
+            printf("Sistema encerrado com sucesso.\n");
+            break;
+
+        // ============== CASO PADRÃO: OPÇÃO INVÁLIDA ==============
+        default:
+            printf("\n[ERRO] Opcao invalida! Escolha entre 0-20.\n");
+        }
+
+        // Pausa para leitura do resultado (exceto ao sair)
+        if(opcao != 0) {
+            printf("\nPressione ENTER para continuar...");
+            getchar();
+        }
+    } while(opcao != 0);
+
+    if(mochila.diario != NULL)
+        diarioFechar(&diario, &mochila); // Grava as operações ainda na fila
+    mochilaLiberar(&mochila);
+    return 0;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DAS FUNÇÕES OBRIGATÓRIAS - DESAFIO MESTRE
+// ============================================================================
+
+/** @brief Separador das linhas da tabela de componentes */
+static const char SEPARADOR_TABELA[] = "-------------------------------------------------------------------\n";
+
+/**
+ * @brief Copia um texto e completa com espaços até a largura (equivale a %-Ns)
+ * @return Posição seguinte ao campo
+ */
+static char *escreverCampoTexto(char *destino, const char *texto, size_t limite, size_t largura) {
+    size_t tamanho = strnlen(texto, limite);
+    memcpy(destino, texto, tamanho);
+    if(tamanho < largura) {
+        memset(destino + tamanho, ' ', largura - tamanho);
+        tamanho = largura;
+    }
+    return destino + tamanho;
+}
+
+/**
+ * @brief Escreve um inteiro em decimal e completa com espaços até a largura (equivale a %-Nd)
+ * @return Posição seguinte ao campo
+ */
+static char *escreverCampoInteiro(char *destino, int valor, int largura) {
+    char digitos[12];
+    int total = 0;
+    unsigned magnitude = valor < 0 ? 0u - (unsigned)valor : (unsigned)valor; // Sem overflow em INT_MIN
+    do {
+        digitos[total++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while(magnitude > 0);
+
+    char *p = destino;
+    if(valor < 0)
+        *p++ = '-';
+    while(total > 0)
+        *p++ = digitos[--total];
+    while(p - destino < largura)
+        *p++ = ' ';
+    return p;
+}
+
+/**
+ * @brief Grava um bloco inteiro no descritor do arquivo (repete em escritas parciais)
+ * @details Sem descritor (ex: fmemopen), recorre a fwrite
+ */
+static void despejarBufferListagem(FILE *saida, const char *buffer, size_t tamanho, EstatisticasListagem *est) {
+    int fd = fileno(saida);
+    est->bytes += (long long)tamanho;
+    if(fd < 0) {
+        fwrite(buffer, 1, tamanho, saida);
+        est->escritas++;
+        return;
+    }
+    while(tamanho > 0) {
+        ssize_t escrito = write(fd, buffer, tamanho);
+        est->escritas++;
+        if(escrito <= 0)
+            return; // Destino fechado (ex: pipe encerrado): descarta o restante
+        buffer += escrito;
+        tamanho -= (size_t)escrito;
+    }
+}
+
+void escreverComponentes(FILE *saida, const Componente arr[], int tamanho, int inicio, int quantidade,
+                         EstatisticasListagem *est) {
+    char buffer[TAM_BUFFER_LISTAGEM]; // Na pilha: threads do servidor listam ao mesmo tempo
+    EstatisticasListagem local = {0, 0, 0, 0};
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    if(inicio < 0)
+        inicio = 0;
+    if(inicio > tamanho)
+        inicio = tamanho;
+    int fim = quantidade > 0 && quantidade < tamanho - inicio ? inicio + quantidade : tamanho;
+
+    // Cabeçalho pelo stdio; o buffer do FILE é esvaziado antes dos write() diretos
+    fprintf(saida, "\n--- INVENTARIO ATUAL (%d componentes) ---\n", tamanho);
+    if(inicio > 0 || fim < tamanho)
+        fprintf(saida, "Exibindo linhas %d a %d\n", inicio + 1, fim);
+    fputs(SEPARADOR_TABELA, saida);
+    fprintf(saida, "%-20s | %-15s | %-11s | %-10s\n", "NOME", "TIPO", "QUANTIDADE", "PRIORIDADE");
+    fputs(SEPARADOR_TABELA, saida);
+    fflush(saida);
+
+    // Linha mais longa: 29 + 3 + 19 + 3 + 11 + 3 + 11 + 1 = 80 bytes, abaixo da folga de 128
+    size_t usado = 0;
+    for(int i = inicio; i < fim; i++) {
+        if(usado > sizeof(buffer) - 128) {
+            despejarBufferListagem(saida, buffer, usado, &local);
+            usado = 0;
+        }
+        const Componente *c = &arr[i];
+        char *p = buffer + usado;
+        p = escreverCampoTexto(p, c->nome, sizeof(c->nome), 20);
+        memcpy(p, " | ", 3);
+        p = escreverCampoTexto(p + 3, c->tipo, sizeof(c->tipo), 15);
+        memcpy(p, " | ", 3);
+        p = escreverCampoInteiro(p + 3, c->quantidade, 11);
+        memcpy(p, " | ", 3);
+        p = escreverCampoInteiro(p + 3, c->prioridade, 10);
+        *p++ = '\n';
+        usado = (size_t)(p - buffer);
+    }
+    if(usado > sizeof(buffer) - 160) { // Rodapé: separador + aviso de linhas restantes
+        despejarBufferListagem(saida, buffer, usado, &local);
+        usado = 0;
+    }
+    memcpy(buffer + usado, SEPARADOR_TABELA, sizeof(SEPARADOR_TABELA) - 1);
+    usado += sizeof(SEPARADOR_TABELA) - 1;
+    if(fim < tamanho)
+        usado += (size_t)snprintf(buffer + usado, sizeof(buffer) - usado, "(+%d componente(s) apos a linha %d)\n",
+                                  tamanho - fim, fim);
+    despejarBufferListagem(saida, buffer, usado, &local);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    local.linhas = fim - inicio;
+    local.tempoNs = (t1.tv_sec - t0.tv_sec) * 1000000000LL + (t1.tv_nsec - t0.tv_nsec);
+    if(est != NULL)
+        *est = local;
+}
+
+void mostrarComponentesPagina(const Componente arr[], int tamanho, int inicio, int quantidade, EstatisticasListagem *est) {
+    // Validação: se a mochila está vazia
+    if(tamanho == 0) {
+        printf("\n[RELATORIO] Nenhum componente cadastrado.\n");
+        if(est != NULL)
+            *est = (EstatisticasListagem){0, 0, 0, 0};
+        return;
+    }
+    escreverComponentes(stdout, arr, tamanho, inicio, quantidade, est);
+}
+
+/**
+ * @brief Exibe tabela formatada com todos os componentes da mochila
+ * @param arr Array de componentes a exibir
+ * @param tamanho Número de elementos a mostrar
+ *
+ * Formato da Tabela:
+ * | NOME | TIPO | QUANTIDADE | PRIORIDADE |
+ * Colunas com largura fixa para melhor legibilidade
+ * Inclui separadores visuais (linhas de traço)
+ */
+void mostrarComponentes(Componente arr[], int tamanho) {
+    mostrarComponentesPagina(arr, tamanho, 0, limiteListagem, NULL);
+}
+
+void mostrarCustoListagem(const EstatisticasListagem *est) {
+    printf("-> Listagem: %lld linha(s), %.1f KB em %lld chamada(s) write | %.3f ms | %.0f linhas/s\n", est->linhas,
+           est->bytes / 1024.0, est->escritas, est->tempoNs / 1e6,
+           est->tempoNs > 0 ? est->linhas * 1e9 / est->tempoNs : 0.0);
+}
+
+/**
+ * @brief Bubble Sort - Ordena componentes alfabeticamente por nome
+ * @param arr Array de componentes a ordenar (MODIFICADO in-place)
+ * @param tamanho Número de elementos
+ *
+ * Algoritmo:
+ * - Compara elementos adjacentes
+ * - Toca se forem maiores (ordem alfabética)
+ * - Repete até que nenhuma troca seja necessária
+ * - Após ordenação: elemento maior "flutua" para o final
+ *
+ * Complexidade:
+ * - Melhor caso: O(n) - array já ordenado (com otimização)
+ * - Pior caso: O(n²) - array em ordem reversa
+ * - Comparações: sempre ~n(n-1)/2
+ *
+ * Necessário para: Busca Binária (requer array ordenado)
+ */
+void bubbleSortNome(Componente arr[], int tamanho) {
+    if(tamanho == 0)
+        return;
+
+    Componente temp;
+    long long trocas = 0;
+    long long inicio = metricasInicio(METRICA_ORDENACAO);
+    comparacoesVetor = 0;
+
+    // Loop externo: n-1 iterações
+    for(int i = 0; i < tamanho - 1; i++) {
+        // Loop interno: compara elementos adjacentes (reduz a cada iteração)
+        for(int j = 0; j < tamanho - i - 1; j++) {
+            comparacoesVetor++;
+            // Comparação alfabética: strcmp retorna > 0 se arr[j] > arr[j+1]
+            if(compararNomeFixo(arr[j].nome, arr[j + 1].nome) > 0) {
+                // Troca: arr[j] <-> arr[j+1]
+                temp = arr[j];
+                arr[j] = arr[j + 1];
+                arr[j + 1] = temp;
+                trocas++;
+            }
+        }
+    }
+    trocasVetor = trocas;
+    bytesMovidosVetor = 3LL * trocas * (long long)sizeof(Componente);
+    metricasRegistrarOrdenacao(ALGORITMO_CLASSICO, inicio);
+    if(modoSilencioso)
+        return;
+    printf("\n[BUBBLE SORT] Ordenacao por NOME concluida.\n");
+    printf("-> Comparacoes: %lld | Trocas: %lld\n", comparacoesVetor, trocas);
+}
+
+/**
+ * @brief Insertion Sort - Ordena componentes alfabeticamente por tipo
+ * @param arr Array de componentes a ordenar (MODIFICADO in-place)
+ * @param tamanho Número de elementos
+ *
+ * Algoritmo:
+ * - Considera primeiro elemento já "ordenado"
+ * - Para cada elemento subsequente, insere na posição correta
+ * - Desloca elementos maiores para a direita
+ *
+ * Complexidade:
+ * - Melhor caso: O(n) - array já ordenado
+ * - Pior caso: O(n²) - array em ordem reversa
+ * - Comparações: ~n(n-1)/4 em média
+ *
+ * Vantagem: Eficiente para dados parcialmente ordenados
+ */
+void insertionSortTipo(Componente arr[], int tamanho) {
+    if(tamanho == 0)
+        return;
+
+    Componente chave;      // Elemento sendo inserido
+    long long deslocamentos = 0; // Contador de elementos movidos
+    long long inicio = metricasInicio(METRICA_ORDENACAO);
+    comparacoesVetor = 0;
+
+    // Começa do segundo elemento (índice 1)
+    for(int i = 1; i < tamanho; i++) {
+        chave = arr[i]; // Elemento a inserir
+        int j = i - 1;  // Índice para verificar elementos anteriores
+
+        // Move elementos maiores para a direita
+        while(j >= 0) {
+            comparacoesVetor++;
+            // Comparação alfabética por tipo (strcmp)
+            if(compararTipoFixo(arr[j].tipo, chave.tipo) > 0) {
+                arr[j + 1] = arr[j]; // Desloca para direita
+                j--;
+                deslocamentos++;
+            } else {
+                break; // Encontrou posição correta
+            }
+        }
+        arr[j + 1] = chave; // Insere elemento na posição correta
+    }
+    trocasVetor = deslocamentos;
+    // Cada deslocamento copia um registro; cada inserção salva e grava a chave
+    bytesMovidosVetor = (deslocamentos + 2LL * (tamanho - 1)) * (long long)sizeof(Componente);
+    metricasRegistrarOrdenacao(ALGORITMO_CLASSICO, inicio);
+    if(modoSilencioso)
+        return;
+    printf("\n[INSERTION SORT] Ordenacao por TIPO concluida.\n");
+    printf("-> Comparacoes: %lld | Deslocamentos: %lld\n", comparacoesVetor, deslocamentos);
+}
+
+/**
+ * @brief Selection Sort - Ordena componentes por prioridade (decrescente)
+ * @param arr Array de componentes a ordenar (MODIFICADO in-place)
+ * @param tamanho Número de elementos
+ *
+ * Algoritmo:
+ * - Encontra o elemento máximo na porção não-ordenada
+ * - Coloca na posição correta
+ * - Repete para a porção restante (reduz a cada iteração)
+ *
+ * Complexidade:
+ * - Todas as variações: O(n²)
+ * - Comparações: sempre n(n-1)/2
+ * - Trocas: no máximo n-1
+ *
+ * Características:
+ * - Não é "estável" (pode mudar ordem relativa de iguais)
+ * - Simples de implementar
+ * - Bom para dados pequenos ou análise educacional
+ *
+ * Nota: Ordena em ORDEM DECRESCENTE (maior prioridade primeiro)
+ */
+void selectionSortPrioridade(Componente arr[], int tamanho) {
+    if(tamanho == 0)
+        return;
+
+    int minIdx; // Índice do elemento máximo na porção não-ordenada
+    Componente temp;
+    long long trocas = 0;
+    long long inicio = metricasInicio(METRICA_ORDENACAO);
+    comparacoesVetor = 0;
+
+    // Percorre array selecionando máximo em cada iteração
+    for(int i = 0; i < tamanho - 1; i++) {
+        minIdx = i; // Assume primeiro da porção não-ordenada como máximo
+
+        // Busca o máximo na porção não-ordenada
+        for(int j = i + 1; j < tamanho; j++) {
+            comparacoesVetor++;
+            // Busca prioridade MAIOR (ordem DECRESCENTE)
+            if(arr[j].prioridade > arr[minIdx].prioridade) {
+                minIdx = j; // Atualiza índice do máximo
+            }
+        }
+
+        // Troca se encontrou máximo diferente
+        if(minIdx != i) {
+            temp = arr[i];
+            arr[i] = arr[minIdx];
+            arr[minIdx] = temp;
+            trocas++;
+        }
+    }
+    trocasVetor = trocas;
+    bytesMovidosVetor = 3LL * trocas * (long long)sizeof(Componente);
+    metricasRegistrarOrdenacao(ALGORITMO_CLASSICO, inicio);
+    if(modoSilencioso)
+        return;
+    printf("\n[SELECTION SORT] Ordenacao por PRIORIDADE concluida.\n");
+    printf("-> Comparacoes: %lld | Trocas: %lld\n", comparacoesVetor, trocas);
+}
+
+/**
+ * @brief Busca Binária - Localiza componente por nome em O(log n)
+ * @param arr Array ORDENADO alfabeticamente por nome (bubbleSortNome)
+ * @param tamanho Quantidade de elementos
+ * @param nome Nome do componente a buscar (string terminada em '\0')
+ * @return Índice do elemento encontrado, ou -1 se não encontrado
+ *
+ * PRÉ-CONDIÇÃO: Array DEVE estar ordenado por nome!
+ *               Use bubbleSortNome() antes de chamar esta função
+ *
+ * Algoritmo:
+ * - Mantém intervalo [inicio, fim] onde elemento pode estar
+ * - Calcula meio = (inicio + fim) / 2
+ * - Compara arr[meio] com nome buscado
+ * - Reduz intervalo pela metade a cada iteração
+ *
+ * Complexidade:
+ * - Tempo: O(log n) - máximo log₂(n) iterações
+ * - Comparações: máximo ~log₂(n) + 1
+ * - Espaço: O(1) - não usa recursão (iterativo)
+ *
+ * Exemplo: Para 1024 elementos, máximo 10 comparações
+ *
+ * Telemetria: Incrementa comparacoesVetor para análise
+ */
+int buscaBinariaPorNome(Componente arr[], int tamanho, char nome[]) {
+    if(tamanho == 0) {
+        return -1; // Array vazio
+    }
+
+    int inicio = 0, fim = tamanho - 1;
+    long long relogio = metricasInicio(METRICA_BUSCA_BINARIA);
+    comparacoesVetor = 0; // Reset contador de comparações
+    char chave[TAM_CHAVE_NOME]; // Nome com folga zerada: o kernel SIMD lê blocos inteiros
+    prepararChaveNome(chave, nome);
+
+    // Enquanto houver intervalo válido
+    while(inicio <= fim) {
+        // Calcula índice do meio (evita overflow)
+        int meio = inicio + (fim - inicio) / 2;
+        comparacoesVetor++;
+
+        // Compara nome no meio com nome buscado
+        int comp = compararNomeFixo(arr[meio].nome, chave);
+
+        if(comp == 0) {
+            // ENCONTRADO: retorna índice
+            metricasRegistrar(METRICA_BUSCA_BINARIA, relogio, comparacoesVetor, 1, 0);
+            return meio;
+        }
+        if(comp < 0)
+            // Nome buscado é maior: busca na metade direita
+            inicio = meio + 1;
+        else
+            // Nome buscado é menor: busca na metade esquerda
+            fim = meio - 1;
+    }
+
+    // NÃO ENCONTRADO
+    metricasRegistrar(METRICA_BUSCA_BINARIA, relogio, comparacoesVetor, 0, 1);
+    return -1;
+}
+
+/** @def LOTE_INTERCALADO Consultas avançadas juntas, nível a nível, na busca em lote */
+#define LOTE_INTERCALADO 16
+
+/** @brief Consulta da busca em lote: prefixo big-endian do nome (ordenação barata) + índice original */
+typedef struct {
+    uint64_t prefixo[2]; /**< 16 primeiros bytes do nome, completados com zeros */
+    int consulta;        /**< Índice em nomes[] */
+} ConsultaOrdenada;
+
+/**
+ * @brief Busca em lote por nome: consultas ordenadas + passada única com busca exponencial
+ *
+ * Algoritmo:
+ * - Copia cada nome para uma chave de TAM_CHAVE_NOME bytes (kernel SIMD) e
+ *   ordena pares (prefixo de 16 bytes, consulta) com Merge Sort bottom-up:
+ *   o prefixo decide quase todas as comparações sem acessar a chave
+ * - Percorre as consultas ordenadas em grupos de LOTE_INTERCALADO: cada
+ *   nível do lower bound (sem desvios) é dado para o grupo inteiro, com
+ *   prefetch das duas sondagens possíveis do nível seguinte
+ * - Consultas vizinhas compartilham o caminho de cima da árvore (cache
+ *   quente) e as faltas de cache embaixo se sobrepõem: a latência de
+ *   memória é paga por grupo, não por consulta
+ */
+int buscaEmLotePorNome(const Componente arr[], int tamanho, char nomes[][MAX_STR_LEN], int totalConsultas,
+                       int resultados[]) {
+    long long comparacoes = 0;
+    int encontrados = 0;
+    comparacoesVetor = 0;
+    if(totalConsultas <= 0)
+        return 0;
+    long long relogio = metricasInicio(METRICA_BUSCA_LOTE);
+
+    char(*chaves)[TAM_CHAVE_NOME] = malloc((size_t)totalConsultas * TAM_CHAVE_NOME);
+    ConsultaOrdenada *ordem = malloc((size_t)totalConsultas * sizeof(ConsultaOrdenada));
+    ConsultaOrdenada *auxiliar = malloc((size_t)totalConsultas * sizeof(ConsultaOrdenada));
+    if(chaves == NULL || ordem == NULL || auxiliar == NULL) {
+        free(chaves);
+        free(ordem);
+        free(auxiliar);
+        return -1;
+    }
+    for(int q = 0; q < totalConsultas; q++) {
+        prepararChaveNome(chaves[q], nomes[q]);
+        for(int w = 0; w < 2; w++) {
+            uint64_t prefixo = 0;
+            for(int b = 0; b < 8; b++)
+                prefixo = (prefixo << 8) | (unsigned char)chaves[q][8 * w + b];
+            ordem[q].prefixo[w] = prefixo;
+        }
+        ordem[q].consulta = q;
+    }
+
+    // Merge Sort bottom-up das consultas (estável): prefixos inteiros primeiro,
+    // nome completo só quando os 16 primeiros bytes empatam sem terminar
+    for(int largura = 1; largura < totalConsultas; largura *= 2) {
+        for(int inicio = 0; inicio < totalConsultas; inicio += 2 * largura) {
+            int meio = inicio + largura < totalConsultas ? inicio + largura : totalConsultas;
+            int fim = meio + largura < totalConsultas ? meio + largura : totalConsultas;
+            int i = inicio, j = meio, k = inicio;
+            while(i < meio && j < fim) {
+                comparacoes++;
+                const uint64_t *a = ordem[j].prefixo, *b = ordem[i].prefixo;
+                int direitaAntes = a[0] != b[0]   ? a[0] < b[0]
+                                   : a[1] != b[1] ? a[1] < b[1]
+                                                  : (a[1] & 0xFF) != 0 &&
+                                                        compararNomeFixo(chaves[ordem[j].consulta],
+                                                                         chaves[ordem[i].consulta]) < 0;
+                auxiliar[k++] = direitaAntes ? ordem[j++] : ordem[i++];
+            }
+            while(i < meio)
+                auxiliar[k++] = ordem[i++];
+            while(j < fim)
+                auxiliar[k++] = ordem[j++];
+        }
+        ConsultaOrdenada *temp = ordem;
+        ordem = auxiliar;
+        auxiliar = temp;
+    }
+
+    // Passada única em grupos de LOTE_INTERCALADO consultas vizinhas (já ordenadas):
+    // o lower bound sem desvios avança um nível de todas de uma vez, então as
+    // faltas de cache de um grupo se sobrepõem em vez de serem esperadas em série
+    for(int g = 0; g < totalConsultas; g += LOTE_INTERCALADO) {
+        int membros = totalConsultas - g < LOTE_INTERCALADO ? totalConsultas - g : LOTE_INTERCALADO;
+        const char *chave[LOTE_INTERCALADO];
+        int base[LOTE_INTERCALADO];
+        for(int i = 0; i < membros; i++) {
+            chave[i] = chaves[ordem[g + i].consulta];
+            base[i] = 0;
+        }
+        for(int restante = tamanho; restante > 1;) {
+            int metade = restante / 2, proxima = (restante - metade) / 2;
+            for(int i = 0; i < membros; i++) {
+                base[i] += compararNomeFixo(arr[base[i] + metade - 1].nome, chave[i]) < 0 ? metade : 0;
+                __builtin_prefetch(&arr[base[i] + proxima - 1]);
+                __builtin_prefetch(&arr[base[i] + metade + proxima - 1]);
+            }
+            comparacoes += membros;
+            restante -= metade;
+        }
+        for(int i = 0; i < membros; i++) {
+            int pos = base[i], comp = tamanho > 0 ? compararNomeFixo(arr[pos].nome, chave[i]) : 1;
+            if(comp < 0) // Nome maior que todos os do subintervalo final
+                pos++, comp = pos < tamanho ? (comparacoes++, compararNomeFixo(arr[pos].nome, chave[i])) : 1;
+            comparacoes += tamanho > 0;
+            resultados[ordem[g + i].consulta] = comp == 0 ? pos : -1;
+            encontrados += comp == 0;
+        }
+    }
+
+    free(chaves);
+    free(ordem);
+    free(auxiliar);
+    comparacoesVetor = comparacoes;
+    metricasRegistrar(METRICA_BUSCA_LOTE, relogio, comparacoes, encontrados, totalConsultas - encontrados);
+    return encontrados;
+}
+
+/**
+ * @brief Mede o tempo gasto em um algoritmo de ordenação
+ * @param algoritmo Ponteiro para função de ordenação (bubbleSortNome, insertionSortTipo ou selectionSortPrioridade)
+ * @param arr Array de componentes (será ordenado)
+ * @param tamanho Número de elementos
+ * @param descricao String descritiva do algoritmo (para exibição: "BUBBLE SORT - Por Nome")
+ *
+ * Objetivo:
+ * - Executar algoritmo de ordenação
+ * - Medir tempo de parede e de CPU em nanossegundos (medirAlgoritmo)
+ * - Exibir resultado formatado
+ *
+ * Detalhes:
+ * - Usa ponteiro para função (function pointer) para flexibilidade
+ * - clock() tinha resolução de ticks: ordenações pequenas apareciam como 0.000000
+ * - Tempo de parede (real) e de CPU são exibidos lado a lado
+ *
+ * Formato de Saída:
+ * === INICIANDO: ALGORITMO ===
+ * [Executa: bubbleSortNome() imprime própria telemetria]
+ * Tempo de parede: X us | Tempo de CPU: Y us
+ * [Com --perf: ciclos, instruções, IPC, falhas de cache e de desvio]
+ * =================================
+ */
+void medirTempo(void (*algoritmo)(Componente[], int), Componente arr[], int tamanho, const char descricao[]) {
+    Medicao med; // Resultado estruturado (tempos e contadores)
+
+    // Exibe cabeçalho
+    printf("\n=== INICIANDO: %s ===\n", descricao);
+
+    // EXECUTA O ALGORITMO (função apontada em algoritmo) entre as marcações
+    // O algoritmo imprime sua própria telemetria (comparações, trocas)
+    medirAlgoritmo(algoritmo, arr, tamanho, &med);
+
+    // Exibe resultado com resolução de nanossegundos
+    mostrarMedicao(&med);
+    printf("=================================\n");
+}
+// ============================================================================
+// IMPLEMENTAÇÃO DA MOCHILA DINÂMICA
+// ============================================================================
+
+/**
+ * @brief Inicializa uma mochila vazia (sem alocar memória)
+ * @param m Mochila a inicializar
+ * @param limite Número máximo de componentes (0 = sem limite)
+ */
+void mochilaIniciar(Mochila *m, int limite) {
+    m->itens = NULL;
+    m->quantidade = 0;
+    m->capacidade = 0;
+    m->limite = limite > 0 ? limite : 0;
+    m->ordenadaPorNome = 0;
+    memset(&m->indiceNome, 0, sizeof(m->indiceNome));
+    memset(&m->ordemNome, 0, sizeof(m->ordemNome));
+    memset(&m->filaPrioridade, 0, sizeof(m->filaPrioridade));
+    memset(&m->porTipo, 0, sizeof(m->porTipo));
+    memset(&m->porPrioridade, 0, sizeof(m->porPrioridade));
+    m->porPrioridade.porPrioridade = 1;
+    memset(&m->eytzinger, 0, sizeof(m->eytzinger));
+    memset(&m->radix, 0, sizeof(m->radix));
+    memset(&m->tipos, 0, sizeof(m->tipos));
+    m->idsTipo = NULL;
+    m->diario = NULL;
+}
+
+/**
+ * @brief Libera o vetor de itens e reinicia a mochila (o limite é preservado)
+ * @param m Mochila a liberar
+ */
+void mochilaLiberar(Mochila *m) {
+    free(m->itens);
+    indiceHashLiberar(&m->indiceNome);
+    indiceOrdenadoLiberar(&m->ordemNome);
+    heapPrioridadeLiberar(&m->filaPrioridade);
+    indiceSecundarioLiberar(&m->porTipo);
+    indiceSecundarioLiberar(&m->porPrioridade);
+    eytzingerLiberar(&m->eytzinger);
+    radixLiberar(&m->radix);
+    dicionarioTiposLiberar(&m->tipos);
+    free(m->idsTipo);
+    mochilaIniciar(m, m->limite);
+}
+
+/**
+ * @brief Garante espaço para pelo menos minimo componentes
+ * @param m Mochila
+ * @param minimo Número de posições necessárias
+ * @return 1 em caso de sucesso, 0 se a alocação falhou
+ *
+ * Estratégia de crescimento:
+ * - Capacidade dobra a cada realocação (16, 32, 64, ...)
+ * - n inserções custam O(n) cópias no total => O(1) amortizado por inserção
+ * - realloc preserva o conteúdo já armazenado
+ */
+int mochilaReservar(Mochila *m, int minimo) {
+    if(minimo <= m->capacidade)
+        return 1;
+
+    long long novaCapacidade = m->capacidade > 0 ? m->capacidade : CAPACIDADE_INICIAL;
+    while(novaCapacidade < minimo)
+        novaCapacidade *= 2;
+    if(novaCapacidade > 0x7FFFFFFF)
+        novaCapacidade = 0x7FFFFFFF; // Índices são int
+
+    Componente *novo = realloc(m->itens, (size_t)novaCapacidade * sizeof(Componente));
+    if(novo == NULL)
+        return 0;
+    m->itens = novo;
+
+    uint16_t *novosIds = realloc(m->idsTipo, (size_t)novaCapacidade * sizeof(uint16_t));
+    if(novosIds == NULL)
+        return 0; // itens já cresceu, mas a capacidade só muda quando os dois vetores cabem
+    m->idsTipo = novosIds;
+    m->capacidade = (int)novaCapacidade;
+    return 1;
+}
+
+/**
+ * @brief Calcula a memória ocupada pela mochila
+ * @param m Mochila
+ * @return Bytes alocados (estrutura + vetor de itens + ids de tipo + índices)
+ */
+size_t mochilaMemoriaBytes(const Mochila *m) {
+    return sizeof(Mochila) + (size_t)m->capacidade * (sizeof(Componente) + sizeof(uint16_t)) +
+           dicionarioTiposMemoriaBytes(&m->tipos) + indiceHashMemoriaBytes(&m->indiceNome) +
+           indiceOrdenadoMemoriaBytes(&m->ordemNome) + heapPrioridadeMemoriaBytes(&m->filaPrioridade) +
+           indiceSecundarioMemoriaBytes(&m->porTipo) + indiceSecundarioMemoriaBytes(&m->porPrioridade) +
+           eytzingerMemoriaBytes(&m->eytzinger) + radixMemoriaBytes(&m->radix);
+}
+
+/**
+ * @brief Atualiza os índices após a inserção do componente em pos
+ * @details Ponto único de manutenção: todo índice novo da mochila é registrado aqui
+ */
+static int indicesAoInserir(Mochila *m, int pos) {
+    m->eytzinger.valido = 0;
+    m->radix.valido = 0;
+    if(!indiceHashInserir(&m->indiceNome, m->itens, pos))
+        return 0;
+    if(!indiceOrdenadoInserir(&m->ordemNome, m->itens, pos)) {
+        indiceHashRemover(&m->indiceNome, m->itens, pos);
+        return 0;
+    }
+    if(!heapPrioridadeInserir(&m->filaPrioridade, m->itens, pos)) {
+        indiceHashRemover(&m->indiceNome, m->itens, pos);
+        indiceOrdenadoRemover(&m->ordemNome, m->itens, pos);
+        return 0;
+    }
+    if(!indiceSecundarioInserir(&m->porTipo, m->itens, pos)) {
+        indiceHashRemover(&m->indiceNome, m->itens, pos);
+        indiceOrdenadoRemover(&m->ordemNome, m->itens, pos);
+        heapPrioridadeRemover(&m->filaPrioridade, m->itens, pos);
+        return 0;
+    }
+    if(!indiceSecundarioInserir(&m->porPrioridade, m->itens, pos)) {
+        indiceHashRemover(&m->indiceNome, m->itens, pos);
+        indiceOrdenadoRemover(&m->ordemNome, m->itens, pos);
+        heapPrioridadeRemover(&m->filaPrioridade, m->itens, pos);
+        indiceSecundarioRemover(&m->porTipo, m->itens, pos);
+        return 0;
+    }
+    int id = dicionarioTiposRegistrar(&m->tipos, m->itens[pos].tipo);
+    if(id < 0) {
+        indiceHashRemover(&m->indiceNome, m->itens, pos);
+        indiceOrdenadoRemover(&m->ordemNome, m->itens, pos);
+        heapPrioridadeRemover(&m->filaPrioridade, m->itens, pos);
+        indiceSecundarioRemover(&m->porTipo, m->itens, pos);
+        indiceSecundarioRemover(&m->porPrioridade, m->itens, pos);
+        return 0;
+    }
+    m->idsTipo[pos] = (uint16_t)id;
+    return 1;
+}
+
+/** @brief Atualiza os índices antes da remoção do componente em pos */
+static void indicesAoRemover(Mochila *m, int pos) {
+    m->eytzinger.valido = 0;
+    m->radix.valido = 0;
+    indiceHashRemover(&m->indiceNome, m->itens, pos);
+    indiceOrdenadoRemover(&m->ordemNome, m->itens, pos);
+    heapPrioridadeRemover(&m->filaPrioridade, m->itens, pos);
+    indiceSecundarioRemover(&m->porTipo, m->itens, pos);
+    indiceSecundarioRemover(&m->porPrioridade, m->itens, pos);
+    dicionarioTiposSoltar(&m->tipos, m->idsTipo[pos]);
+}
+
+/** @brief Atualiza os índices após o componente em de ser copiado para para */
+static void indicesAoMover(Mochila *m, int de, int para) {
+    m->eytzinger.valido = 0;
+    m->radix.valido = 0;
+    indiceHashMover(&m->indiceNome, m->itens, de, para);
+    indiceOrdenadoMover(&m->ordemNome, m->itens, de, para);
+    heapPrioridadeMover(&m->filaPrioridade, de, para);
+    indiceSecundarioMover(&m->porTipo, m->itens, de, para);
+    indiceSecundarioMover(&m->porPrioridade, m->itens, de, para);
+    m->idsTipo[para] = m->idsTipo[de];
+}
+
+/**
+ * @brief Reconstrói os índices por posição (tudo menos o dicionário de tipos)
+ * @details Usada diretamente quando os ids de tipo foram permutados junto com os itens
+ */
+static void indicesReconstruir(Mochila *m) {
+    m->eytzinger.valido = 0;
+    m->radix.valido = 0;
+    indiceHashReconstruir(&m->indiceNome, m->itens, m->quantidade);
+    indiceOrdenadoReconstruir(&m->ordemNome, m->itens, m->quantidade, m->ordenadaPorNome);
+    heapPrioridadeReconstruir(&m->filaPrioridade, m->itens, m->quantidade);
+    indiceSecundarioReconstruir(&m->porTipo, m->itens, m->quantidade);
+    indiceSecundarioReconstruir(&m->porPrioridade, m->itens, m->quantidade);
+}
+
+/**
+ * @brief Reconstrói os índices após uma reordenação de m->itens
+ * @param m Mochila
+ */
+void mochilaReindexar(Mochila *m) {
+    dicionarioTiposReconstruir(&m->tipos, m->itens, m->quantidade, m->idsTipo);
+    indicesReconstruir(m);
+}
+
+void mochilaCopiarEmOrdemDeNome(const Mochila *m, Componente destino[]) {
+    if(m->ordenadaPorNome) {
+        memcpy(destino, m->itens, (size_t)m->quantidade * sizeof(Componente));
+        return;
+    }
+    int k = 0;
+    for(int b = 0; b < m->ordemNome.numBlocos; b++)
+        for(int o = 0; o < m->ordemNome.blocos[b].quantidade; o++)
+            destino[k++] = m->itens[m->ordemNome.blocos[b].posicoes[o]];
+}
+
+/**
+ * @brief Localiza um componente pelo nome usando o índice hash
+ * @return Posição em m->itens, ou -1
+ */
+int mochilaBuscarPorNome(Mochila *m, const char nome[]) {
+    long long inicio = metricasInicio(METRICA_BUSCA_HASH);
+    int pos = indiceHashBuscar(&m->indiceNome, m->itens, nome);
+    comparacoesVetor = m->indiceNome.sondagensUltimaBusca;
+    metricasRegistrar(METRICA_BUSCA_HASH, inicio, comparacoesVetor, pos != -1, pos == -1);
+    return pos;
+}
+
+/**
+ * @brief Exibe o uso de memória da mochila
+ * @param m Mochila
+ *
+ * Formato: Memoria: usada X KB | alocada Y KB | capacidade Z itens (W bytes/item)
+ */
+void mostrarUsoMemoria(const Mochila *m) {
+    size_t usada = (size_t)m->quantidade * sizeof(Componente);
+    printf("Memoria: usada %.1f KB | alocada %.1f KB | capacidade %d itens (%zu bytes/item)\n",
+           usada / 1024.0, mochilaMemoriaBytes(m) / 1024.0, m->capacidade, sizeof(Componente));
+}
+
+/**
+ * @brief Registra uma mutação no diário da mochila, se houver
+ * @details Só enfileira (o fsync é da thread escritora); quando o diário passa
+ *          do limite, pede a compactação em segundo plano
+ */
+static void mochilaRegistrarNoDiario(Mochila *m, OperacaoDiario operacao, const Componente *c) {
+    if(m->diario != NULL && diarioRegistrar(m->diario, operacao, c))
+        diarioCompactar(m->diario, m, 0);
+}
+
+/**
+ * @brief Adiciona um componente ao final da mochila
+ * @param m Mochila
+ * @param novo Componente a ser copiado
+ * @return 1 se adicionado, 0 se atingiu o limite ou faltou memória
+ */
+int adicionarComponente(Mochila *m, const Componente *novo) {
+    long long inicio = metricasInicio(METRICA_ADICAO);
+    int aceito = !(m->limite > 0 && m->quantidade >= m->limite) &&                    // Mochila cheia
+                 m->quantidade != 0x7FFFFFFF && mochilaReservar(m, m->quantidade + 1); // Sem memória
+    if(aceito) {
+        m->itens[m->quantidade] = *novo; // Cópia da estrutura inteira
+        aceito = indicesAoInserir(m, m->quantidade); // Sem memória para o índice: a inserção é desfeita
+    }
+    if(aceito) {
+        m->quantidade++;
+        mochilaRegistrarNoDiario(m, OPERACAO_DIARIO_ADICIONAR, novo);
+    }
+    metricasRegistrar(METRICA_ADICAO, inicio, 0, aceito, !aceito);
+    return aceito;
+}
+
+/**
+ * @brief Remove o componente em pos: o último item ocupa o lugar liberado
+ * @details Caminho único de remoção (descarte por nome e retirada do mais urgente)
+ */
+static void mochilaRemoverPosicao(Mochila *m, int pos) {
+    int ultimo = m->quantidade - 1;
+    Componente removido = m->itens[pos];
+    indicesAoRemover(m, pos);
+    if(pos != ultimo) {
+        m->itens[pos] = m->itens[ultimo];
+        indicesAoMover(m, ultimo, pos);
+    }
+    m->quantidade--;
+    // Só depois da remoção: uma compactação disparada aqui copia a mochila já sem o item
+    mochilaRegistrarNoDiario(m, OPERACAO_DIARIO_DESCARTAR, &removido);
+}
+
+/**
+ * @brief Remove o componente com o nome informado
+ * @param m Mochila
+ * @param nome Nome do componente a descartar
+ * @return 1 se removido, 0 se não encontrado
+ *
+ * Algoritmo:
+ * - Localiza pelo índice hash: O(1) em média
+ * - Copia o último componente para a posição liberada: O(1)
+ *   (em vez de deslocar todos os posteriores, que custaria O(n))
+ */
+int descartarComponente(Mochila *m, const char nome[]) {
+    long long inicio = metricasInicio(METRICA_DESCARTE);
+    int encontrado = indiceHashBuscar(&m->indiceNome, m->itens, nome);
+    int sondagens = m->indiceNome.sondagensUltimaBusca; // A remoção mexe no índice de novo
+    if(encontrado != -1)
+        mochilaRemoverPosicao(m, encontrado);
+    metricasRegistrar(METRICA_DESCARTE, inicio, sondagens, encontrado != -1, encontrado == -1);
+    return encontrado != -1;
+}
+
+/**
+ * @brief Retira o componente mais urgente (topo do heap de prioridade)
+ * @param m Mochila
+ * @param retirado Cópia do componente removido
+ * @return 1 se retirado, 0 se a mochila está vazia
+ */
+int mochilaRetirarMaisUrgente(Mochila *m, Componente *retirado) {
+    if(m->filaPrioridade.quantidade == 0)
+        return 0;
+    int pos = m->filaPrioridade.entradas[0];
+    *retirado = m->itens[pos];
+    mochilaRemoverPosicao(m, pos);
+    return 1;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DA BUSCA EYTZINGER
+// ============================================================================
+
+/**
+ * @brief Codifica um nome em 4 palavras big-endian (32 bytes completados com zeros)
+ * @details Com zeros após o terminador, a ordem lexicográfica dos 32 bytes é
+ *          a de strcmp; comparar as palavras como inteiros sem sinal preserva
+ *          essa ordem
+ */
+static void eytzingerCodificar(uint64_t palavras[4], const char nome[]) {
+    char chave[TAM_CHAVE_NOME];
+    prepararChaveNome(chave, nome);
+    for(int w = 0; w < 4; w++) {
+        uint64_t v = 0;
+        for(int b = 0; b < 8; b++)
+            v = (v << 8) | (unsigned char)chave[8 * w + b];
+        palavras[w] = v;
+    }
+}
+
+/** @brief a < b nas 4 palavras, só com aritmética (nenhum desvio dependente dos dados) */
+static inline unsigned eytzingerMenor(const uint64_t a[4], const uint64_t b[4]) {
+    return (a[0] < b[0]) |
+           ((a[0] == b[0]) & ((a[1] < b[1]) | ((a[1] == b[1]) & ((a[2] < b[2]) | ((a[2] == b[2]) & (a[3] < b[3]))))));
+}
+
+/**
+ * @brief Preenche a subárvore de raiz k com ordem[i..] (percurso em ordem)
+ * @return Próximo índice de ordem a consumir
+ */
+static int eytzingerPreencher(IndiceEytzinger *idx, const Componente itens[], const int ordem[], int i, int k) {
+    if(k > idx->tamanho)
+        return i;
+    i = eytzingerPreencher(idx, itens, ordem, i, 2 * k);
+    int pos = ordem != NULL ? ordem[i] : i;
+    eytzingerCodificar(idx->chaves[k], itens[pos].nome);
+    idx->posicoes[k] = pos;
+    return eytzingerPreencher(idx, itens, ordem, i + 1, 2 * k + 1);
+}
+
+/**
+ * @brief Constrói o layout: chaves alinhadas a 64 bytes (duas por linha de cache)
+ */
+int eytzingerConstruir(IndiceEytzinger *idx, const Componente itens[], const int ordem[], int tamanho) {
+    idx->valido = 0;
+    if(tamanho > idx->capacidade) {
+        // Posição 0 não é usada; o tamanho em bytes precisa ser múltiplo do alinhamento
+        size_t bytes = ((size_t)tamanho + 2) / 2 * 2 * TAM_CHAVE_NOME;
+        uint64_t(*chaves)[4] = aligned_alloc(64, bytes);
+        int *posicoes = malloc(((size_t)tamanho + 1) * sizeof(int));
+        if(chaves == NULL || posicoes == NULL) {
+            free(chaves);
+            free(posicoes);
+            return 0;
+        }
+        eytzingerLiberar(idx);
+        idx->chaves = chaves;
+        idx->posicoes = posicoes;
+        idx->capacidade = tamanho;
+    }
+    idx->tamanho = tamanho;
+    eytzingerPreencher(idx, itens, ordem, 0, 1);
+    idx->valido = 1;
+    return 1;
+}
+
+/**
+ * @brief Lower bound sem desvios + teste de igualdade
+ *
+ * Algoritmo:
+ * - k = 1; enquanto k <= n: k = 2k + (chaves[k] < nome)
+ * - Cada 1 no final de k é um passo "à direita" depois do lower bound:
+ *   k >> (número de 1s finais + 1) volta ao primeiro nome >= buscado
+ * - O prefetch de chaves[4k] traz os quatro netos (duas linhas de cache)
+ *   enquanto a comparação do nível atual é feita
+ */
+int eytzingerBuscar(const IndiceEytzinger *idx, const char nome[]) {
+    uint64_t chave[4];
+    eytzingerCodificar(chave, nome);
+    int comparacoes = 0;
+
+    unsigned k = 1, n = (unsigned)idx->tamanho;
+    while(k <= n) {
+        __builtin_prefetch(idx->chaves + 4 * (size_t)k);
+        __builtin_prefetch(idx->chaves + 4 * (size_t)k + 2);
+        comparacoes++;
+        k = 2 * k + eytzingerMenor(idx->chaves[k], chave);
+    }
+    k >>= __builtin_ctz(~k) + 1;
+    comparacoesVetor = comparacoes;
+    if(k == 0)
+        return -1; // Todos os nomes são menores que o buscado
+    comparacoesVetor++;
+    const uint64_t *c = idx->chaves[k];
+    return c[0] == chave[0] && c[1] == chave[1] && c[2] == chave[2] && c[3] == chave[3] ? idx->posicoes[k] : -1;
+}
+
+/** @brief Libera as chaves e posições */
+void eytzingerLiberar(IndiceEytzinger *idx) {
+    free(idx->chaves);
+    free(idx->posicoes);
+    memset(idx, 0, sizeof(*idx));
+}
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t eytzingerMemoriaBytes(const IndiceEytzinger *idx) {
+    return idx->capacidade > 0 ? ((size_t)idx->capacidade + 2) / 2 * 2 * TAM_CHAVE_NOME +
+                                     ((size_t)idx->capacidade + 1) * sizeof(int)
+                               : 0;
+}
+
+/**
+ * @brief Posições da mochila em ordem alfabética, lidas do índice ordenado
+ * @return Vetor alocado com malloc (liberar com free), ou NULL se faltou memória
+ * @details O(n) sem comparar nomes: base dos índices reconstruídos sob demanda
+ */
+static int *mochilaOrdemPorNome(const Mochila *m) {
+    int *ordem = malloc(((size_t)m->quantidade + 1) * sizeof(int));
+    int n = 0;
+    for(int b = 0; ordem != NULL && b < m->ordemNome.numBlocos; b++) {
+        memcpy(&ordem[n], m->ordemNome.blocos[b].posicoes, (size_t)m->ordemNome.blocos[b].quantidade * sizeof(int));
+        n += m->ordemNome.blocos[b].quantidade;
+    }
+    if(ordem != NULL && n != m->quantidade) {
+        free(ordem);
+        return NULL;
+    }
+    return ordem;
+}
+
+/**
+ * @brief Busca Eytzinger na mochila, reconstruindo o layout se necessário
+ * @details A ordem alfabética vem do índice ordenado, então a mochila não
+ *          precisa estar ordenada
+ */
+int mochilaBuscaEytzinger(Mochila *m, const char nome[]) {
+    long long inicio = metricasInicio(METRICA_BUSCA_EYTZINGER);
+    if(!m->eytzinger.valido) {
+        int *ordem = mochilaOrdemPorNome(m);
+        int ok = ordem != NULL && eytzingerConstruir(&m->eytzinger, m->itens, ordem, m->quantidade);
+        free(ordem);
+        if(!ok)
+            return mochilaBuscaBinariaIndexada(m, nome); // Sem memória: mesma resposta pelo índice ordenado
+    }
+    int pos = eytzingerBuscar(&m->eytzinger, nome);
+    metricasRegistrar(METRICA_BUSCA_EYTZINGER, inicio, comparacoesVetor, pos != -1, pos == -1);
+    return pos;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO ÍNDICE RADIX POR NOME
+// ============================================================================
+
+/** @brief Nome do i-ésimo componente em ordem alfabética */
+static inline const char *radixNome(const IndiceRadix *idx, const Componente itens[], int i) {
+    return itens[idx->ordem[i]].nome;
+}
+
+/**
+ * @brief Preenche o nó k com os nomes ordem[inicio..fim), que já coincidem nos primeiros profundidade caracteres
+ * @return 1 em caso de sucesso, 0 se faltou memória para os rótulos
+ *
+ * Algoritmo:
+ * - Rótulo = prefixo comum do primeiro e do último nome (em ordem, é o do intervalo inteiro)
+ * - Nomes que terminam no fim do rótulo vêm primeiro ('\0' é o menor caractere)
+ * - Os demais se agrupam pelo caractere seguinte: cada fronteira sai de uma
+ *   busca binária, e os filhos são reservados juntos antes da recursão
+ */
+static int radixPreencher(IndiceRadix *idx, const Componente itens[], int k, int inicio, int fim, int profundidade) {
+    const char *primeiro = radixNome(idx, itens, inicio), *ultimo = radixNome(idx, itens, fim - 1);
+    int comum = profundidade;
+    while(primeiro[comum] != '\0' && primeiro[comum] == ultimo[comum])
+        comum++;
+
+    size_t tamanhoRotulo = (size_t)(comum - profundidade);
+    if(idx->totalRotulos + tamanhoRotulo > idx->capacidadeRotulos) {
+        size_t capacidade = idx->capacidadeRotulos * 2 + tamanhoRotulo;
+        char *rotulos = realloc(idx->rotulos, capacidade);
+        if(rotulos == NULL)
+            return 0;
+        idx->rotulos = rotulos;
+        idx->capacidadeRotulos = capacidade;
+    }
+    NoRadix *no = &idx->nos[k];
+    no->rotulo = (uint32_t)idx->totalRotulos;
+    no->tamanhoRotulo = (uint8_t)tamanhoRotulo;
+    no->inicio = (uint32_t)inicio;
+    no->fim = (uint32_t)fim;
+    if(tamanhoRotulo > 0) {
+        memcpy(idx->rotulos + idx->totalRotulos, primeiro + profundidade, tamanhoRotulo);
+        idx->totalRotulos += tamanhoRotulo;
+    }
+
+    // Fronteiras dos grupos: limites[f] = primeiro nome do filho f
+    int limites[257], totalFilhos = 0, i = inicio;
+    while(i < fim && radixNome(idx, itens, i)[comum] == '\0')
+        i++; // Nomes repetidos terminam todos aqui
+    no->terminal = i > inicio;
+    while(i < fim) {
+        unsigned char c = (unsigned char)radixNome(idx, itens, i)[comum];
+        int baixo = i + 1, alto = fim; // Primeiro nome com caractere > c
+        while(baixo < alto) {
+            int meio = baixo + (alto - baixo) / 2;
+            if((unsigned char)radixNome(idx, itens, meio)[comum] <= c)
+                baixo = meio + 1;
+            else
+                alto = meio;
+        }
+        limites[totalFilhos++] = i;
+        i = baixo;
+    }
+    limites[totalFilhos] = fim;
+
+    int filho = idx->totalNos;
+    no->primeiroFilho = (uint32_t)filho;
+    no->totalFilhos = (uint16_t)totalFilhos;
+    idx->totalNos += totalFilhos;
+    for(int f = 0; f < totalFilhos; f++) {
+        idx->iniciais[filho + f] = (unsigned char)radixNome(idx, itens, limites[f])[comum];
+        if(!radixPreencher(idx, itens, filho + f, limites[f], limites[f + 1], comum))
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Constrói a árvore: no máximo 2n nós, reservados de uma vez
+ * @details Uma trie comprimida com n nomes tem no máximo n folhas e n - 1
+ *          nós de ramificação; nomes que são prefixo de outros não criam nós extras
+ */
+int radixConstruir(IndiceRadix *idx, const Componente itens[], const int ordem[], int tamanho) {
+    idx->valido = 0;
+    int necessarios = 2 * tamanho + 1;
+    if(necessarios > idx->capacidadeNos) {
+        NoRadix *nos = malloc((size_t)necessarios * sizeof(NoRadix));
+        unsigned char *iniciais = malloc((size_t)necessarios);
+        int *novaOrdem = malloc(((size_t)tamanho + 1) * sizeof(int));
+        if(nos == NULL || iniciais == NULL || novaOrdem == NULL) {
+            free(nos);
+            free(iniciais);
+            free(novaOrdem);
+            return 0;
+        }
+        char *rotulos = idx->rotulos;
+        size_t capacidadeRotulos = idx->capacidadeRotulos;
+        idx->rotulos = NULL;
+        radixLiberar(idx);
+        idx->nos = nos;
+        idx->iniciais = iniciais;
+        idx->ordem = novaOrdem;
+        idx->capacidadeNos = necessarios;
+        idx->rotulos = rotulos;
+        idx->capacidadeRotulos = capacidadeRotulos;
+    }
+    for(int i = 0; i < tamanho; i++)
+        idx->ordem[i] = ordem != NULL ? ordem[i] : i;
+    idx->tamanho = tamanho;
+    idx->totalRotulos = 0;
+    idx->totalNos = 1;
+    idx->iniciais[0] = 0;
+    memset(&idx->nos[0], 0, sizeof(NoRadix));
+    if(tamanho > 0 && !radixPreencher(idx, itens, 0, 0, tamanho, 0))
+        return 0;
+    idx->valido = 1;
+    return 1;
+}
+
+/**
+ * @brief Desce pela árvore seguindo texto
+ * @return Nó onde o texto acabou (dentro ou no fim do rótulo), ou -1 se divergiu
+ * @details Com exato = 1 o texto precisa acabar exatamente no fim de um rótulo.
+ *          comparacoesVetor recebe o número de nós visitados
+ */
+static int radixDescer(const IndiceRadix *idx, const char texto[], int exato) {
+    int k = 0, p = 0, visitados = 0;
+    for(;;) {
+        const NoRadix *no = &idx->nos[k];
+        const char *rotulo = idx->rotulos + no->rotulo;
+        visitados++;
+        for(int i = 0; i < no->tamanhoRotulo; i++, p++) {
+            if(texto[p] == '\0') {
+                comparacoesVetor = visitados;
+                return exato ? -1 : k; // O texto acaba no meio do rótulo: prefixo de toda a subárvore
+            }
+            if(texto[p] != rotulo[i]) {
+                comparacoesVetor = visitados;
+                return -1;
+            }
+        }
+        if(texto[p] == '\0') {
+            comparacoesVetor = visitados;
+            return k;
+        }
+        const unsigned char *achado = no->totalFilhos > 0 ? memchr(idx->iniciais + no->primeiroFilho,
+                                                                   (unsigned char)texto[p], no->totalFilhos)
+                                                          : NULL;
+        if(achado == NULL) {
+            comparacoesVetor = visitados;
+            return -1;
+        }
+        k = (int)(achado - idx->iniciais);
+    }
+}
+
+int radixBuscar(const IndiceRadix *idx, const char nome[]) {
+    if(idx->tamanho == 0) {
+        comparacoesVetor = 0;
+        return -1;
+    }
+    int k = radixDescer(idx, nome, 1);
+    return k >= 0 && idx->nos[k].terminal ? idx->ordem[idx->nos[k].inicio] : -1;
+}
+
+int radixPrefixo(const IndiceRadix *idx, const char prefixo[], int *primeiro) {
+    *primeiro = 0;
+    if(idx->tamanho == 0) {
+        comparacoesVetor = 0;
+        return 0;
+    }
+    int k = radixDescer(idx, prefixo, 0);
+    if(k < 0)
+        return 0;
+    *primeiro = (int)idx->nos[k].inicio;
+    return (int)(idx->nos[k].fim - idx->nos[k].inicio);
+}
+
+/**
+ * @struct BuscaAproximada
+ * @brief Estado do percurso da busca aproximada
+ * @details linhas[t] é a linha da matriz de edição depois de t caracteres do
+ *          caminho na árvore (linhas[t][j] = distância entre esse prefixo e os
+ *          j primeiros caracteres do nome buscado), saturada em distanciaMaxima + 1
+ */
+typedef struct {
+    const IndiceRadix *idx;
+    const char *consulta;
+    int tamanhoConsulta;
+    int distanciaMaxima;
+    unsigned char linhas[MAX_STR_LEN + 1][MAX_STR_LEN + 1];
+    SugestaoNome *resultados;
+    int total;
+    int capacidade;
+    int visitados;
+    int semMemoria;
+} BuscaAproximada;
+
+/** @brief Calcula linhas[t] a partir de linhas[t - 1] para o caractere c; devolve o menor valor da linha */
+static int radixLinhaEdicao(BuscaAproximada *b, int t, char c) {
+    const unsigned char *anterior = b->linhas[t - 1];
+    unsigned char *atual = b->linhas[t];
+    int teto = b->distanciaMaxima + 1;
+    int menor = atual[0] = (unsigned char)(t < teto ? t : teto);
+    for(int j = 1; j <= b->tamanhoConsulta; j++) {
+        int v = anterior[j - 1] + (b->consulta[j - 1] != c); // Substituição (ou igual)
+        if(anterior[j] + 1 < v)
+            v = anterior[j] + 1; // Remoção
+        if(atual[j - 1] + 1 < v)
+            v = atual[j - 1] + 1; // Inserção
+        atual[j] = (unsigned char)(v < teto ? v : teto);
+        if(atual[j] < menor)
+            menor = atual[j];
+    }
+    return menor;
+}
+
+/** @brief Visita o nó k, com t caracteres do caminho já processados antes do rótulo */
+static void radixVisitarAproximado(BuscaAproximada *b, int k, int t) {
+    const IndiceRadix *idx = b->idx;
+    const NoRadix *no = &idx->nos[k];
+    const char *rotulo = idx->rotulos + no->rotulo;
+    b->visitados++;
+    for(int i = 0; i < no->tamanhoRotulo; i++) {
+        if(t + 1 > MAX_STR_LEN || radixLinhaEdicao(b, t + 1, rotulo[i]) > b->distanciaMaxima)
+            return; // Nenhuma continuação deste prefixo fica dentro da distância
+        t++;
+    }
+
+    int distancia = b->linhas[t][b->tamanhoConsulta];
+    if(no->terminal && distancia <= b->distanciaMaxima) {
+        uint32_t fimTerminais = no->totalFilhos > 0 ? idx->nos[no->primeiroFilho].inicio : no->fim;
+        for(uint32_t i = no->inicio; i < fimTerminais; i++) {
+            if(b->total == b->capacidade) {
+                int capacidade = b->capacidade ? b->capacidade * 2 : 16;
+                SugestaoNome *novo = realloc(b->resultados, (size_t)capacidade * sizeof(SugestaoNome));
+                if(novo == NULL) {
+                    b->semMemoria = 1;
+                    return;
+                }
+                b->resultados = novo;
+                b->capacidade = capacidade;
+            }
+            b->resultados[b->total].posicao = idx->ordem[i];
+            b->resultados[b->total].distancia = distancia;
+            b->total++;
+        }
+    }
+    for(int f = 0; f < no->totalFilhos && !b->semMemoria; f++)
+        radixVisitarAproximado(b, (int)no->primeiroFilho + f, t);
+}
+
+int radixAproximado(const IndiceRadix *idx, const char nome[], int distanciaMaxima, SugestaoNome **resultado) {
+    BuscaAproximada b;
+    b.idx = idx;
+    b.consulta = nome;
+    b.tamanhoConsulta = (int)strnlen(nome, MAX_STR_LEN - 1);
+    b.distanciaMaxima = distanciaMaxima < 0 ? 0
+                        : distanciaMaxima > DISTANCIA_APROXIMADA_MAXIMA ? DISTANCIA_APROXIMADA_MAXIMA
+                                                                        : distanciaMaxima;
+    b.resultados = NULL;
+    b.total = b.capacidade = b.visitados = b.semMemoria = 0;
+    for(int j = 0; j <= b.tamanhoConsulta; j++)
+        b.linhas[0][j] = (unsigned char)(j <= b.distanciaMaxima ? j : b.distanciaMaxima + 1);
+    if(idx->tamanho > 0)
+        radixVisitarAproximado(&b, 0, 0);
+    comparacoesVetor = b.visitados;
+
+    // Mais próximos primeiro; o percurso já entrega cada distância em ordem alfabética
+    if(b.total > 1) {
+        SugestaoNome *ordenados = malloc((size_t)b.total * sizeof(SugestaoNome));
+        if(ordenados != NULL) {
+            int n = 0;
+            for(int d = 0; d <= b.distanciaMaxima; d++)
+                for(int i = 0; i < b.total; i++)
+                    if(b.resultados[i].distancia == d)
+                        ordenados[n++] = b.resultados[i];
+            free(b.resultados);
+            b.resultados = ordenados;
+        }
+    }
+    *resultado = b.resultados;
+    return b.total;
+}
+
+/** @brief Libera nós, rótulos e ordem */
+void radixLiberar(IndiceRadix *idx) {
+    free(idx->nos);
+    free(idx->iniciais);
+    free(idx->rotulos);
+    free(idx->ordem);
+    memset(idx, 0, sizeof(*idx));
+}
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t radixMemoriaBytes(const IndiceRadix *idx) {
+    return (size_t)idx->capacidadeNos * (sizeof(NoRadix) + 1) + idx->capacidadeRotulos +
+           (idx->capacidadeNos > 0 ? ((size_t)(idx->capacidadeNos - 1) / 2 + 1) * sizeof(int) : 0);
+}
+
+/** @brief Garante a árvore radix da mochila atualizada; 0 se faltou memória */
+static int mochilaGarantirRadix(Mochila *m) {
+    if(m->radix.valido)
+        return 1;
+    int *ordem = mochilaOrdemPorNome(m);
+    int ok = ordem != NULL && radixConstruir(&m->radix, m->itens, ordem, m->quantidade);
+    free(ordem);
+    return ok;
+}
+
+int *mochilaBuscarPorPrefixo(Mochila *m, const char prefixo[], int maximo, int *total, int *correspondencias) {
+    long long inicio = metricasInicio(METRICA_BUSCA_PREFIXO);
+    int primeiro = 0, encontrados = 0;
+    int *resultado = NULL;
+    *total = 0;
+    if(mochilaGarantirRadix(m))
+        encontrados = radixPrefixo(&m->radix, prefixo, &primeiro);
+    if(correspondencias != NULL)
+        *correspondencias = encontrados;
+    int devolvidos = maximo > 0 && maximo < encontrados ? maximo : encontrados;
+    if(devolvidos > 0 && (resultado = malloc((size_t)devolvidos * sizeof(int))) != NULL) {
+        memcpy(resultado, m->radix.ordem + primeiro, (size_t)devolvidos * sizeof(int));
+        *total = devolvidos;
+    }
+    metricasRegistrar(METRICA_BUSCA_PREFIXO, inicio, comparacoesVetor, *total > 0, *total == 0);
+    return resultado;
+}
+
+SugestaoNome *mochilaBuscarAproximado(Mochila *m, const char nome[], int distanciaMaxima, int maximo, int *total) {
+    long long inicio = metricasInicio(METRICA_BUSCA_APROXIMADA);
+    SugestaoNome *resultado = NULL;
+    *total = 0;
+    if(mochilaGarantirRadix(m)) {
+        *total = radixAproximado(&m->radix, nome, distanciaMaxima, &resultado);
+        if(maximo > 0 && *total > maximo)
+            *total = maximo; // Os mais próximos ficam no início
+    }
+    metricasRegistrar(METRICA_BUSCA_APROXIMADA, inicio, comparacoesVetor, *total > 0, *total == 0);
+    return resultado;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO ÍNDICE ORDENADO POR NOME
+// ============================================================================
+
+/** @brief Compara o nome de itens[pos] com nome (conta a comparação) */
+static int compararNomeIndice(IndiceOrdenado *idx, const Componente itens[], int pos, const char nome[]) {
+    idx->comparacoes++;
+    return strcmp(itens[pos].nome, nome);
+}
+
+/**
+ * @brief Localiza a fronteira de nome no índice (busca binária em dois níveis)
+ * @param superior 0 = primeira entrada >= nome (lower bound); 1 = primeira entrada > nome (upper bound)
+ * @param bloco Bloco da fronteira (SAÍDA); numBlocos se estiver após o fim
+ * @param offset Posição dentro do bloco (SAÍDA)
+ */
+static void indiceOrdenadoLocalizar(IndiceOrdenado *idx, const Componente itens[], const char nome[], int superior,
+                                    int *bloco, int *offset) {
+    // Nível 1: primeiro bloco cujo último nome não fica antes da fronteira
+    int inicio = 0, fim = idx->numBlocos;
+    while(inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        BlocoOrdenado *b = &idx->blocos[meio];
+        int comp = compararNomeIndice(idx, itens, b->posicoes[b->quantidade - 1], nome);
+        if(comp < 0 || (superior && comp == 0))
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    *bloco = inicio;
+    *offset = 0;
+    if(inicio == idx->numBlocos)
+        return;
+
+    // Nível 2: busca binária dentro do bloco
+    BlocoOrdenado *b = &idx->blocos[inicio];
+    int lo = 0, hi = b->quantidade;
+    while(lo < hi) {
+        int meio = lo + (hi - lo) / 2;
+        int comp = compararNomeIndice(idx, itens, b->posicoes[meio], nome);
+        if(comp < 0 || (superior && comp == 0))
+            lo = meio + 1;
+        else
+            hi = meio;
+    }
+    *offset = lo;
+}
+
+/**
+ * @brief Encontra a entrada com nome igual a itens[alvoNome] e valor pos
+ * @return 1 se encontrada (bloco/offset preenchidos), 0 caso contrário
+ * @details Necessário porque nomes repetidos ocupam entradas consecutivas
+ */
+static int indiceOrdenadoEncontrar(IndiceOrdenado *idx, const Componente itens[], const char nome[], int pos,
+                                   int *bloco, int *offset) {
+    int b, o;
+    indiceOrdenadoLocalizar(idx, itens, nome, 0, &b, &o);
+    for(; b < idx->numBlocos; b++, o = 0) {
+        for(; o < idx->blocos[b].quantidade; o++) {
+            int p = idx->blocos[b].posicoes[o];
+            if(p == pos) {
+                *bloco = b;
+                *offset = o;
+                return 1;
+            }
+            if(compararNomeIndice(idx, itens, p, nome) != 0)
+                return 0;
+        }
+    }
+    return 0;
+}
+
+/** @brief Acrescenta um bloco vazio na posição indice do vetor de blocos */
+static int indiceOrdenadoNovoBloco(IndiceOrdenado *idx, int indice) {
+    if(idx->numBlocos == idx->capacidadeBlocos) {
+        int nova = idx->capacidadeBlocos > 0 ? idx->capacidadeBlocos * 2 : 8;
+        BlocoOrdenado *blocos = realloc(idx->blocos, (size_t)nova * sizeof(BlocoOrdenado));
+        if(blocos == NULL)
+            return 0;
+        idx->blocos = blocos;
+        idx->capacidadeBlocos = nova;
+    }
+    int *posicoes = malloc(TAM_BLOCO_ORDENADO * sizeof(int));
+    if(posicoes == NULL)
+        return 0;
+    memmove(&idx->blocos[indice + 1], &idx->blocos[indice], (size_t)(idx->numBlocos - indice) * sizeof(BlocoOrdenado));
+    idx->blocos[indice].posicoes = posicoes;
+    idx->blocos[indice].quantidade = 0;
+    idx->numBlocos++;
+    return 1;
+}
+
+/** @brief Contabiliza o custo da mutação que acabou de terminar */
+static void indiceOrdenadoRegistrarMutacao(IndiceOrdenado *idx) {
+    idx->comparacoesUltimaMutacao = idx->comparacoes;
+    idx->movimentosUltimaMutacao = idx->movimentos;
+    idx->mutacoes++;
+    idx->comparacoesMutacoes += idx->comparacoes;
+    idx->movimentosMutacoes += idx->movimentos;
+}
+
+/**
+ * @brief Insere a posição pos mantendo a ordem alfabética
+ *
+ * Algoritmo:
+ * - Upper bound pelo nome (nomes repetidos mantêm a ordem de chegada)
+ * - Bloco cheio é dividido ao meio antes da inserção
+ * - Desloca no máximo TAM_BLOCO_ORDENADO posições dentro do bloco
+ */
+int indiceOrdenadoInserir(IndiceOrdenado *idx, const Componente itens[], int pos) {
+    idx->comparacoes = 0;
+    idx->movimentos = 0;
+
+    int b, o;
+    if(idx->numBlocos == 0) {
+        if(!indiceOrdenadoNovoBloco(idx, 0))
+            return 0;
+        b = 0;
+        o = 0;
+    } else {
+        indiceOrdenadoLocalizar(idx, itens, itens[pos].nome, 1, &b, &o);
+        if(b == idx->numBlocos) { // Maior que todos: final do último bloco
+            b = idx->numBlocos - 1;
+            o = idx->blocos[b].quantidade;
+        }
+    }
+
+    if(idx->blocos[b].quantidade == TAM_BLOCO_ORDENADO) {
+        // Divide o bloco cheio: a segunda metade vai para um bloco novo
+        if(!indiceOrdenadoNovoBloco(idx, b + 1))
+            return 0;
+        int metade = TAM_BLOCO_ORDENADO / 2;
+        memcpy(idx->blocos[b + 1].posicoes, idx->blocos[b].posicoes + metade,
+               (size_t)(TAM_BLOCO_ORDENADO - metade) * sizeof(int));
+        idx->blocos[b + 1].quantidade = TAM_BLOCO_ORDENADO - metade;
+        idx->blocos[b].quantidade = metade;
+        idx->movimentos += TAM_BLOCO_ORDENADO - metade;
+        if(o > metade) {
+            b++;
+            o -= metade;
+        }
+    }
+
+    BlocoOrdenado *bloco = &idx->blocos[b];
+    memmove(&bloco->posicoes[o + 1], &bloco->posicoes[o], (size_t)(bloco->quantidade - o) * sizeof(int));
+    idx->movimentos += bloco->quantidade - o;
+    bloco->posicoes[o] = pos;
+    bloco->quantidade++;
+    idx->total++;
+    indiceOrdenadoRegistrarMutacao(idx);
+    return 1;
+}
+
+/**
+ * @brief Remove a entrada que aponta para pos (nome lido de itens[pos])
+ * @details Blocos que ficam vazios são liberados
+ */
+void indiceOrdenadoRemover(IndiceOrdenado *idx, const Componente itens[], int pos) {
+    idx->comparacoes = 0;
+    idx->movimentos = 0;
+
+    int b, o;
+    if(!indiceOrdenadoEncontrar(idx, itens, itens[pos].nome, pos, &b, &o))
+        return;
+
+    BlocoOrdenado *bloco = &idx->blocos[b];
+    memmove(&bloco->posicoes[o], &bloco->posicoes[o + 1], (size_t)(bloco->quantidade - o - 1) * sizeof(int));
+    idx->movimentos += bloco->quantidade - o - 1;
+    bloco->quantidade--;
+    idx->total--;
+
+    if(bloco->quantidade == 0) {
+        free(bloco->posicoes);
+        memmove(&idx->blocos[b], &idx->blocos[b + 1], (size_t)(idx->numBlocos - b - 1) * sizeof(BlocoOrdenado));
+        idx->numBlocos--;
+    }
+    indiceOrdenadoRegistrarMutacao(idx);
+}
+
+/**
+ * @brief Atualiza a entrada de um componente movido de de para para
+ * @details O nome não mudou, então a entrada continua no mesmo lugar da ordem
+ */
+void indiceOrdenadoMover(IndiceOrdenado *idx, const Componente itens[], int de, int para) {
+    int b, o;
+    idx->comparacoes = 0;
+    if(indiceOrdenadoEncontrar(idx, itens, itens[para].nome, de, &b, &o))
+        idx->blocos[b].posicoes[o] = para;
+
+    // Um descarte = remoção + movimentação: acumula no custo da mesma mutação
+    idx->comparacoesUltimaMutacao += idx->comparacoes;
+    idx->comparacoesMutacoes += idx->comparacoes;
+}
+
+/** @brief Libera todos os blocos (a telemetria acumulada é preservada) */
+static void indiceOrdenadoLimpar(IndiceOrdenado *idx) {
+    for(int b = 0; b < idx->numBlocos; b++)
+        free(idx->blocos[b].posicoes);
+    idx->numBlocos = 0;
+    idx->total = 0;
+}
+
+/** @brief Contexto de qsort_r: ordena posições pelo nome do componente */
+static int compararPosicoesPorNome(const void *a, const void *b, void *itens) {
+    const Componente *v = itens;
+    return strcmp(v[*(const int *)a].nome, v[*(const int *)b].nome);
+}
+
+/**
+ * @brief Reconstrói o índice a partir de itens[0..quantidade-1]
+ * @param jaOrdenado 1 se itens já está em ordem de nome
+ *
+ * - Já ordenado: as posições 0..n-1 são a própria ordem => O(n)
+ * - Caso contrário: ordena as posições pelo nome => O(n log n)
+ * Os blocos são preenchidos até 3/4 para absorver inserções sem divisão imediata.
+ */
+int indiceOrdenadoReconstruir(IndiceOrdenado *idx, const Componente itens[], int quantidade, int jaOrdenado) {
+    indiceOrdenadoLimpar(idx);
+    if(quantidade == 0)
+        return 1;
+
+    int *ordem = malloc((size_t)quantidade * sizeof(int));
+    if(ordem == NULL)
+        return 0;
+    for(int i = 0; i < quantidade; i++)
+        ordem[i] = i;
+    if(!jaOrdenado)
+        qsort_r(ordem, (size_t)quantidade, sizeof(int), compararPosicoesPorNome, (void *)itens);
+
+    int porBloco = TAM_BLOCO_ORDENADO * 3 / 4;
+    for(int i = 0; i < quantidade; i += porBloco) {
+        int n = quantidade - i < porBloco ? quantidade - i : porBloco;
+        if(!indiceOrdenadoNovoBloco(idx, idx->numBlocos)) {
+            free(ordem);
+            return 0;
+        }
+        memcpy(idx->blocos[idx->numBlocos - 1].posicoes, ordem + i, (size_t)n * sizeof(int));
+        idx->blocos[idx->numBlocos - 1].quantidade = n;
+    }
+    idx->total = quantidade;
+    free(ordem);
+    return 1;
+}
+
+/** @brief Libera todos os blocos e o vetor de blocos */
+void indiceOrdenadoLiberar(IndiceOrdenado *idx) {
+    indiceOrdenadoLimpar(idx);
+    free(idx->blocos);
+    memset(idx, 0, sizeof(*idx));
+}
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t indiceOrdenadoMemoriaBytes(const IndiceOrdenado *idx) {
+    return (size_t)idx->capacidadeBlocos * sizeof(BlocoOrdenado) +
+           (size_t)idx->numBlocos * TAM_BLOCO_ORDENADO * sizeof(int);
+}
+
+/**
+ * @brief Exibe o custo da última mutação do índice ordenado
+ *
+ * Formato:
+ * -> Indice ordenado: ultima mutacao C comparacoes / M movimentos | media ... | B blocos
+ */
+void mostrarCustoIndiceOrdenado(const IndiceOrdenado *idx) {
+    printf("-> Indice ordenado: ultima mutacao %lld comparacoes / %lld movimentos | media %.1f / %.1f em %lld mutacoes | %d blocos\n",
+           idx->comparacoesUltimaMutacao, idx->movimentosUltimaMutacao,
+           idx->mutacoes ? (double)idx->comparacoesMutacoes / idx->mutacoes : 0.0,
+           idx->mutacoes ? (double)idx->movimentosMutacoes / idx->mutacoes : 0.0,
+           idx->mutacoes, idx->numBlocos);
+}
+
+/**
+ * @brief Busca binária por nome sobre o índice ordenado
+ * @return Posição em m->itens, ou -1
+ */
+int mochilaBuscaBinariaIndexada(Mochila *m, const char nome[]) {
+    IndiceOrdenado *idx = &m->ordemNome;
+    int b, o, pos = -1;
+    long long inicio = metricasInicio(METRICA_BUSCA_ORDENADO);
+    idx->comparacoes = 0;
+    indiceOrdenadoLocalizar(idx, m->itens, nome, 0, &b, &o);
+    if(b < idx->numBlocos && o < idx->blocos[b].quantidade) {
+        int candidato = idx->blocos[b].posicoes[o];
+        if(compararNomeIndice(idx, m->itens, candidato, nome) == 0)
+            pos = candidato;
+    }
+    comparacoesVetor = idx->comparacoes;
+    metricasRegistrar(METRICA_BUSCA_ORDENADO, inicio, comparacoesVetor, pos != -1, pos == -1);
+    return pos;
+}
+
+/**
+ * @brief Busca por intervalo de nomes [de, ate]
+ * @return Vetor de posições em ordem alfabética (liberar com free), ou NULL
+ *
+ * Algoritmo:
+ * - Lower bound de "de" (busca binária em dois níveis)
+ * - Percorre os blocos em ordem até o primeiro nome > "ate"
+ */
+int *mochilaBuscarIntervalo(Mochila *m, const char de[], const char ate[], int *total) {
+    IndiceOrdenado *idx = &m->ordemNome;
+    int b, o, n = 0, capacidade = 0;
+    int *resultado = NULL;
+    long long inicio = metricasInicio(METRICA_BUSCA_INTERVALO);
+
+    idx->comparacoes = 0;
+    *total = 0;
+    indiceOrdenadoLocalizar(idx, m->itens, de, 0, &b, &o);
+    for(; b < idx->numBlocos; b++, o = 0) {
+        for(; o < idx->blocos[b].quantidade; o++) {
+            int p = idx->blocos[b].posicoes[o];
+            if(compararNomeIndice(idx, m->itens, p, ate) > 0)
+                goto fim;
+            if(n == capacidade) {
+                capacidade = capacidade ? capacidade * 2 : 16;
+                int *novo = realloc(resultado, (size_t)capacidade * sizeof(int));
+                if(novo == NULL)
+                    goto fim;
+                resultado = novo;
+            }
+            resultado[n++] = p;
+        }
+    }
+fim:
+    comparacoesVetor = idx->comparacoes;
+    *total = n;
+    metricasRegistrar(METRICA_BUSCA_INTERVALO, inicio, comparacoesVetor, n > 0, n == 0);
+    return resultado;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO ÍNDICE HASH POR NOME
+// ============================================================================
+
+/**
+ * @brief Hash FNV-1a de 32 bits
+ * @details Simples, rápido e com boa dispersão para textos curtos
+ */
+static unsigned hashNome(const char nome[]) {
+    unsigned h = 2166136261u;
+    for(const unsigned char *p = (const unsigned char *)nome; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Grava pos no primeiro slot livre a partir do slot ideal de hash
+ * @details Não verifica fator de carga; usado na inserção e no rehash
+ */
+static void indiceHashGravar(IndiceHash *h, unsigned hash, int pos) {
+    unsigned mascara = (unsigned)h->capacidade - 1;
+    unsigned slot = hash & mascara;
+    int distancia = 0;
+
+    if(h->posicoes[slot] != -1)
+        h->colisoes++;
+    while(h->posicoes[slot] != -1) {
+        slot = (slot + 1) & mascara;
+        distancia++;
+    }
+    h->posicoes[slot] = pos;
+    h->hashes[slot] = hash;
+    h->ocupados++;
+    if(distancia + 1 > h->maiorSondagem)
+        h->maiorSondagem = distancia + 1;
+}
+
+/**
+ * @brief Realoca a tabela com nova capacidade e reinsere as entradas
+ * @return 1 em caso de sucesso, 0 se faltou memória (tabela antiga preservada)
+ */
+static int indiceHashRedimensionar(IndiceHash *h, int novaCapacidade) {
+    int *posicoes = malloc((size_t)novaCapacidade * sizeof(int));
+    unsigned *hashes = malloc((size_t)novaCapacidade * sizeof(unsigned));
+    if(posicoes == NULL || hashes == NULL) {
+        free(posicoes);
+        free(hashes);
+        return 0;
+    }
+    memset(posicoes, 0xFF, (size_t)novaCapacidade * sizeof(int)); // Todos os slots = -1
+
+    int *antigasPosicoes = h->posicoes;
+    unsigned *antigosHashes = h->hashes;
+    int antigaCapacidade = h->capacidade;
+
+    h->posicoes = posicoes;
+    h->hashes = hashes;
+    h->capacidade = novaCapacidade;
+    h->ocupados = 0;
+    h->colisoes = 0; // Colisões passam a refletir a nova tabela
+    for(int i = 0; i < antigaCapacidade; i++)
+        if(antigasPosicoes[i] != -1)
+            indiceHashGravar(h, antigosHashes[i], antigasPosicoes[i]);
+
+    free(antigasPosicoes);
+    free(antigosHashes);
+    return 1;
+}
+
+/**
+ * @brief Insere no índice a posição pos
+ * @details Dobra a tabela quando o fator de carga passaria de 50%
+ */
+int indiceHashInserir(IndiceHash *h, const Componente itens[], int pos) {
+    if((long long)(h->ocupados + 1) * 2 > h->capacidade) {
+        int nova = h->capacidade > 0 ? h->capacidade * 2 : CAPACIDADE_INICIAL * 2;
+        if(!indiceHashRedimensionar(h, nova))
+            return 0;
+    }
+    indiceHashGravar(h, hashNome(itens[pos].nome), pos);
+    return 1;
+}
+
+/**
+ * @brief Busca a posição do componente com o nome informado
+ * @return Posição em itens, ou -1
+ *
+ * Sondagem linear: visita slots consecutivos até achar o nome ou um slot
+ * vazio. strcmp só é chamado quando o hash armazenado coincide.
+ */
+int indiceHashBuscar(IndiceHash *h, const Componente itens[], const char nome[]) {
+    h->buscas++;
+    h->sondagensUltimaBusca = 0;
+    if(h->capacidade == 0)
+        return -1;
+
+    unsigned hash = hashNome(nome);
+    unsigned mascara = (unsigned)h->capacidade - 1;
+    for(unsigned slot = hash & mascara;; slot = (slot + 1) & mascara) {
+        h->sondagensUltimaBusca++;
+        int pos = h->posicoes[slot];
+        if(pos == -1)
+            break;
+        if(h->hashes[slot] == hash && strcmp(itens[pos].nome, nome) == 0) {
+            h->sondagens += h->sondagensUltimaBusca;
+            if(h->sondagensUltimaBusca > h->maiorSondagem)
+                h->maiorSondagem = h->sondagensUltimaBusca;
+            return pos;
+        }
+    }
+    h->sondagens += h->sondagensUltimaBusca;
+    if(h->sondagensUltimaBusca > h->maiorSondagem)
+        h->maiorSondagem = h->sondagensUltimaBusca;
+    return -1;
+}
+
+/**
+ * @brief Encontra o slot que aponta para pos (o nome de itens[pos] dá o slot inicial)
+ * @return Índice do slot, ou -1 se não estiver no índice
+ */
+static int indiceHashSlotDe(const IndiceHash *h, unsigned hash, int pos) {
+    if(h->capacidade == 0)
+        return -1;
+    unsigned mascara = (unsigned)h->capacidade - 1;
+    for(unsigned slot = hash & mascara; h->posicoes[slot] != -1; slot = (slot + 1) & mascara)
+        if(h->posicoes[slot] == pos)
+            return (int)slot;
+    return -1;
+}
+
+/**
+ * @brief Remove do índice a entrada que aponta para pos
+ *
+ * Remoção por deslocamento para trás: as entradas seguintes do mesmo
+ * agrupamento que "pularam" o slot liberado voltam uma posição, mantendo
+ * válida a regra de parada no primeiro slot vazio.
+ */
+void indiceHashRemover(IndiceHash *h, const Componente itens[], int pos) {
+    int slotRemovido = indiceHashSlotDe(h, hashNome(itens[pos].nome), pos);
+    if(slotRemovido == -1)
+        return;
+
+    unsigned mascara = (unsigned)h->capacidade - 1;
+    unsigned vazio = (unsigned)slotRemovido;
+    for(unsigned slot = (vazio + 1) & mascara; h->posicoes[slot] != -1; slot = (slot + 1) & mascara) {
+        unsigned ideal = h->hashes[slot] & mascara;
+        // A entrada pode ocupar o buraco se seu slot ideal não está entre (vazio, slot]
+        if(((slot - ideal) & mascara) >= ((slot - vazio) & mascara)) {
+            h->posicoes[vazio] = h->posicoes[slot];
+            h->hashes[vazio] = h->hashes[slot];
+            vazio = slot;
+        }
+    }
+    h->posicoes[vazio] = -1;
+    h->ocupados--;
+}
+
+/**
+ * @brief Atualiza a entrada de um componente que mudou de posição
+ */
+void indiceHashMover(IndiceHash *h, const Componente itens[], int de, int para) {
+    int slot = indiceHashSlotDe(h, hashNome(itens[para].nome), de);
+    if(slot != -1)
+        h->posicoes[slot] = para;
+}
+
+/**
+ * @brief Reconstrói o índice a partir de itens[0..quantidade-1]
+ * @details Dimensiona a tabela pela quantidade: potência de 2 com fator de carga <= 1/2
+ */
+void indiceHashReconstruir(IndiceHash *h, const Componente itens[], int quantidade) {
+    // Mesmo fator de carga máximo da inserção (1/2): um snapshot carregado pode ser maior que a tabela atual
+    int capacidade = h->capacidade > 0 ? h->capacidade : CAPACIDADE_INICIAL * 2;
+    while((long long)quantidade * 2 > capacidade)
+        capacidade *= 2;
+    if(quantidade > 0 && capacidade != h->capacidade && !indiceHashRedimensionar(h, capacidade))
+        return;
+    if(h->capacidade == 0)
+        return;
+    memset(h->posicoes, 0xFF, (size_t)h->capacidade * sizeof(int));
+    h->ocupados = 0;
+    h->colisoes = 0;
+    for(int i = 0; i < quantidade; i++)
+        indiceHashGravar(h, hashNome(itens[i].nome), i);
+}
+
+/** @brief Libera a memória do índice e zera a telemetria */
+void indiceHashLiberar(IndiceHash *h) {
+    free(h->posicoes);
+    free(h->hashes);
+    memset(h, 0, sizeof(*h));
+}
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t indiceHashMemoriaBytes(const IndiceHash *h) {
+    return (size_t)h->capacidade * (sizeof(int) + sizeof(unsigned));
+}
+
+/**
+ * @brief Exibe estatísticas do índice hash
+ *
+ * Formato:
+ * -> Indice hash: N entradas / M slots (carga X%) | colisoes C
+ * -> Sondagens: ultima busca S | media A | maior L
+ */
+void mostrarEstatisticasHash(const IndiceHash *h) {
+    printf("-> Indice hash: %d entradas / %d slots (carga %.1f%%) | colisoes na insercao: %lld\n",
+           h->ocupados, h->capacidade, h->capacidade ? 100.0 * h->ocupados / h->capacidade : 0.0, h->colisoes);
+    printf("-> Sondagens: ultima busca %d | media %.2f em %lld buscas | maior sequencia %d\n",
+           h->sondagensUltimaBusca, h->buscas ? (double)h->sondagens / h->buscas : 0.0, h->buscas, h->maiorSondagem);
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DA FILA DE PRIORIDADE
+// ============================================================================
+
+/**
+ * @brief Ordem do heap: a vem antes de b se é mais urgente
+ * @details Maior prioridade primeiro; empate pelo menor nome, para que o
+ *          Top-K seja determinístico
+ */
+static int heapMaisUrgente(HeapPrioridade *h, const Componente itens[], int a, int b) {
+    h->comparacoes++;
+    if(itens[a].prioridade != itens[b].prioridade)
+        return itens[a].prioridade > itens[b].prioridade;
+    return strcmp(itens[a].nome, itens[b].nome) < 0;
+}
+
+/** @brief Grava a posição pos no índice i do heap, mantendo o vetor inverso */
+static void heapColocar(HeapPrioridade *h, int i, int pos) {
+    h->entradas[i] = pos;
+    h->posicaoNoHeap[pos] = i;
+    h->movimentos++;
+}
+
+/** @brief Sobe a entrada i enquanto ela for mais urgente que o pai */
+static void heapSubir(HeapPrioridade *h, const Componente itens[], int i) {
+    int pos = h->entradas[i];
+    while(i > 0) {
+        int pai = (i - 1) / 2;
+        if(!heapMaisUrgente(h, itens, pos, h->entradas[pai]))
+            break;
+        heapColocar(h, i, h->entradas[pai]);
+        i = pai;
+    }
+    heapColocar(h, i, pos);
+}
+
+/** @brief Desce a entrada i enquanto algum filho for mais urgente */
+static void heapDescer(HeapPrioridade *h, const Componente itens[], int i) {
+    int pos = h->entradas[i];
+    for(;;) {
+        int filho = 2 * i + 1;
+        if(filho >= h->quantidade)
+            break;
+        if(filho + 1 < h->quantidade && heapMaisUrgente(h, itens, h->entradas[filho + 1], h->entradas[filho]))
+            filho++;
+        if(!heapMaisUrgente(h, itens, h->entradas[filho], pos))
+            break;
+        heapColocar(h, i, h->entradas[filho]);
+        i = filho;
+    }
+    heapColocar(h, i, pos);
+}
+
+/** @brief Garante capacidade para minimo entradas (e posições de item) */
+static int heapReservar(HeapPrioridade *h, int minimo) {
+    if(minimo <= h->capacidade)
+        return 1;
+    int nova = h->capacidade > 0 ? h->capacidade : CAPACIDADE_INICIAL;
+    while(nova < minimo)
+        nova = nova > 0x3FFFFFFF ? 0x7FFFFFFF : nova * 2;
+    int *entradas = realloc(h->entradas, (size_t)nova * sizeof(int));
+    if(entradas == NULL)
+        return 0;
+    h->entradas = entradas;
+    int *posicoes = realloc(h->posicaoNoHeap, (size_t)nova * sizeof(int));
+    if(posicoes == NULL)
+        return 0;
+    h->posicaoNoHeap = posicoes;
+    h->capacidade = nova;
+    return 1;
+}
+
+/**
+ * @brief Insere a posição pos (novo item no final da mochila): O(log n)
+ */
+int heapPrioridadeInserir(HeapPrioridade *h, const Componente itens[], int pos) {
+    if(!heapReservar(h, (pos > h->quantidade ? pos : h->quantidade) + 1))
+        return 0;
+    h->entradas[h->quantidade++] = pos;
+    heapSubir(h, itens, h->quantidade - 1);
+    return 1;
+}
+
+/**
+ * @brief Remove a entrada da posição pos: a última entrada ocupa o lugar e
+ *        sobe ou desce conforme a chave
+ */
+void heapPrioridadeRemover(HeapPrioridade *h, const Componente itens[], int pos) {
+    int i = h->posicaoNoHeap[pos];
+    int ultima = h->entradas[--h->quantidade];
+    if(i == h->quantidade)
+        return; // Era a última entrada
+    heapColocar(h, i, ultima);
+    if(i > 0 && heapMaisUrgente(h, itens, ultima, h->entradas[(i - 1) / 2]))
+        heapSubir(h, itens, i);
+    else
+        heapDescer(h, itens, i);
+}
+
+/** @brief O componente movido mantém a chave: só o endereço muda */
+void heapPrioridadeMover(HeapPrioridade *h, int de, int para) {
+    heapColocar(h, h->posicaoNoHeap[de], para);
+}
+
+/**
+ * @brief Heapify de baixo para cima: O(n) comparações
+ */
+int heapPrioridadeReconstruir(HeapPrioridade *h, const Componente itens[], int quantidade) {
+    if(!heapReservar(h, quantidade)) {
+        h->quantidade = 0;
+        return 0;
+    }
+    h->quantidade = quantidade;
+    for(int i = 0; i < quantidade; i++) {
+        h->entradas[i] = i;
+        h->posicaoNoHeap[i] = i;
+    }
+    for(int i = quantidade / 2 - 1; i >= 0; i--)
+        heapDescer(h, itens, i);
+    return 1;
+}
+
+/** @brief Libera a memória do heap */
+void heapPrioridadeLiberar(HeapPrioridade *h) {
+    free(h->entradas);
+    free(h->posicaoNoHeap);
+    memset(h, 0, sizeof(*h));
+}
+
+/** @brief Memória ocupada pelo heap em bytes */
+size_t heapPrioridadeMemoriaBytes(const HeapPrioridade *h) {
+    return (size_t)h->capacidade * 2 * sizeof(int);
+}
+
+/**
+ * @brief Top-K sobre o heap da mochila
+ *
+ * Algoritmo:
+ * - Candidatos = heap auxiliar de índices do heap principal, iniciado com a raiz
+ * - K vezes: retira o candidato mais urgente (próximo do resultado) e
+ *   insere seus dois filhos no heap principal como candidatos
+ * - O heap auxiliar nunca passa de K + 1 entradas: O(K log K) comparações
+ */
+int *mochilaTopK(Mochila *m, int k, int *total) {
+    HeapPrioridade *h = &m->filaPrioridade;
+    *total = 0;
+    comparacoesVetor = 0;
+    if(k > h->quantidade)
+        k = h->quantidade;
+    if(k <= 0)
+        return NULL;
+
+    int *resultado = malloc((size_t)k * sizeof(int));
+    int *candidatos = malloc((size_t)(k + 1) * sizeof(int)); // Índices do heap principal
+    if(resultado == NULL || candidatos == NULL) {
+        free(resultado);
+        free(candidatos);
+        return NULL;
+    }
+    long long comparacoesAntes = h->comparacoes;
+    int numCandidatos = 1;
+    candidatos[0] = 0;
+
+    while(*total < k) {
+        // Retira o melhor candidato (raiz do heap auxiliar)
+        int melhor = candidatos[0];
+        resultado[(*total)++] = h->entradas[melhor];
+        candidatos[0] = candidatos[--numCandidatos];
+        for(int i = 0;;) { // Desce no heap auxiliar
+            int filho = 2 * i + 1;
+            if(filho >= numCandidatos)
+                break;
+            if(filho + 1 < numCandidatos &&
+               heapMaisUrgente(h, m->itens, h->entradas[candidatos[filho + 1]], h->entradas[candidatos[filho]]))
+                filho++;
+            if(!heapMaisUrgente(h, m->itens, h->entradas[candidatos[filho]], h->entradas[candidatos[i]]))
+                break;
+            int t = candidatos[i];
+            candidatos[i] = candidatos[filho];
+            candidatos[filho] = t;
+            i = filho;
+        }
+        // Filhos do retirado viram candidatos (sobem no heap auxiliar)
+        for(int f = 2 * melhor + 1; f <= 2 * melhor + 2 && f < h->quantidade; f++) {
+            int i = numCandidatos++;
+            candidatos[i] = f;
+            while(i > 0 && heapMaisUrgente(h, m->itens, h->entradas[candidatos[i]],
+                                           h->entradas[candidatos[(i - 1) / 2]])) {
+                int pai = (i - 1) / 2, t = candidatos[i];
+                candidatos[i] = candidatos[pai];
+                candidatos[pai] = t;
+                i = pai;
+            }
+        }
+    }
+    comparacoesVetor = (h->comparacoes - comparacoesAntes);
+    h->comparacoes = comparacoesAntes; // Consulta: não entra na telemetria de manutenção
+    free(candidatos);
+    return resultado;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DOS ÍNDICES SECUNDÁRIOS (TIPO E PRIORIDADE)
+// ============================================================================
+
+/** @brief Compara a chave do componente c com a do grupo g (strcmp no tipo ou diferença de prioridade) */
+static int compararChaveSecundaria(IndiceSecundario *idx, const Componente *c, const GrupoSecundario *g) {
+    idx->comparacoes++;
+    if(idx->porPrioridade)
+        return (c->prioridade > g->prioridade) - (c->prioridade < g->prioridade);
+    return strcmp(c->tipo, g->tipo);
+}
+
+/**
+ * @brief Lower bound da chave de c entre os grupos
+ * @param encontrado 1 se grupos[retorno] tem exatamente a chave de c (SAÍDA)
+ * @return Índice do primeiro grupo com chave >= chave de c
+ */
+static int indiceSecundarioLocalizar(IndiceSecundario *idx, const Componente *c, int *encontrado) {
+    int inicio = 0, fim = idx->numGrupos;
+    while(inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if(compararChaveSecundaria(idx, c, &idx->grupos[meio]) > 0)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    *encontrado = inicio < idx->numGrupos && compararChaveSecundaria(idx, c, &idx->grupos[inicio]) == 0;
+    return inicio;
+}
+
+/** @brief Contabiliza o custo da mutação que acabou de terminar */
+static void indiceSecundarioRegistrarMutacao(IndiceSecundario *idx) {
+    idx->comparacoesUltimaMutacao = idx->comparacoes;
+    idx->movimentosUltimaMutacao = idx->movimentos;
+    idx->mutacoes++;
+    idx->comparacoesMutacoes += idx->comparacoes;
+    idx->movimentosMutacoes += idx->movimentos;
+}
+
+/**
+ * @brief Insere a posição pos no grupo da sua chave
+ *
+ * Algoritmo:
+ * - Busca binária pela chave entre os grupos: O(log g)
+ * - Chave nova: abre um grupo no lugar certo (desloca g grupos no pior caso,
+ *   mas g é o número de valores distintos, não de itens)
+ * - Posição entra no final do grupo: O(1) amortizado
+ */
+int indiceSecundarioInserir(IndiceSecundario *idx, const Componente itens[], int pos) {
+    if(pos >= idx->capacidadeSlots) {
+        int nova = idx->capacidadeSlots > 0 ? idx->capacidadeSlots : CAPACIDADE_INICIAL;
+        while(nova <= pos)
+            nova = nova > 0x3FFFFFFF ? 0x7FFFFFFF : nova * 2;
+        int *slots = realloc(idx->slotNoGrupo, (size_t)nova * sizeof(int));
+        if(slots == NULL)
+            return 0;
+        idx->slotNoGrupo = slots;
+        idx->capacidadeSlots = nova;
+    }
+
+    idx->comparacoes = 0;
+    idx->movimentos = 0;
+    int existe;
+    int gi = indiceSecundarioLocalizar(idx, &itens[pos], &existe);
+    if(!existe) {
+        if(idx->numGrupos == idx->capacidadeGrupos) {
+            int nova = idx->capacidadeGrupos > 0 ? idx->capacidadeGrupos * 2 : CAPACIDADE_INICIAL;
+            GrupoSecundario *grupos = realloc(idx->grupos, (size_t)nova * sizeof(GrupoSecundario));
+            if(grupos == NULL)
+                return 0;
+            idx->grupos = grupos;
+            idx->capacidadeGrupos = nova;
+        }
+        memmove(&idx->grupos[gi + 1], &idx->grupos[gi], (size_t)(idx->numGrupos - gi) * sizeof(GrupoSecundario));
+        idx->movimentos += idx->numGrupos - gi;
+        idx->numGrupos++;
+        GrupoSecundario *g = &idx->grupos[gi];
+        memset(g, 0, sizeof(*g));
+        strcpy(g->tipo, itens[pos].tipo);
+        g->prioridade = itens[pos].prioridade;
+    }
+
+    GrupoSecundario *g = &idx->grupos[gi];
+    if(g->quantidade == g->capacidade) {
+        int nova = g->capacidade > 0 ? g->capacidade * 2 : 4;
+        int *posicoes = realloc(g->posicoes, (size_t)nova * sizeof(int));
+        if(posicoes == NULL) {
+            if(g->quantidade == 0) { // Grupo recém-aberto: desfaz
+                idx->numGrupos--;
+                memmove(&idx->grupos[gi], &idx->grupos[gi + 1], (size_t)(idx->numGrupos - gi) * sizeof(GrupoSecundario));
+            }
+            return 0;
+        }
+        g->posicoes = posicoes;
+        g->capacidade = nova;
+    }
+    idx->slotNoGrupo[pos] = g->quantidade;
+    g->posicoes[g->quantidade++] = pos;
+    g->somaQuantidade += itens[pos].quantidade;
+    idx->movimentos++;
+    indiceSecundarioRegistrarMutacao(idx);
+    return 1;
+}
+
+/**
+ * @brief Remove a posição pos do seu grupo
+ * @details A última posição do grupo ocupa o slot liberado (O(1)); um grupo
+ *          que fica vazio é descartado para as consultas não o visitarem
+ */
+void indiceSecundarioRemover(IndiceSecundario *idx, const Componente itens[], int pos) {
+    idx->comparacoes = 0;
+    idx->movimentos = 0;
+    int existe;
+    int gi = indiceSecundarioLocalizar(idx, &itens[pos], &existe);
+    if(!existe)
+        return;
+
+    GrupoSecundario *g = &idx->grupos[gi];
+    int slot = idx->slotNoGrupo[pos];
+    int ultima = g->posicoes[--g->quantidade];
+    if(slot != g->quantidade) {
+        g->posicoes[slot] = ultima;
+        idx->slotNoGrupo[ultima] = slot;
+        idx->movimentos++;
+    }
+    g->somaQuantidade -= itens[pos].quantidade;
+    if(g->quantidade == 0) {
+        free(g->posicoes);
+        idx->numGrupos--;
+        memmove(&idx->grupos[gi], &idx->grupos[gi + 1], (size_t)(idx->numGrupos - gi) * sizeof(GrupoSecundario));
+        idx->movimentos += idx->numGrupos - gi;
+    }
+    indiceSecundarioRegistrarMutacao(idx);
+}
+
+/**
+ * @brief Atualiza a entrada de um componente movido de de para para
+ * @details A chave não mudou: o componente continua no mesmo grupo e slot
+ */
+void indiceSecundarioMover(IndiceSecundario *idx, const Componente itens[], int de, int para) {
+    idx->comparacoes = 0;
+    int existe;
+    int gi = indiceSecundarioLocalizar(idx, &itens[para], &existe);
+    if(existe) {
+        int slot = idx->slotNoGrupo[de];
+        idx->grupos[gi].posicoes[slot] = para;
+        idx->slotNoGrupo[para] = slot;
+    }
+
+    // Um descarte = remoção + movimentação: acumula no custo da mesma mutação
+    idx->comparacoesUltimaMutacao += idx->comparacoes;
+    idx->comparacoesMutacoes += idx->comparacoes;
+}
+
+/** @brief Libera todos os grupos (a telemetria acumulada é preservada) */
+static void indiceSecundarioLimpar(IndiceSecundario *idx) {
+    for(int g = 0; g < idx->numGrupos; g++)
+        free(idx->grupos[g].posicoes);
+    idx->numGrupos = 0;
+}
+
+/**
+ * @brief Reinsere todas as posições: O(n log g)
+ * @details Usado após reordenações e cargas, quando todas as posições mudam;
+ *          não entra na telemetria de mutações
+ */
+int indiceSecundarioReconstruir(IndiceSecundario *idx, const Componente itens[], int quantidade) {
+    indiceSecundarioLimpar(idx);
+    IndiceSecundario telemetria = *idx;
+    for(int i = 0; i < quantidade; i++) {
+        if(!indiceSecundarioInserir(idx, itens, i)) {
+            indiceSecundarioLimpar(idx);
+            return 0;
+        }
+    }
+    idx->comparacoesUltimaMutacao = telemetria.comparacoesUltimaMutacao;
+    idx->movimentosUltimaMutacao = telemetria.movimentosUltimaMutacao;
+    idx->mutacoes = telemetria.mutacoes;
+    idx->comparacoesMutacoes = telemetria.comparacoesMutacoes;
+    idx->movimentosMutacoes = telemetria.movimentosMutacoes;
+    return 1;
+}
+
+/** @brief Libera os grupos e o mapa de slots */
+void indiceSecundarioLiberar(IndiceSecundario *idx) {
+    int porPrioridade = idx->porPrioridade;
+    indiceSecundarioLimpar(idx);
+    free(idx->grupos);
+    free(idx->slotNoGrupo);
+    memset(idx, 0, sizeof(*idx));
+    idx->porPrioridade = porPrioridade;
+}
+
+/** @brief Memória ocupada pelo índice em bytes */
+size_t indiceSecundarioMemoriaBytes(const IndiceSecundario *idx) {
+    size_t bytes = (size_t)idx->capacidadeGrupos * sizeof(GrupoSecundario) + (size_t)idx->capacidadeSlots * sizeof(int);
+    for(int g = 0; g < idx->numGrupos; g++)
+        bytes += (size_t)idx->grupos[g].capacidade * sizeof(int);
+    return bytes;
+}
+
+/**
+ * @brief Exibe o custo da última mutação do índice secundário
+ *
+ * Formato:
+ * -> Indice por tipo: ultima mutacao C comparacoes / M movimentos | media ... | G grupos
+ */
+void mostrarCustoIndiceSecundario(const IndiceSecundario *idx) {
+    printf("-> Indice por %s: ultima mutacao %lld comparacoes / %lld movimentos | media %.1f / %.1f em %lld mutacoes | %d grupos\n",
+           idx->porPrioridade ? "prioridade" : "tipo", idx->comparacoesUltimaMutacao, idx->movimentosUltimaMutacao,
+           idx->mutacoes ? (double)idx->comparacoesMutacoes / idx->mutacoes : 0.0,
+           idx->mutacoes ? (double)idx->movimentosMutacoes / idx->mutacoes : 0.0,
+           idx->mutacoes, idx->numGrupos);
+}
+
+/**
+ * @brief Localiza o grupo do tipo: o resultado já está materializado nele
+ */
+const int *mochilaBuscarPorTipo(Mochila *m, const char tipo[], int *total, long long *somaQuantidade) {
+    IndiceSecundario *idx = &m->porTipo;
+    Componente chave;
+    memset(&chave, 0, sizeof(chave));
+    snprintf(chave.tipo, sizeof(chave.tipo), "%s", tipo);
+
+    long long comparacoesAntes = idx->comparacoes;
+    int existe;
+    int gi = indiceSecundarioLocalizar(idx, &chave, &existe);
+    comparacoesVetor = (idx->comparacoes - comparacoesAntes);
+    idx->comparacoes = comparacoesAntes; // Consulta: não entra no custo de manutenção
+
+    *total = existe ? idx->grupos[gi].quantidade : 0;
+    if(somaQuantidade != NULL)
+        *somaQuantidade = existe ? idx->grupos[gi].somaQuantidade : 0;
+    return existe ? idx->grupos[gi].posicoes : NULL;
+}
+
+/**
+ * @brief Busca por faixa de prioridade [min, max]
+ *
+ * Algoritmo:
+ * - Lower bound de min entre as chaves distintas: O(log g)
+ * - Concatena os grupos seguintes até a primeira chave > max: O(k)
+ */
+int *mochilaBuscarFaixaPrioridade(Mochila *m, int min, int max, int *total) {
+    IndiceSecundario *idx = &m->porPrioridade;
+    Componente chave;
+    memset(&chave, 0, sizeof(chave));
+    chave.prioridade = min;
+    *total = 0;
+
+    long long comparacoesAntes = idx->comparacoes;
+    int existe;
+    int primeiro = indiceSecundarioLocalizar(idx, &chave, &existe), ultimo = primeiro;
+    for(; ultimo < idx->numGrupos && idx->grupos[ultimo].prioridade <= max; ultimo++)
+        idx->comparacoes++;
+    comparacoesVetor = (idx->comparacoes - comparacoesAntes);
+    idx->comparacoes = comparacoesAntes;
+
+    int n = 0;
+    for(int g = primeiro; g < ultimo; g++)
+        n += idx->grupos[g].quantidade;
+    if(n == 0)
+        return NULL;
+    int *resultado = malloc((size_t)n * sizeof(int));
+    if(resultado == NULL)
+        return NULL;
+    for(int g = primeiro; g < ultimo; g++) {
+        memcpy(&resultado[*total], idx->grupos[g].posicoes, (size_t)idx->grupos[g].quantidade * sizeof(int));
+        *total += idx->grupos[g].quantidade;
+    }
+    return resultado;
+}
+
+/**
+ * @brief Exibe os agregados por tipo
+ *
+ * Formato:
+ * TIPO                 | COMPONENTES | QUANTIDADE TOTAL
+ */
+void mostrarTotaisPorTipo(const Mochila *m) {
+    const IndiceSecundario *idx = &m->porTipo;
+    printf("\n--- TOTAIS POR TIPO (%d tipos) ---\n", idx->numGrupos);
+    printf("%-20s | %-11s | %s\n", "TIPO", "COMPONENTES", "QUANTIDADE TOTAL");
+    printf("--------------------------------------------------------\n");
+    for(int g = 0; g < idx->numGrupos; g++)
+        printf("%-20s | %-11d | %lld\n", idx->grupos[g].tipo, idx->grupos[g].quantidade, idx->grupos[g].somaQuantidade);
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO DICIONÁRIO DE TIPOS
+// ============================================================================
+
+/** @brief Refaz a tabela hash com novaCapacidade slots a partir dos hashes guardados nas entradas */
+static int dicionarioTiposRedimensionar(DicionarioTipos *d, int novaCapacidade) {
+    uint16_t *slots = calloc((size_t)novaCapacidade, sizeof(uint16_t));
+    if(slots == NULL)
+        return 0;
+    unsigned mascara = (unsigned)novaCapacidade - 1;
+    for(int id = 0; id < d->total; id++) {
+        unsigned s = d->entradas[id].hash & mascara;
+        while(slots[s] != 0)
+            s = (s + 1) & mascara;
+        slots[s] = (uint16_t)(id + 1);
+    }
+    free(d->slots);
+    d->slots = slots;
+    d->capacidadeSlots = novaCapacidade;
+    return 1;
+}
+
+/** @brief Slot que guarda o tipo, ou o slot vazio onde ele entraria */
+static unsigned dicionarioTiposSlot(DicionarioTipos *d, const char tipo[], unsigned hash) {
+    unsigned mascara = (unsigned)d->capacidadeSlots - 1;
+    unsigned s = hash & mascara;
+    for(; d->slots[s] != 0; s = (s + 1) & mascara) {
+        const EntradaTipo *e = &d->entradas[d->slots[s] - 1];
+        if(e->hash != hash)
+            continue;
+        d->comparacoes++;
+        if(strcmp(e->texto, tipo) == 0)
+            break;
+    }
+    return s;
+}
+
+int dicionarioTiposRegistrar(DicionarioTipos *d, const char tipo[]) {
+    if(2 * (d->total + 1) > d->capacidadeSlots &&
+       !dicionarioTiposRedimensionar(d, d->capacidadeSlots > 0 ? 2 * d->capacidadeSlots : 16))
+        return -1;
+
+    unsigned hash = hashNome(tipo);
+    unsigned s = dicionarioTiposSlot(d, tipo, hash);
+    if(d->slots[s] == 0) {
+        if(d->total == MAX_TIPOS_DISTINTOS)
+            return -1;
+        if(d->total == d->capacidade) {
+            int novaCapacidade = d->capacidade > 0 ? 2 * d->capacidade : 16;
+            EntradaTipo *novas = realloc(d->entradas, (size_t)novaCapacidade * sizeof(EntradaTipo));
+            if(novas == NULL)
+                return -1;
+            d->entradas = novas;
+            d->capacidade = novaCapacidade;
+        }
+        EntradaTipo *e = &d->entradas[d->total];
+        memset(e, 0, sizeof(*e));
+        strncpy(e->texto, tipo, sizeof(e->texto) - 1);
+        e->hash = hash;
+        d->slots[s] = (uint16_t)(++d->total);
+        d->ordemValida = 0; // Tipo novo: os postos mudam
+    }
+    int id = d->slots[s] - 1;
+    d->entradas[id].contagem++;
+    return id;
+}
+
+void dicionarioTiposSoltar(DicionarioTipos *d, int id) {
+    d->entradas[id].contagem--;
+}
+
+int dicionarioTiposBuscar(DicionarioTipos *d, const char tipo[]) {
+    if(d->total == 0)
+        return -1;
+    unsigned s = dicionarioTiposSlot(d, tipo, hashNome(tipo));
+    return d->slots[s] - 1;
+}
+
+const char *dicionarioTiposTexto(const DicionarioTipos *d, int id) {
+    return d->entradas[id].texto;
+}
+
+/** @brief Compara dois ids pelo texto do tipo (qsort_r), contando a comparação */
+static int compararIdsTipo(const void *a, const void *b, void *dicionario) {
+    DicionarioTipos *d = dicionario;
+    d->comparacoes++;
+    return strcmp(d->entradas[*(const uint16_t *)a].texto, d->entradas[*(const uint16_t *)b].texto);
+}
+
+int dicionarioTiposOrdenar(DicionarioTipos *d) {
+    if(d->ordemValida || d->total == 0)
+        return 1;
+    uint16_t *ordem = malloc((size_t)d->total * sizeof(uint16_t));
+    if(ordem == NULL)
+        return 0;
+    for(int id = 0; id < d->total; id++)
+        ordem[id] = (uint16_t)id;
+    qsort_r(ordem, (size_t)d->total, sizeof(uint16_t), compararIdsTipo, d);
+    for(int p = 0; p < d->total; p++)
+        d->entradas[ordem[p]].posto = (uint16_t)p;
+    free(ordem);
+    d->ordemValida = 1;
+    return 1;
+}
+
+int dicionarioTiposReconstruir(DicionarioTipos *d, const Componente itens[], int quantidade, uint16_t ids[]) {
+    d->total = 0;
+    d->ordemValida = 0;
+    if(d->slots != NULL)
+        memset(d->slots, 0, (size_t)d->capacidadeSlots * sizeof(uint16_t));
+    for(int i = 0; i < quantidade; i++) {
+        int id = dicionarioTiposRegistrar(d, itens[i].tipo);
+        if(id < 0)
+            return 0;
+        ids[i] = (uint16_t)id;
+    }
+    return 1;
+}
+
+void dicionarioTiposLiberar(DicionarioTipos *d) {
+    free(d->entradas);
+    free(d->slots);
+    memset(d, 0, sizeof(*d));
+}
+
+size_t dicionarioTiposMemoriaBytes(const DicionarioTipos *d) {
+    return (size_t)d->capacidade * sizeof(EntradaTipo) + (size_t)d->capacidadeSlots * sizeof(uint16_t);
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO SNAPSHOT BINÁRIO
+// ============================================================================
+
+/**
+ * @brief Grava um vetor de componentes como snapshot binário
+ * @param caminho Arquivo de destino
+ * @param itens Registros gravados na ordem em que estão
+ * @param quantidade Número de registros
+ * @param ordemNome Posições em ordem de nome, ou NULL se itens já está ordenado por nome
+ * @param lsn Última entrada de diário refletida nos registros (0 = sem diário)
+ * @param bytesGravados Soma os bytes escritos (pode ser NULL)
+ * @return 1 em caso de sucesso, 0 em caso de erro
+ *
+ * Estratégia:
+ * - Grava em "<caminho>.tmp", faz fsync e só então renomeia: uma queda no
+ *   meio da gravação nunca deixa um snapshot truncado no lugar do anterior
+ * - Registros em um único fwrite (mesmo layout da memória)
+ */
+static int snapshotGravar(const char caminho[], const Componente itens[], int quantidade, const uint32_t ordemNome[],
+                          uint64_t lsn, long long *bytesGravados) {
+    char temporario[4096];
+    if(snprintf(temporario, sizeof(temporario), "%s.tmp", caminho) >= (int)sizeof(temporario))
+        return 0;
+    FILE *arquivo = fopen(temporario, "wb");
+    if(arquivo == NULL) {
+        fprintf(stderr, "[ERRO] Nao foi possivel criar '%s'.\n", temporario);
+        return 0;
+    }
+    setvbuf(arquivo, NULL, _IOFBF, 1 << 20);
+
+    CabecalhoSnapshot cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, MAGICA_SNAPSHOT, sizeof(cab.magica));
+    cab.versao = VERSAO_SNAPSHOT;
+    cab.quantidade = (uint64_t)quantidade;
+    cab.tamanhoRegistro = sizeof(Componente);
+    cab.deslocamentoRegistros = sizeof(CabecalhoSnapshot);
+    cab.lsn = lsn;
+    if(ordemNome == NULL) {
+        cab.flags = SNAPSHOT_ORDENADO_POR_NOME;
+    } else {
+        cab.flags = SNAPSHOT_COM_INDICE;
+        cab.deslocamentoIndice = cab.deslocamentoRegistros + (uint64_t)quantidade * sizeof(Componente);
+    }
+
+    int ok = fwrite(&cab, sizeof(cab), 1, arquivo) == 1 &&
+             fwrite(itens, sizeof(Componente), (size_t)quantidade, arquivo) == (size_t)quantidade;
+    if(ok && ordemNome != NULL)
+        ok = fwrite(ordemNome, sizeof(uint32_t), (size_t)quantidade, arquivo) == (size_t)quantidade;
+    ok = ok && fflush(arquivo) == 0 && fsync(fileno(arquivo)) == 0;
+    ok = fclose(arquivo) == 0 && ok;
+    if(!ok || rename(temporario, caminho) != 0) {
+        fprintf(stderr, "[ERRO] Falha ao gravar o snapshot '%s'.\n", caminho);
+        remove(temporario);
+        return 0;
+    }
+    if(bytesGravados != NULL)
+        *bytesGravados += (long long)sizeof(cab) +
+                          (long long)quantidade * (long long)(sizeof(Componente) + (ordemNome ? sizeof(uint32_t) : 0));
+    return 1;
+}
+
+/**
+ * @brief Grava a mochila em um snapshot binário
+ * @param m Mochila
+ * @param caminho Arquivo de destino
+ * @return 1 em caso de sucesso, 0 em caso de erro
+ * @details Mochila desordenada: acrescenta as posições em ordem de nome, lidas
+ *          do índice ordenado já mantido a cada mutação (sem ordenar nada).
+ *          Com diário ativo, o cabeçalho guarda o LSN da última operação
+ */
+int mochilaSalvar(const Mochila *m, const char caminho[]) {
+    uint32_t *ordem = NULL;
+    if(!m->ordenadaPorNome) {
+        ordem = malloc((size_t)m->quantidade * sizeof(uint32_t) + 1);
+        if(ordem == NULL) {
+            fprintf(stderr, "[ERRO] Memoria insuficiente para gravar '%s'.\n", caminho);
+            return 0;
+        }
+        int k = 0;
+        for(int b = 0; b < m->ordemNome.numBlocos; b++)
+            for(int o = 0; o < m->ordemNome.blocos[b].quantidade; o++)
+                ordem[k++] = (uint32_t)m->ordemNome.blocos[b].posicoes[o];
+    }
+    int ok = snapshotGravar(caminho, m->itens, m->quantidade, ordem, m->diario ? diarioLsnAtual(m->diario) : 0, NULL);
+    free(ordem);
+    return ok;
+}
+
+/**
+ * @brief Confere se o índice por nome é uma permutação de 0..quantidade-1
+ * @details Cada posição é usada como registros[indice[i]]: um valor fora do
+ *          intervalo leria fora do mapeamento. Um bit por posição já vista
+ */
+static int snapshotIndiceValido(const uint32_t indice[], uint64_t quantidade) {
+    unsigned char *vistos = calloc((size_t)(quantidade / 8 + 1), 1);
+    if(vistos == NULL)
+        return 0;
+    int valido = 1;
+    for(uint64_t i = 0; valido && i < quantidade; i++) {
+        uint32_t pos = indice[i];
+        if(pos >= quantidade || (vistos[pos / 8] & (1u << (pos % 8))))
+            valido = 0; // Fora do vetor ou repetida
+        else
+            vistos[pos / 8] |= (unsigned char)(1u << (pos % 8));
+    }
+    free(vistos);
+    return valido;
+}
+
+/**
+ * @brief Mapeia um snapshot e valida cabeçalho, layout, tamanhos e índice
+ * @details O arquivo é mapeado inteiro com PROT_READ: as páginas só são lidas
+ *          do disco quando acessadas, então os registros de um snapshot de
+ *          vários GB não são lidos na abertura e uma busca binária toca apenas
+ *          O(log n) páginas. O índice por nome (4 bytes por item) é lido uma
+ *          vez para confirmar que é uma permutação de 0..quantidade-1
+ */
+int snapshotMapear(const char caminho[], SnapshotMapeado *snap) {
+    memset(snap, 0, sizeof(*snap));
+    int fd = open(caminho, O_RDONLY);
+    if(fd < 0) {
+        fprintf(stderr, "[ERRO] Nao foi possivel abrir '%s'.\n", caminho);
+        return 0;
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoSnapshot)) {
+        fprintf(stderr, "[ERRO] '%s' nao e um snapshot valido.\n", caminho);
+        close(fd);
+        return 0;
+    }
+    void *mapa = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // O mapeamento continua válido sem o descritor
+    if(mapa == MAP_FAILED) {
+        fprintf(stderr, "[ERRO] Falha ao mapear '%s'.\n", caminho);
+        return 0;
+    }
+
+    const CabecalhoSnapshot *cab = mapa;
+    uint64_t tamanho = (uint64_t)info.st_size;
+    uint64_t fimRegistros = cab->deslocamentoRegistros + cab->quantidade * cab->tamanhoRegistro;
+    const char *motivo = NULL;
+    if(memcmp(cab->magica, MAGICA_SNAPSHOT, sizeof(cab->magica)) != 0)
+        motivo = "assinatura desconhecida";
+    else if(cab->versao != VERSAO_SNAPSHOT)
+        motivo = "versao nao suportada";
+    else if(cab->tamanhoRegistro != sizeof(Componente) || cab->deslocamentoRegistros % sizeof(int) != 0)
+        motivo = "layout de registro incompativel";
+    else if(cab->quantidade > 0x7FFFFFFF || fimRegistros > tamanho || fimRegistros < cab->deslocamentoRegistros)
+        motivo = "arquivo truncado";
+    else if((cab->flags & SNAPSHOT_COM_INDICE) &&
+            (cab->deslocamentoIndice % sizeof(uint32_t) != 0 || cab->deslocamentoIndice < fimRegistros ||
+             cab->deslocamentoIndice + cab->quantidade * sizeof(uint32_t) > tamanho))
+        motivo = "indice truncado";
+    if(motivo == NULL && (cab->flags & SNAPSHOT_COM_INDICE) &&
+       !snapshotIndiceValido((const uint32_t *)((const char *)mapa + cab->deslocamentoIndice), cab->quantidade))
+        motivo = "indice invalido";
+    if(motivo != NULL) {
+        fprintf(stderr, "[ERRO] Snapshot '%s' invalido: %s.\n", caminho, motivo);
+        munmap(mapa, (size_t)info.st_size);
+        return 0;
+    }
+
+    snap->mapa = mapa;
+    snap->tamanhoMapa = (size_t)info.st_size;
+    snap->cabecalho = cab;
+    snap->registros = (const Componente *)((const char *)mapa + cab->deslocamentoRegistros);
+    snap->indiceNome =
+        (cab->flags & SNAPSHOT_COM_INDICE) ? (const uint32_t *)((const char *)mapa + cab->deslocamentoIndice) : NULL;
+    snap->quantidade = (int)cab->quantidade;
+    return 1;
+}
+
+/** @brief Desfaz o mapeamento do snapshot */
+void snapshotDesmapear(SnapshotMapeado *snap) {
+    if(snap->mapa != NULL)
+        munmap(snap->mapa, snap->tamanhoMapa);
+    memset(snap, 0, sizeof(*snap));
+}
+
+/**
+ * @brief Busca binária direto no arquivo mapeado
+ * @details Mesma lógica de buscaBinariaPorNome; com índice, a i-ésima
+ *          posição em ordem de nome é registros[indiceNome[i]]
+ */
+int snapshotBuscarPorNome(const SnapshotMapeado *snap, const char nome[]) {
+    int inicio = 0, fim = snap->quantidade - 1, encontrado = -1;
+    long long relogio = metricasInicio(METRICA_BUSCA_SNAPSHOT);
+    comparacoesVetor = 0;
+    while(inicio <= fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        int pos = snap->indiceNome != NULL ? (int)snap->indiceNome[meio] : meio;
+        comparacoesVetor++;
+        int comp = strncmp(snap->registros[pos].nome, nome, MAX_STR_LEN);
+        if(comp == 0) {
+            encontrado = pos;
+            break;
+        }
+        if(comp < 0)
+            inicio = meio + 1;
+        else
+            fim = meio - 1;
+    }
+    metricasRegistrar(METRICA_BUSCA_SNAPSHOT, relogio, comparacoesVetor, encontrado != -1, encontrado == -1);
+    return encontrado;
+}
+
+/**
+ * @brief Substitui o conteúdo da mochila pelo de um snapshot
+ * @details Um memcpy dos registros mapeados + reconstrução dos índices
+ *          (linear para snapshots ordenados por nome). Com diário ativo, o
+ *          novo conteúdo vira o snapshot de base (compactação síncrona)
+ */
+int mochilaCarregar(Mochila *m, const char caminho[]) {
+    SnapshotMapeado snap;
+    if(!snapshotMapear(caminho, &snap))
+        return 0;
+    if((m->limite > 0 && snap.quantidade > m->limite) || !mochilaReservar(m, snap.quantidade)) {
+        fprintf(stderr, "[ERRO] Snapshot com %d componentes nao cabe na mochila.\n", snap.quantidade);
+        snapshotDesmapear(&snap);
+        return 0;
+    }
+    memcpy(m->itens, snap.registros, (size_t)snap.quantidade * sizeof(Componente));
+    for(int i = 0; i < snap.quantidade; i++) {
+        m->itens[i].nome[MAX_STR_LEN - 1] = '\0'; // Arquivo externo: garante textos terminados
+        m->itens[i].tipo[sizeof(m->itens[i].tipo) - 1] = '\0';
+    }
+    m->quantidade = snap.quantidade;
+    m->ordenadaPorNome = (snap.cabecalho->flags & SNAPSHOT_ORDENADO_POR_NOME) != 0;
+    for(int i = 1; m->ordenadaPorNome && i < m->quantidade; i++)
+        if(strcmp(m->itens[i - 1].nome, m->itens[i].nome) > 0)
+            m->ordenadaPorNome = 0; // Flag do arquivo não confere: a busca usa o índice ordenado
+    snapshotDesmapear(&snap);
+    mochilaReindexar(m);
+    if(m->diario != NULL)
+        diarioCompactar(m->diario, m, 1); // Conteúdo substituído: checkpoint em vez de registrar cada item
+    return 1;
+}
+
+/**
+ * @brief Opção --consultar: busca nomes no snapshot mapeado
+ *
+ * Formato de saída (uma linha por nome):
+ * nome: Tipo: T, Qtd: Q, Prio: P (C comparacoes)
+ * nome: nao encontrado (C comparacoes)
+ */
+int consultarSnapshot(const char caminho[], int totalNomes, char *nomes[]) {
+    Medicao med;
+    SnapshotMapeado snap;
+    medicaoIniciar(&med);
+    if(!snapshotMapear(caminho, &snap))
+        return 1;
+    medicaoFinalizar(&med);
+    printf("Snapshot '%s': %d componentes (%s) | mapeado em %lld ns\n", caminho, snap.quantidade,
+           snap.indiceNome != NULL ? "indice por nome" : "ordenado por nome", med.tempoParedeNs);
+
+    for(int i = 0; i < totalNomes; i++) {
+        medicaoIniciar(&med);
+        int pos = snapshotBuscarPorNome(&snap, nomes[i]);
+        medicaoFinalizar(&med);
+        if(pos == -1) {
+            printf("%s: nao encontrado (%lld comparacoes, %lld ns)\n", nomes[i], comparacoesVetor, med.tempoParedeNs);
+        } else {
+            const Componente *c = &snap.registros[pos];
+            printf("%s: Tipo: %.*s, Qtd: %d, Prio: %d (%lld comparacoes, %lld ns)\n", nomes[i],
+                   (int)sizeof(c->tipo), c->tipo, c->quantidade, c->prioridade, comparacoesVetor, med.tempoParedeNs);
+        }
+    }
+    snapshotDesmapear(&snap);
+    return 0;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO DIÁRIO DE OPERAÇÕES
+// ============================================================================
+
+/** @brief Relógio monotônico em ns (chegada dos registros e espera do group commit) */
+static long long diarioAgoraNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/** @brief FNV-1a de todos os bytes do registro após o campo verificacao */
+static uint32_t diarioVerificacao(const RegistroDiario *r) {
+    const unsigned char *p = (const unsigned char *)r + sizeof(r->verificacao);
+    uint32_t h = 2166136261u;
+    for(size_t i = sizeof(r->verificacao); i < sizeof(*r); i++, p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/** @brief write() completo (repete em escritas parciais) */
+static int diarioEscreverTudo(int fd, const void *dados, size_t tamanho) {
+    const char *p = dados;
+    while(tamanho > 0) {
+        ssize_t n = write(fd, p, tamanho);
+        if(n <= 0)
+            return 0;
+        p += n;
+        tamanho -= (size_t)n;
+    }
+    return 1;
+}
+
+/** @brief Grava o cabeçalho de um diário vazio com o LSN de base informado */
+static int diarioGravarCabecalho(int fd, uint64_t lsnBase) {
+    CabecalhoDiario cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, MAGICA_DIARIO, sizeof(cab.magica));
+    cab.versao = VERSAO_DIARIO;
+    cab.tamanhoRegistro = sizeof(RegistroDiario);
+    cab.lsnBase = lsnBase;
+    return diarioEscreverTudo(fd, &cab, sizeof(cab));
+}
+
+/**
+ * @brief Reaplica os registros do diário sobre a mochila (recuperação)
+ * @return Bytes válidos do arquivo (cabeçalho + registros íntegros), ou -1 se o cabeçalho é inválido
+ * @details Para no primeiro registro com verificação errada ou LSN fora de
+ *          sequência: é a cauda de uma escrita interrompida
+ */
+static long long diarioReaplicar(DiarioOperacoes *d, Mochila *m, uint64_t lsnSnapshot) {
+    CabecalhoDiario cab;
+    if(read(d->fd, &cab, sizeof(cab)) != (ssize_t)sizeof(cab) || memcmp(cab.magica, MAGICA_DIARIO, 8) != 0 ||
+       cab.versao != VERSAO_DIARIO || cab.tamanhoRegistro != sizeof(RegistroDiario)) {
+        fprintf(stderr, "[ERRO] '%s' nao e um diario valido.\n", d->caminhoDiario);
+        return -1;
+    }
+    if(cab.lsnBase > lsnSnapshot) {
+        fprintf(stderr, "[ERRO] Diario '%s' comeca no LSN %llu, mas o snapshot de base esta no LSN %llu.\n",
+                d->caminhoDiario, (unsigned long long)cab.lsnBase, (unsigned long long)lsnSnapshot);
+        return -1;
+    }
+
+    enum { REGISTROS_POR_LEITURA = 4096 };
+    RegistroDiario *lote = malloc(REGISTROS_POR_LEITURA * sizeof(RegistroDiario));
+    if(lote == NULL)
+        return -1;
+    long long validos = sizeof(cab);
+    uint64_t anterior = cab.lsnBase;
+    int adicionou = 0, fim = 0;
+    ssize_t lidos;
+    while(!fim && (lidos = read(d->fd, lote, REGISTROS_POR_LEITURA * sizeof(RegistroDiario))) > 0) {
+        int completos = (int)(lidos / (ssize_t)sizeof(RegistroDiario));
+        for(int i = 0; i < completos; i++) {
+            RegistroDiario *r = &lote[i];
+            if(r->verificacao != diarioVerificacao(r) || r->lsn != anterior + 1) {
+                fim = 1;
+                break;
+            }
+            anterior = r->lsn;
+            validos += sizeof(RegistroDiario);
+            if(r->lsn <= lsnSnapshot) {
+                d->registrosIgnorados++;
+                continue;
+            }
+            r->componente.nome[MAX_STR_LEN - 1] = '\0';
+            r->componente.tipo[sizeof(r->componente.tipo) - 1] = '\0';
+            if(r->operacao == OPERACAO_DIARIO_ADICIONAR)
+                adicionou |= adicionarComponente(m, &r->componente);
+            else
+                descartarComponente(m, r->componente.nome);
+            d->registrosReaplicados++;
+        }
+        if(lidos % (ssize_t)sizeof(RegistroDiario) != 0)
+            fim = 1; // Registro parcial: o restante do arquivo é cauda
+    }
+    free(lote);
+    if(adicionou)
+        m->ordenadaPorNome = 0;
+    d->ultimoLsn = anterior > lsnSnapshot ? anterior : lsnSnapshot;
+    return validos;
+}
+
+/**
+ * @brief Compactação (thread escritora): snapshot da cópia + diário só com LSN > lsn
+ * @details Ordem segura contra quedas: o snapshot é renomeado antes do novo
+ *          diário; entre as duas etapas, o diário antigo ainda vale (as
+ *          entradas já contidas no snapshot são ignoradas pelo LSN)
+ */
+static int diarioExecutarCompactacao(DiarioOperacoes *d, const Componente copia[], int quantidade, uint64_t lsn) {
+    long long gravados = 0;
+    if(!snapshotGravar(d->caminhoSnapshot, copia, quantidade, NULL, lsn, &gravados))
+        return 0;
+
+    char temporario[sizeof(d->caminhoDiario) + 8];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", d->caminhoDiario);
+    int origem = open(d->caminhoDiario, O_RDONLY);
+    int destino = open(temporario, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int ok = origem >= 0 && destino >= 0 && diarioGravarCabecalho(destino, lsn);
+    long long tamanho = sizeof(CabecalhoDiario);
+    gravados += sizeof(CabecalhoDiario);
+
+    // A cauda posterior ao snapshot costuma ser curta: copia em blocos, filtrando pelo LSN
+    RegistroDiario lote[256];
+    ssize_t lidos;
+    if(ok && lseek(origem, sizeof(CabecalhoDiario), SEEK_SET) < 0)
+        ok = 0;
+    while(ok && (lidos = read(origem, lote, sizeof(lote))) > 0) {
+        int completos = (int)(lidos / (ssize_t)sizeof(RegistroDiario)), primeiro = 0;
+        while(primeiro < completos && lote[primeiro].lsn <= lsn)
+            primeiro++;
+        size_t bytes = (size_t)(completos - primeiro) * sizeof(RegistroDiario);
+        ok = diarioEscreverTudo(destino, lote + primeiro, bytes);
+        tamanho += (long long)bytes;
+        gravados += (long long)bytes;
+    }
+    ok = ok && fsync(destino) == 0;
+    if(origem >= 0)
+        close(origem);
+    if(destino >= 0)
+        ok = close(destino) == 0 && ok;
+    if(!ok || rename(temporario, d->caminhoDiario) != 0) {
+        fprintf(stderr, "[ERRO] Falha ao reescrever o diario '%s'.\n", d->caminhoDiario);
+        remove(temporario);
+        return 0;
+    }
+
+    // O descritor antigo aponta para o arquivo substituído: reabre o novo
+    int novo = open(d->caminhoDiario, O_RDWR | O_APPEND);
+    if(novo < 0)
+        return 0;
+    close(d->fd);
+    d->fd = novo;
+
+    pthread_mutex_lock(&d->trava);
+    d->tamanhoArquivo = tamanho;
+    d->bytesGravados += gravados;
+    pthread_mutex_unlock(&d->trava);
+    return 1;
+}
+
+/**
+ * @brief Thread escritora: group commit e compactação
+ * @details A fila é trocada por um buffer vazio sob a trava e gravada fora
+ *          dela, então a thread principal nunca espera pelo disco
+ */
+static void *diarioEscritor(void *arg) {
+    DiarioOperacoes *d = arg;
+    RegistroDiario *gravando = NULL;
+    int capacidadeGravando = 0;
+
+    pthread_mutex_lock(&d->trava);
+    for(;;) {
+        long long prazo = d->inicioFilaNs + d->intervaloMs * 1000000LL;
+        int gravar = d->totalFila > 0 && (d->totalFila >= d->grupoMaximo || d->lsnPedido > d->lsnDuravel ||
+                                          d->encerrar || d->copiaCompactacao != NULL || diarioAgoraNs() >= prazo);
+        if(gravar) {
+            // Troca de buffers: a principal continua enfileirando no buffer vazio
+            RegistroDiario *fila = d->fila;
+            int total = d->totalFila, capacidade = d->capacidadeFila;
+            uint64_t ultimo = d->ultimoLsn;
+            d->fila = gravando;
+            d->capacidadeFila = capacidadeGravando;
+            d->totalFila = 0;
+            gravando = fila;
+            capacidadeGravando = capacidade;
+            int falhou = d->falha;
+            pthread_mutex_unlock(&d->trava);
+
+            size_t bytes = (size_t)total * sizeof(RegistroDiario);
+            int ok = !falhou && diarioEscreverTudo(d->fd, gravando, bytes) && fdatasync(d->fd) == 0;
+
+            pthread_mutex_lock(&d->trava);
+            if(ok) {
+                d->lsnDuravel = ultimo;
+                d->tamanhoArquivo += (long long)bytes;
+                d->bytesGravados += (long long)bytes;
+                d->sincronizacoes++;
+                if(total > d->maiorGrupo)
+                    d->maiorGrupo = total;
+            } else if(!d->falha) {
+                d->falha = 1;
+                fprintf(stderr, "[ERRO] Falha ao gravar o diario '%s'; operacoes seguintes nao sao duraveis.\n",
+                        d->caminhoDiario);
+            }
+            pthread_cond_broadcast(&d->progresso);
+            continue;
+        }
+        if(d->copiaCompactacao != NULL) {
+            Componente *copia = d->copiaCompactacao;
+            int quantidade = d->quantidadeCompactacao;
+            uint64_t lsn = d->lsnCompactacao;
+            d->copiaCompactacao = NULL;
+            pthread_mutex_unlock(&d->trava);
+
+            long long inicio = diarioAgoraNs();
+            int ok = diarioExecutarCompactacao(d, copia, quantidade, lsn);
+            free(copia);
+
+            pthread_mutex_lock(&d->trava);
+            if(ok) {
+                d->compactacoes++;
+                d->tempoCompactacaoNs = diarioAgoraNs() - inicio;
+            }
+            d->compactando = 0;
+            pthread_cond_broadcast(&d->progresso);
+            continue;
+        }
+        if(d->encerrar)
+            break;
+        if(d->totalFila > 0) {
+            struct timespec ts = {(time_t)(prazo / 1000000000LL), (long)(prazo % 1000000000LL)};
+            pthread_cond_timedwait(&d->haTrabalho, &d->trava, &ts);
+        } else {
+            pthread_cond_wait(&d->haTrabalho, &d->trava);
+        }
+    }
+    pthread_mutex_unlock(&d->trava);
+    free(gravando);
+    return NULL;
+}
+
+int diarioAbrir(DiarioOperacoes *d, Mochila *m, const char base[], int grupo, int intervaloMs, long long limiteBytes) {
+    memset(d, 0, sizeof(*d));
+    d->fd = -1;
+    if(snprintf(d->caminhoDiario, sizeof(d->caminhoDiario), "%s.wal", base) >= (int)sizeof(d->caminhoDiario) ||
+       snprintf(d->caminhoSnapshot, sizeof(d->caminhoSnapshot), "%s.snap", base) >= (int)sizeof(d->caminhoSnapshot)) {
+        fprintf(stderr, "[ERRO] Caminho do diario muito longo.\n");
+        return 0;
+    }
+    d->grupoMaximo = grupo > 0 ? grupo : DIARIO_GRUPO_PADRAO;
+    d->intervaloMs = intervaloMs > 0 ? intervaloMs : DIARIO_INTERVALO_PADRAO_MS;
+    d->limiteBytes = limiteBytes > 0 ? limiteBytes : DIARIO_LIMITE_PADRAO;
+
+    // ---- Recuperação: snapshot de base + cauda do diário, sem o limite da mochila ----
+    long long inicio = diarioAgoraNs();
+    int limite = m->limite, ok = 1;
+    m->limite = 0;
+    if(access(d->caminhoSnapshot, F_OK) == 0) {
+        SnapshotMapeado snap;
+        ok = snapshotMapear(d->caminhoSnapshot, &snap);
+        if(ok) {
+            d->lsnBase = snap.cabecalho->lsn;
+            snapshotDesmapear(&snap);
+            ok = mochilaCarregar(m, d->caminhoSnapshot);
+        }
+    }
+    long long validos = 0;
+    struct stat info;
+    d->fd = ok ? open(d->caminhoDiario, O_RDWR | O_CREAT | O_APPEND, 0644) : -1;
+    if(d->fd < 0 || fstat(d->fd, &info) != 0) {
+        if(ok)
+            fprintf(stderr, "[ERRO] Nao foi possivel abrir o diario '%s'.\n", d->caminhoDiario);
+        ok = 0;
+    } else if(info.st_size == 0) {
+        ok = diarioGravarCabecalho(d->fd, d->lsnBase) && fsync(d->fd) == 0;
+        validos = sizeof(CabecalhoDiario);
+        d->ultimoLsn = d->lsnBase;
+    } else {
+        validos = diarioReaplicar(d, m, d->lsnBase);
+        ok = validos >= 0;
+        if(ok && validos < (long long)info.st_size) { // Cauda de uma escrita interrompida
+            d->bytesDescartados = (long long)info.st_size - validos;
+            ok = ftruncate(d->fd, validos) == 0 && fsync(d->fd) == 0;
+        }
+    }
+    m->limite = limite;
+    d->tempoReplayNs = diarioAgoraNs() - inicio;
+    if(!ok) {
+        if(d->fd >= 0)
+            close(d->fd);
+        d->fd = -1;
+        return 0;
+    }
+    d->tamanhoArquivo = validos;
+    d->lsnDuravel = d->lsnPedido = d->ultimoLsn;
+
+    // ---- Thread escritora (espera com relógio monotônico) ----
+    pthread_condattr_t atributos;
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    pthread_mutex_init(&d->trava, NULL);
+    pthread_cond_init(&d->haTrabalho, &atributos);
+    pthread_cond_init(&d->progresso, NULL);
+    pthread_condattr_destroy(&atributos);
+    if(pthread_create(&d->escritor, NULL, diarioEscritor, d) != 0) {
+        fprintf(stderr, "[ERRO] Nao foi possivel iniciar a escrita do diario.\n");
+        pthread_mutex_destroy(&d->trava);
+        pthread_cond_destroy(&d->haTrabalho);
+        pthread_cond_destroy(&d->progresso);
+        close(d->fd);
+        d->fd = -1;
+        return 0;
+    }
+    m->diario = d;
+    return 1;
+}
+
+int diarioRegistrar(DiarioOperacoes *d, OperacaoDiario operacao, const Componente *c) {
+    pthread_mutex_lock(&d->trava);
+    if(d->totalFila == d->capacidadeFila) {
+        int nova = d->capacidadeFila > 0 ? d->capacidadeFila * 2 : d->grupoMaximo;
+        RegistroDiario *fila = realloc(d->fila, (size_t)nova * sizeof(RegistroDiario));
+        if(fila == NULL) {
+            d->falha = 1;
+            pthread_mutex_unlock(&d->trava);
+            fprintf(stderr, "[ERRO] Memoria insuficiente para o diario; operacao nao registrada.\n");
+            return 0;
+        }
+        d->fila = fila;
+        d->capacidadeFila = nova;
+    }
+    RegistroDiario *r = &d->fila[d->totalFila++];
+    memset(r, 0, sizeof(*r)); // Bytes de preenchimento determinísticos para a verificação
+    r->operacao = (uint32_t)operacao;
+    r->lsn = ++d->ultimoLsn;
+    if(operacao == OPERACAO_DIARIO_ADICIONAR)
+        r->componente = *c;
+    else
+        memcpy(r->componente.nome, c->nome, sizeof(r->componente.nome));
+    r->verificacao = diarioVerificacao(r);
+
+    d->operacoes++;
+    d->bytesLogicos += sizeof(Componente);
+    if(d->totalFila == 1)
+        d->inicioFilaNs = diarioAgoraNs();
+    if(d->totalFila == 1 || d->totalFila >= d->grupoMaximo)
+        pthread_cond_signal(&d->haTrabalho); // Inicia a espera do grupo, ou grava o grupo cheio
+    int compactar = !d->compactando &&
+                    d->tamanhoArquivo + (long long)d->totalFila * (long long)sizeof(RegistroDiario) > d->limiteBytes;
+    pthread_mutex_unlock(&d->trava);
+    return compactar;
+}
+
+uint64_t diarioLsnAtual(const DiarioOperacoes *d) {
+    return d->ultimoLsn; // Só a thread principal atribui LSNs
+}
+
+int diarioSincronizar(DiarioOperacoes *d) {
+    pthread_mutex_lock(&d->trava);
+    uint64_t alvo = d->ultimoLsn;
+    if(d->lsnPedido < alvo)
+        d->lsnPedido = alvo;
+    pthread_cond_signal(&d->haTrabalho);
+    while(d->lsnDuravel < alvo && !d->falha)
+        pthread_cond_wait(&d->progresso, &d->trava);
+    int ok = !d->falha;
+    pthread_mutex_unlock(&d->trava);
+    return ok;
+}
+
+int diarioCompactar(DiarioOperacoes *d, const Mochila *m, int aguardar) {
+    pthread_mutex_lock(&d->trava);
+    while(aguardar && d->compactando)
+        pthread_cond_wait(&d->progresso, &d->trava);
+    if(d->compactando) {
+        pthread_mutex_unlock(&d->trava);
+        return 0;
+    }
+    pthread_mutex_unlock(&d->trava);
+
+    // Cópia em ordem de nome (lida do índice ordenado): o snapshot sai sem índice extra
+    Componente *copia = malloc((size_t)m->quantidade * sizeof(Componente) + 1);
+    if(copia == NULL)
+        return 0;
+    mochilaCopiarEmOrdemDeNome(m, copia);
+
+    pthread_mutex_lock(&d->trava);
+    long long concluidas = d->compactacoes;
+    d->copiaCompactacao = copia;
+    d->quantidadeCompactacao = m->quantidade;
+    d->lsnCompactacao = d->ultimoLsn;
+    d->compactando = 1;
+    pthread_cond_signal(&d->haTrabalho);
+    while(aguardar && d->compactando)
+        pthread_cond_wait(&d->progresso, &d->trava);
+    int ok = !aguardar || d->compactacoes > concluidas;
+    pthread_mutex_unlock(&d->trava);
+    return ok;
+}
+
+void diarioFechar(DiarioOperacoes *d, Mochila *m) {
+    pthread_mutex_lock(&d->trava);
+    d->encerrar = 1;
+    pthread_cond_signal(&d->haTrabalho);
+    pthread_mutex_unlock(&d->trava);
+    pthread_join(d->escritor, NULL); // Grava a fila e conclui uma compactação pendente antes de sair
+
+    close(d->fd);
+    d->fd = -1;
+    free(d->fila);
+    d->fila = NULL;
+    d->totalFila = d->capacidadeFila = 0;
+    pthread_mutex_destroy(&d->trava);
+    pthread_cond_destroy(&d->haTrabalho);
+    pthread_cond_destroy(&d->progresso);
+    if(m != NULL && m->diario == d)
+        m->diario = NULL;
+}
+
+/**
+ * @brief Exibe o estado do diário
+ *
+ * Formato:
+ * Diario 'x.wal': T KB (limite L KB) | LSN atual A, duravel D
+ * Recuperacao: R operacoes reaplicadas, I ja no snapshot, B bytes truncados em X ms (Y op/s)
+ * Group commit: O operacoes, F fsyncs (G op/fsync, maior grupo M)
+ * Compactacoes: C (ultima em X ms) | Amplificacao de escrita: W (G bytes gravados / L)
+ */
+void mostrarEstatisticasDiario(DiarioOperacoes *d) {
+    pthread_mutex_lock(&d->trava);
+    printf("Diario '%s': %.1f KB (limite %.1f KB) | LSN atual %llu, duravel %llu%s\n", d->caminhoDiario,
+           d->tamanhoArquivo / 1024.0, d->limiteBytes / 1024.0, (unsigned long long)d->ultimoLsn,
+           (unsigned long long)d->lsnDuravel, d->falha ? " | FALHA DE E/S" : "");
+    printf("Recuperacao: %lld operacoes reaplicadas, %lld ja no snapshot, %lld bytes truncados em %.3f ms (%.0f op/s)\n",
+           d->registrosReaplicados, d->registrosIgnorados, d->bytesDescartados, d->tempoReplayNs / 1e6,
+           d->tempoReplayNs > 0 ? (d->registrosReaplicados + d->registrosIgnorados) * 1e9 / d->tempoReplayNs : 0.0);
+    printf("Group commit: %lld operacoes, %lld fsyncs (%.1f op/fsync, maior grupo %lld)\n", d->operacoes,
+           d->sincronizacoes, d->sincronizacoes > 0 ? (double)d->operacoes / d->sincronizacoes : 0.0, d->maiorGrupo);
+    printf("Compactacoes: %lld (ultima em %.3f ms) | Amplificacao de escrita: %.2f (%lld bytes gravados / %lld)\n",
+           d->compactacoes, d->tempoCompactacaoNs / 1e6,
+           d->bytesLogicos > 0 ? (double)d->bytesGravados / d->bytesLogicos : 0.0, d->bytesGravados, d->bytesLogicos);
+    pthread_mutex_unlock(&d->trava);
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO MODO EM LOTE
+// ============================================================================
+
+/**
+ * @brief Copia um campo de texto removendo espaços nas pontas
+ * @param destino Buffer de destino (terminado em '\0')
+ * @param origem Início do campo (não precisa ser terminado em '\0')
+ * @param tamanho Número de caracteres do campo em origem
+ * @param capacidade Tamanho do buffer de destino (o campo é truncado se necessário)
+ */
+static void copiarCampo(char destino[], const char *origem, size_t tamanho, size_t capacidade) {
+    while(tamanho > 0 && (*origem == ' ' || *origem == '\t')) {
+        origem++;
+        tamanho--;
+    }
+    while(tamanho > 0 && (origem[tamanho - 1] == ' ' || origem[tamanho - 1] == '\t' || origem[tamanho - 1] == '\r'))
+        tamanho--;
+    if(tamanho >= capacidade)
+        tamanho = capacidade - 1;
+    memcpy(destino, origem, tamanho);
+    destino[tamanho] = '\0';
+}
+
+/**
+ * @brief Interpreta os argumentos "nome;tipo;quantidade;prioridade" do comando ADD
+ * @param args Texto após o comando
+ * @param c Componente preenchido (SAÍDA)
+ * @return 1 se os quatro campos foram lidos, 0 caso contrário
+ */
+static int lerComponenteLote(const char *args, Componente *c) {
+    const char *sep1 = strchr(args, ';');
+    const char *sep2 = sep1 ? strchr(sep1 + 1, ';') : NULL;
+    if(sep2 == NULL)
+        return 0;
+
+    copiarCampo(c->nome, args, (size_t)(sep1 - args), sizeof(c->nome));
+    copiarCampo(c->tipo, sep1 + 1, (size_t)(sep2 - sep1 - 1), sizeof(c->tipo));
+    if(sscanf(sep2 + 1, "%d ;%d", &c->quantidade, &c->prioridade) != 2)
+        return 0;
+    return c->nome[0] != '\0';
+}
+
+/**
+ * @brief Acrescenta um nome (sem espaços nas pontas; vazio é ignorado) à lista de FINDMANY/FINDMERGE
+ * @return 1 em caso de sucesso, 0 se faltou memória
+ */
+static int acrescentarNomeLote(char (**nomes)[MAX_STR_LEN], int *total, int *capacidade, const char *campo,
+                               size_t tamanho) {
+    char nome[MAX_STR_LEN];
+    copiarCampo(nome, campo, tamanho, sizeof(nome));
+    if(nome[0] == '\0')
+        return 1;
+    if(*total == *capacidade) {
+        int nova = *capacidade > 0 ? *capacidade * 2 : 64;
+        char(*maior)[MAX_STR_LEN] = realloc(*nomes, (size_t)nova * MAX_STR_LEN);
+        if(maior == NULL)
+            return 0;
+        *nomes = maior;
+        *capacidade = nova;
+    }
+    memcpy((*nomes)[(*total)++], nome, MAX_STR_LEN);
+    return 1;
+}
+
+/**
+ * @brief Lê os nomes de FINDMANY/FINDMERGE
+ * @param args "nome1;nome2;..." ou "@arquivo" (um nome por linha)
+ * @param nomes Vetor alocado com malloc (SAÍDA; liberar com free mesmo em caso de erro)
+ * @return Número de nomes lidos, ou -1 se o arquivo não abriu ou faltou memória
+ * @details A linha do lote tem no máximo MAX_LINHA_LOTE caracteres (algumas
+ *          centenas de nomes); com "@arquivo" o lote não tem limite de tamanho
+ */
+static int lerNomesLote(const char *args, char (**nomes)[MAX_STR_LEN]) {
+    int total = 0, capacidade = 0;
+    *nomes = NULL;
+    if(*args != '@') {
+        for(const char *campo = args;;) {
+            size_t tamanho = strcspn(campo, ";");
+            if(!acrescentarNomeLote(nomes, &total, &capacidade, campo, tamanho))
+                return -1;
+            if(campo[tamanho] == '\0')
+                return total;
+            campo += tamanho + 1;
+        }
+    }
+
+    char caminho[MAX_LINHA_LOTE], linha[MAX_LINHA_LOTE];
+    copiarCampo(caminho, args + 1, strlen(args + 1), sizeof(caminho));
+    FILE *arquivo = fopen(caminho, "r");
+    if(arquivo == NULL) {
+        fprintf(stderr, "[ERRO] Nao foi possivel abrir '%s'.\n", caminho);
+        return -1;
+    }
+    while(fgets(linha, sizeof(linha), arquivo) != NULL) {
+        if(!acrescentarNomeLote(nomes, &total, &capacidade, linha, strcspn(linha, "\n"))) {
+            total = -1;
+            break;
+        }
+    }
+    fclose(arquivo);
+    return total;
+}
+
+/**
+ * @brief Executa um comando do modo em lote sobre a mochila
+ * @param linha Linha de comando sem o '\n' final (MODIFICADA durante a análise)
+ * @param m Mochila
+ * @param est Estatísticas agregadas
+ *
+ * Reaproveita exatamente as mesmas funções do menu interativo
+ * (adicionarComponente, descartarComponente, algoritmos de ordenação e
+ * buscaBinariaPorNome), apenas sem prompts nem tabelas intermediárias.
+ */
+void executarComandoLote(char linha[], Mochila *m, EstatisticasLote *est) {
+    char nome[MAX_STR_LEN];
+    char *cmd = linha;
+
+    while(*cmd == ' ' || *cmd == '\t')
+        cmd++;
+    if(*cmd == '\0' || *cmd == '#' || *cmd == '\r')
+        return; // Linha vazia ou comentário
+
+    // Separa o comando (primeira palavra) dos argumentos
+    char *args = cmd + strcspn(cmd, " \t\r");
+    if(*args != '\0')
+        *args++ = '\0';
+
+    if(strcasecmp(cmd, "ADD") == 0) {
+        Componente novo;
+        if(!lerComponenteLote(args, &novo)) {
+            est->invalidas++;
+            return;
+        }
+        est->adicoes++;
+        if(adicionarComponente(m, &novo))
+            m->ordenadaPorNome = 0; // Novo componente desordena a lista
+        else
+            est->falhas++;
+    } else if(strcasecmp(cmd, "DEL") == 0) {
+        copiarCampo(nome, args, strlen(args), sizeof(nome));
+        est->descartes++;
+        if(descartarComponente(m, nome))
+            m->ordenadaPorNome = 0;
+        else
+            est->falhas++;
+    } else if(strcasecmp(cmd, "SORT") == 0) {
+        // SORT <criterio> [algoritmo|AUTO] - algoritmo padrão: CLASSICO
+        char criterioTxt[MAX_STR_LEN] = "", algoritmoTxt[MAX_STR_LEN] = "";
+        CriterioOrdenacao criterio;
+        AlgoritmoOrdenacao algoritmo = ALGORITMO_CLASSICO;
+        int automatico = 0;
+        sscanf(args, "%29s %29s", criterioTxt, algoritmoTxt);
+
+        if(strcasecmp(criterioTxt, "NOME") == 0)
+            criterio = CRITERIO_NOME;
+        else if(strcasecmp(criterioTxt, "TIPO") == 0)
+            criterio = CRITERIO_TIPO;
+        else if(strcasecmp(criterioTxt, "PRIORIDADE") == 0)
+            criterio = CRITERIO_PRIORIDADE;
+        else {
+            est->invalidas++;
+            return;
+        }
+        if(strcasecmp(algoritmoTxt, "AUTO") == 0)
+            automatico = 1;
+        else if(algoritmoTxt[0] != '\0' && !algoritmoPorNome(algoritmoTxt, &algoritmo)) {
+            est->invalidas++;
+            return;
+        }
+        if(automatico) {
+            est->escolhasAutomaticas[ordenarAutomatico(m->itens, m->quantidade, criterio)]++;
+            m->ordenadaPorNome = criterio == CRITERIO_NOME;
+            mochilaReindexar(m);
+        } else if(algoritmo == ALGORITMO_CONTAGEM && criterio == CRITERIO_TIPO) {
+            if(!mochilaOrdenarPorTipo(m)) { // Usa os ids de tipo da inserção
+                est->falhas++;
+                return;
+            }
+        } else {
+            ordenarComponentes(m->itens, m->quantidade, algoritmo, criterio);
+            m->ordenadaPorNome = criterio == CRITERIO_NOME;
+            mochilaReindexar(m);
+        }
+        est->ordenacoes++;
+    } else if(strcasecmp(cmd, "SORTBY") == 0) {
+        // SORTBY tipo asc, prioridade desc, nome asc - uma passada estável do TimSort
+        EspecificacaoOrdenacao espec;
+        if(!especificacaoPorTexto(args, &espec)) {
+            est->invalidas++;
+            return;
+        }
+        ordenarPorEspecificacao(m->itens, m->quantidade, &espec);
+        m->ordenadaPorNome = espec.chaves[0].campo == CRITERIO_NOME && !espec.chaves[0].decrescente;
+        mochilaReindexar(m);
+        est->ordenacoes++;
+    } else if(strcasecmp(cmd, "FIND") == 0) {
+        copiarCampo(nome, args, strlen(args), sizeof(nome));
+        est->buscas++;
+        // Ordenada por nome: layout de Eytzinger (construído uma vez, reaproveitado
+        // pelos FIND seguintes até a próxima mutação); senão, índice hash
+        int pos = m->ordenadaPorNome ? mochilaBuscaEytzinger(m, nome) : mochilaBuscarPorNome(m, nome);
+        if(pos != -1)
+            est->encontrados++;
+    } else if(strcasecmp(cmd, "FINDMANY") == 0 || strcasecmp(cmd, "FINDMERGE") == 0) {
+        // FINDMANY n1;n2;... - com a mochila ordenada por nome, as buscas
+        // binárias são divididas entre as threads; senão, índice hash (serial).
+        // FINDMERGE ordena os nomes e resolve todos em uma passada pelo vetor
+        // "@arquivo" lê um nome por linha: lotes de milhares de nomes não cabem numa linha
+        int passadaUnica = strcasecmp(cmd, "FINDMERGE") == 0;
+        char (*nomes)[MAX_STR_LEN];
+        int total = lerNomesLote(args, &nomes);
+        int *resultados = total > 0 ? malloc((size_t)total * sizeof(int)) : NULL;
+        if(total < 0 || (total > 0 && resultados == NULL)) {
+            free(nomes);
+            free(resultados);
+            est->falhas++;
+            return;
+        }
+        if(total == 0) {
+            est->invalidas++;
+        } else if(m->ordenadaPorNome && passadaUnica) {
+            int encontrados = buscaEmLotePorNome(m->itens, m->quantidade, nomes, total, resultados);
+            if(encontrados < 0)
+                est->falhas++;
+            else
+                est->encontrados += encontrados;
+        } else if(m->ordenadaPorNome) {
+            est->encontrados += buscaBinariaParalela(m->itens, m->quantidade, nomes, total, resultados);
+        } else {
+            for(int q = 0; q < total; q++)
+                if(mochilaBuscarPorNome(m, nomes[q]) != -1)
+                    est->encontrados++;
+        }
+        est->buscas += total;
+        free(nomes);
+        free(resultados);
+    } else if(strcasecmp(cmd, "RANGE") == 0) {
+        // RANGE de;ate - intervalo inclusivo de nomes via índice ordenado
+        char ate[MAX_STR_LEN];
+        const char *sep = strchr(args, ';');
+        if(sep == NULL) {
+            est->invalidas++;
+            return;
+        }
+        copiarCampo(nome, args, (size_t)(sep - args), sizeof(nome));
+        copiarCampo(ate, sep + 1, strlen(sep + 1), sizeof(ate));
+        int total;
+        free(mochilaBuscarIntervalo(m, nome, ate, &total));
+        est->intervalos++;
+        est->resultadosIntervalo += total;
+    } else if(strcasecmp(cmd, "PREFIX") == 0 || strcasecmp(cmd, "FUZZY") == 0) {
+        // PREFIX prefixo[;k] (k = 0: todos; padrão 10) | FUZZY nome[;d] (padrão d = 2)
+        int prefixo = strcasecmp(cmd, "PREFIX") == 0;
+        int parametro = prefixo ? 10 : DISTANCIA_APROXIMADA_MAXIMA, total = 0;
+        const char *sep = strchr(args, ';');
+        copiarCampo(nome, args, sep != NULL ? (size_t)(sep - args) : strlen(args), sizeof(nome));
+        if((sep != NULL && sscanf(sep + 1, "%d", &parametro) != 1) || parametro < 0 ||
+           (!prefixo && (nome[0] == '\0' || parametro > DISTANCIA_APROXIMADA_MAXIMA))) {
+            est->invalidas++;
+            return;
+        }
+        if(prefixo)
+            free(mochilaBuscarPorPrefixo(m, nome, parametro, &total, NULL));
+        else
+            free(mochilaBuscarAproximado(m, nome, parametro, 0, &total));
+        est->consultasAproximadas++;
+        est->sugestoes += total;
+    } else if(strcasecmp(cmd, "SAVE") == 0 || strcasecmp(cmd, "LOAD") == 0) {
+        char arquivo[MAX_LINHA_LOTE];
+        copiarCampo(arquivo, args, strlen(args), sizeof(arquivo));
+        if(arquivo[0] == '\0') {
+            est->invalidas++;
+            return;
+        }
+        est->snapshots++;
+        int ok = strcasecmp(cmd, "SAVE") == 0 ? mochilaSalvar(m, arquivo) : mochilaCarregar(m, arquivo);
+        if(!ok)
+            est->falhas++;
+    } else if(strcasecmp(cmd, "IMPORT") == 0 || strcasecmp(cmd, "EXPORT") == 0) {
+        char arquivo[MAX_LINHA_LOTE];
+        EstatisticasTransferencia transf;
+        copiarCampo(arquivo, args, strlen(args), sizeof(arquivo));
+        if(arquivo[0] == '\0') {
+            est->invalidas++;
+            return;
+        }
+        est->transferencias++;
+        if(strcasecmp(cmd, "IMPORT") == 0) {
+            if(!mochilaImportar(m, arquivo, formatoPorCaminho(arquivo), &transf))
+                est->falhas++;
+            else if(transf.registros > 0)
+                m->ordenadaPorNome = 0;
+            est->importacao.bytes += transf.bytes;
+            est->importacao.registros += transf.registros;
+            est->importacao.rejeitados += transf.rejeitados;
+            est->importacao.recusados += transf.recusados;
+            est->importacao.tempoNs += transf.tempoNs;
+        } else if(!mochilaExportar(m, arquivo, formatoPorCaminho(arquivo), &transf)) {
+            est->falhas++;
+        }
+    } else if(strcasecmp(cmd, "TOPK") == 0) {
+        int k, total;
+        if(sscanf(args, "%d", &k) != 1 || k < 0) {
+            est->invalidas++;
+            return;
+        }
+        free(mochilaTopK(m, k, &total));
+        est->consultasTopK++;
+    } else if(strcasecmp(cmd, "POP") == 0) {
+        Componente retirado;
+        est->retiradas++;
+        if(mochilaRetirarMaisUrgente(m, &retirado))
+            m->ordenadaPorNome = 0;
+        else
+            est->falhas++;
+    } else if(strcasecmp(cmd, "TYPE") == 0) {
+        Componente filtro; // Mesmo corte e limpeza de espaços do tipo no ADD
+        int total;
+        copiarCampo(filtro.tipo, args, strlen(args), sizeof(filtro.tipo));
+        mochilaBuscarPorTipo(m, filtro.tipo, &total, NULL);
+        est->consultasSecundarias++;
+        est->resultadosSecundarios += total;
+    } else if(strcasecmp(cmd, "PRIORANGE") == 0) {
+        int minimo, maximo, total;
+        if(sscanf(args, "%d ;%d", &minimo, &maximo) != 2) {
+            est->invalidas++;
+            return;
+        }
+        free(mochilaBuscarFaixaPrioridade(m, minimo, maximo, &total));
+        est->consultasSecundarias++;
+        est->resultadosSecundarios += total;
+    } else if(strcasecmp(cmd, "TOTALS") == 0) {
+        est->consultasSecundarias++;
+        mostrarTotaisPorTipo(m);
+    } else if(strcasecmp(cmd, "SYNC") == 0 || strcasecmp(cmd, "COMPACT") == 0) {
+        // SYNC: operações anteriores em disco | COMPACT: snapshot de base + diário só com o que vier depois
+        est->comandosDiario++;
+        if(m->diario == NULL)
+            est->falhas++;
+        else if(!(strcasecmp(cmd, "SYNC") == 0 ? diarioSincronizar(m->diario) : diarioCompactar(m->diario, m, 1)))
+            est->falhas++;
+    } else if(strcasecmp(cmd, "METRICS") == 0) {
+        // METRICS [arquivo]: sem arquivo, texto do Prometheus na saída padrão
+        char arquivo[MAX_LINHA_LOTE];
+        copiarCampo(arquivo, args, strlen(args), sizeof(arquivo));
+        if(!metricasGravar(arquivo[0] != '\0' ? arquivo : "-"))
+            est->falhas++;
+    } else if(strcasecmp(cmd, "LIST") == 0) {
+        // LIST [inicio [quantidade]] - linhas a partir de 1; sem argumentos respeita --listar-max
+        int inicio = 1, quantidade = limiteListagem;
+        if(sscanf(args, "%d %d", &inicio, &quantidade) >= 1 && (inicio < 1 || quantidade < 0)) {
+            est->invalidas++;
+            return;
+        }
+        EstatisticasListagem custo;
+        est->listagens++;
+        mostrarComponentesPagina(m->itens, m->quantidade, inicio - 1, quantidade, &custo);
+        est->linhasListadas += custo.linhas;
+        est->tempoListagemNs += custo.tempoNs;
+    } else {
+        est->invalidas++;
+    }
+}
+
+/**
+ * @brief Modo não interativo: executa um fluxo de comandos de ponta a ponta
+ * @param caminho Arquivo de comandos, ou NULL / "-" para stdin
+ * @param limite Limite de componentes (0 = sem limite)
+ * @param snapshotInicial Snapshot carregado antes do primeiro comando (NULL = mochila vazia)
+ * @return 0 em caso de sucesso, 1 se um dos arquivos não pôde ser aberto
+ *
+ * Exemplo de arquivo:
+ *   ADD chip central;Eletronico;1;10
+ *   ADD antena;Eletronico;2;7
+ *   SORT NOME
+ *   FIND antena
+ *   DEL antena
+ */
+int executarLote(const char caminho[], int limite, const char snapshotInicial[], const ConfiguracaoDiario *configDiario) {
+    FILE *entrada = stdin;
+    if(caminho != NULL && strcmp(caminho, "-") != 0) {
+        entrada = fopen(caminho, "r");
+        if(entrada == NULL) {
+            fprintf(stderr, "[ERRO] Nao foi possivel abrir '%s'.\n", caminho);
+            return 1;
+        }
+    }
+
+    Mochila mochila;
+    EstatisticasLote est = {0};
+    char linha[MAX_LINHA_LOTE];
+    Medicao med; // Tempo real (vazão), tempo de CPU e contadores do lote inteiro
+    DiarioOperacoes diario; // Usado só com --diario
+
+    setvbuf(entrada, NULL, _IOFBF, 1 << 16); // Leitura em blocos de 64 KB
+    modoSilencioso = 1;                      // Sem telemetria por operação
+    mochilaIniciar(&mochila, limite);
+    if((configDiario != NULL && configDiario->base != NULL &&
+        !diarioAbrir(&diario, &mochila, configDiario->base, configDiario->grupo, configDiario->intervaloMs,
+                     configDiario->limiteBytes)) ||
+       (snapshotInicial != NULL && !mochilaCarregar(&mochila, snapshotInicial))) {
+        if(mochila.diario != NULL)
+            diarioFechar(&diario, &mochila);
+        mochilaLiberar(&mochila);
+        if(entrada != stdin)
+            fclose(entrada);
+        return 1;
+    }
+    medicaoIniciar(&med);
+
+    while(fgets(linha, sizeof(linha), entrada) != NULL) {
+        est.linhas++;
+        size_t tamanho = strcspn(linha, "\n");
+        if(linha[tamanho] == '\0' && !feof(entrada)) {
+            // Linha maior que o buffer: descarta o restante em vez de executá-lo como outro comando
+            int c;
+            while((c = fgetc(entrada)) != EOF && c != '\n')
+                ;
+            fprintf(stderr, "[ERRO] Linha %lld com mais de %d caracteres ignorada.\n", est.linhas, MAX_LINHA_LOTE - 2);
+            est.invalidas++;
+            continue;
+        }
+        linha[tamanho] = 0;
+        executarComandoLote(linha, &mochila, &est);
+    }
+    if(mochila.diario != NULL && !diarioSincronizar(mochila.diario))
+        est.falhas++; // A vazão só conta operações duráveis
+
+    medicaoFinalizar(&med);
+    double decorrido = med.tempoParedeNs / 1e9;
+    modoSilencioso = 0;
+    if(entrada != stdin)
+        fclose(entrada);
+
+    // Relatório agregado
+    long long operacoes = est.adicoes + est.descartes + est.ordenacoes + est.buscas + est.listagens + est.intervalos +
+                          est.snapshots + est.transferencias + est.consultasTopK + est.retiradas +
+                          est.consultasSecundarias + est.comandosDiario + est.consultasAproximadas;
+    printf("\n=== RELATORIO DO MODO EM LOTE ===\n");
+    printf("Linhas lidas: %lld | Invalidas: %lld\n", est.linhas, est.invalidas);
+    printf("ADD: %lld | DEL: %lld | SORT: %lld | FIND: %lld (encontrados: %lld) | LIST: %lld\n",
+           est.adicoes, est.descartes, est.ordenacoes, est.buscas, est.encontrados, est.listagens);
+    printf("RANGE: %lld (componentes retornados: %lld) | SAVE/LOAD: %lld\n", est.intervalos, est.resultadosIntervalo,
+           est.snapshots);
+    if(est.consultasAproximadas > 0)
+        printf("PREFIX/FUZZY: %lld (nomes retornados: %lld)\n", est.consultasAproximadas, est.sugestoes);
+    printf("IMPORT/EXPORT: %lld | TOPK: %lld | POP: %lld | SYNC/COMPACT: %lld\n", est.transferencias,
+           est.consultasTopK, est.retiradas, est.comandosDiario);
+    if(est.linhasListadas > 0)
+        printf("Listagem: %lld linhas em %.3f ms (%.0f linhas/s)\n", est.linhasListadas, est.tempoListagemNs / 1e6,
+               est.tempoListagemNs > 0 ? est.linhasListadas * 1e9 / est.tempoListagemNs : 0.0);
+    printf("TYPE/PRIORANGE/TOTALS: %lld (componentes retornados: %lld)\n", est.consultasSecundarias,
+           est.resultadosSecundarios);
+    int escolhas = 0;
+    for(int a = 0; a < TOTAL_ALGORITMOS; a++)
+        if(est.escolhasAutomaticas[a] > 0)
+            printf("%s%s: %lld", escolhas++ ? " | " : "SORT AUTO escolheu: ", nomeAlgoritmo((AlgoritmoOrdenacao)a),
+                   est.escolhasAutomaticas[a]);
+    if(escolhas > 0)
+        printf("\n");
+    if(est.importacao.bytes > 0)
+        mostrarEstatisticasTransferencia("Importacao", &est.importacao);
+    printf("Operacoes rejeitadas: %lld\n", est.falhas);
+    printf("Itens na mochila ao final: %d\n", mochila.quantidade);
+    mostrarUsoMemoria(&mochila);
+    mostrarEstatisticasHash(&mochila.indiceNome);
+    mostrarCustoIndiceOrdenado(&mochila.ordemNome);
+    mostrarCustoIndiceSecundario(&mochila.porTipo);
+    mostrarCustoIndiceSecundario(&mochila.porPrioridade);
+    printf("Tempo total: %.6f segundos\n", decorrido);
+    mostrarMedicao(&med);
+    printf("Vazao: %.0f operacoes/segundo\n", decorrido > 0 ? operacoes / decorrido : 0.0);
+    if(mochila.diario != NULL) {
+        mostrarEstatisticasDiario(mochila.diario);
+        diarioFechar(&diario, &mochila);
+    }
+    printf("=================================\n");
+    mochilaLiberar(&mochila);
+    return 0;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DA IMPORTAÇÃO E EXPORTAÇÃO EM FLUXO
+// ============================================================================
+
+/**
+ * @brief Deduz o formato pela extensão do arquivo
+ */
+FormatoArquivo formatoPorCaminho(const char caminho[]) {
+    const char *ponto = strrchr(caminho, '.');
+    if(ponto != NULL && (strcasecmp(ponto, ".jsonl") == 0 || strcasecmp(ponto, ".json") == 0))
+        return ARQUIVO_JSONL;
+    return ARQUIVO_CSV;
+}
+
+/**
+ * @brief Converte um campo numérico (espaços nas pontas permitidos)
+ * @return 1 se o campo inteiro é um int válido, 0 caso contrário
+ */
+static int lerInteiroCampo(const char *texto, int *valor) {
+    char *fim;
+    long v = strtol(texto, &fim, 10);
+    while(*fim == ' ' || *fim == '\t')
+        fim++;
+    if(fim == texto || *fim != '\0' || v < -2147483647L - 1 || v > 2147483647L)
+        return 0;
+    *valor = (int)v;
+    return 1;
+}
+
+/**
+ * @brief Separa uma linha CSV em campos, no próprio buffer
+ * @param linha Linha terminada em '\0' (MODIFICADA: separadores viram '\0', aspas são removidas)
+ * @param campos Início de cada campo (SAÍDA)
+ * @param maximo Capacidade de campos
+ * @return Número de campos, ou -1 se uma aspa não foi fechada
+ * @details Campos entre aspas podem conter vírgulas; "" dentro das aspas é uma aspa literal
+ */
+static int separarCamposCsv(char *linha, char *campos[], int maximo) {
+    int total = 0;
+    char *leitura = linha;
+    while(total < maximo) {
+        while(*leitura == ' ' || *leitura == '\t')
+            leitura++;
+        char *escrita = leitura;
+        campos[total++] = escrita;
+        if(*leitura == '"') {
+            campos[total - 1] = ++leitura;
+            escrita = leitura;
+            for(;;) {
+                if(*leitura == '\0')
+                    return -1;
+                if(*leitura == '"') {
+                    if(leitura[1] != '"')
+                        break;
+                    leitura++; // "" => "
+                }
+                *escrita++ = *leitura++;
+            }
+            leitura++; // Aspa de fechamento
+            while(*leitura != ',' && *leitura != '\0')
+                leitura++; // Ignora o que vier entre a aspa e a vírgula
+        } else {
+            while(*leitura != ',' && *leitura != '\0')
+                *escrita++ = *leitura++;
+        }
+        char separador = *leitura;
+        *escrita = '\0';
+        if(separador == '\0')
+            break;
+        leitura++;
+    }
+    return total;
+}
+
+/**
+ * @brief Lê uma string JSON a partir da aspa de abertura
+ * @param p Posição da aspa de abertura
+ * @param destino Buffer (truncado em capacidade - 1 bytes); NULL para apenas pular
+ * @return Posição após a aspa de fechamento, ou NULL se malformada
+ * @details Escapes \" \\ \/ \b \f \n \r \t; \uXXXX vira o caractere se ASCII, senão '?'
+ */
+static const char *lerStringJson(const char *p, char destino[], size_t capacidade) {
+    size_t usados = 0;
+    for(p++; *p != '"'; p++) {
+        char c = *p;
+        if(c == '\0')
+            return NULL;
+        if(c == '\\') {
+            p++;
+            switch(*p) {
+            case 'b': c = '\b'; break;
+            case 'f': c = '\f'; break;
+            case 'n': c = '\n'; break;
+            case 'r': c = '\r'; break;
+            case 't': c = '\t'; break;
+            case 'u': {
+                unsigned codigo = 0;
+                for(int i = 1; i <= 4; i++) {
+                    char h = p[i];
+                    if(h >= '0' && h <= '9')
+                        codigo = codigo * 16 + (unsigned)(h - '0');
+                    else if((h | 0x20) >= 'a' && (h | 0x20) <= 'f')
+                        codigo = codigo * 16 + (unsigned)((h | 0x20) - 'a' + 10);
+                    else
+                        return NULL;
+                }
+                p += 4;
+                c = codigo < 0x80 ? (char)codigo : '?';
+                break;
+            }
+            case '"': case '\\': case '/': c = *p; break;
+            default: return NULL;
+            }
+        }
+        if(destino != NULL && usados + 1 < capacidade)
+            destino[usados++] = c;
+    }
+    if(destino != NULL)
+        destino[usados] = '\0';
+    return p + 1;
+}
+
+/** @brief Pula espaços em branco de JSON */
+static const char *pularEspacosJson(const char *p) {
+    while(*p == ' ' || *p == '\t' || *p == '\r')
+        p++;
+    return p;
+}
+
+/**
+ * @brief Interpreta um objeto JSON de uma linha como Componente
+ * @return 1 se os quatro campos foram encontrados e válidos, 0 caso contrário
+ * @details Ordem dos campos livre; campos desconhecidos (string, número,
+ *          true/false/null) são ignorados
+ */
+static int lerObjetoJson(const char *p, Componente *c) {
+    int encontrados = 0; // Bits: 1 nome, 2 tipo, 4 quantidade, 8 prioridade
+    p = pularEspacosJson(p);
+    if(*p++ != '{')
+        return 0;
+    p = pularEspacosJson(p);
+    if(*p == '}')
+        return 0;
+    for(;;) {
+        char chave[16];
+        if(*p != '"' || (p = lerStringJson(p, chave, sizeof(chave))) == NULL)
+            return 0;
+        p = pularEspacosJson(p);
+        if(*p++ != ':')
+            return 0;
+        p = pularEspacosJson(p);
+
+        if(*p == '"') {
+            char *destino = NULL;
+            size_t capacidade = 0;
+            if(strcmp(chave, "nome") == 0) {
+                destino = c->nome, capacidade = sizeof(c->nome), encontrados |= 1;
+            } else if(strcmp(chave, "tipo") == 0) {
+                destino = c->tipo, capacidade = sizeof(c->tipo), encontrados |= 2;
+            }
+            if((p = lerStringJson(p, destino, capacidade)) == NULL)
+                return 0;
+        } else {
+            char *fim;
+            long v = strtol(p, &fim, 10);
+            if(fim == p) { // true, false, null ou inválido
+                while(*fim != ',' && *fim != '}' && *fim != '\0')
+                    fim++;
+            } else if(strcmp(chave, "quantidade") == 0 && v >= -2147483647L - 1 && v <= 2147483647L) {
+                c->quantidade = (int)v, encontrados |= 4;
+            } else if(strcmp(chave, "prioridade") == 0 && v >= -2147483647L - 1 && v <= 2147483647L) {
+                c->prioridade = (int)v, encontrados |= 8;
+            }
+            p = fim;
+        }
+        p = pularEspacosJson(p);
+        if(*p == '}')
+            break;
+        if(*p++ != ',')
+            return 0;
+        p = pularEspacosJson(p);
+    }
+    return encontrados == 15 && c->nome[0] != '\0';
+}
+
+/**
+ * @brief Interpreta uma linha (terminada em '\0', sem '\n') e adiciona o componente
+ * @param primeira 1 na primeira linha do arquivo (cabeçalho CSV é ignorado)
+ */
+static void importarLinha(Mochila *m, char *linha, size_t tamanho, FormatoArquivo formato, int primeira,
+                          EstatisticasTransferencia *est) {
+    if(tamanho > 0 && linha[tamanho - 1] == '\r')
+        linha[--tamanho] = '\0';
+    if(tamanho == 0)
+        return; // Linha vazia
+
+    Componente novo;
+    memset(&novo, 0, sizeof(novo));
+    if(formato == ARQUIVO_JSONL) {
+        if(!lerObjetoJson(linha, &novo)) {
+            est->rejeitados++;
+            return;
+        }
+    } else {
+        char *campos[5];
+        int total = separarCamposCsv(linha, campos, 5);
+        if(primeira && total >= 1 && strncasecmp(campos[0], "nome", 4) == 0)
+            return; // Cabeçalho
+        if(total != 4 || !lerInteiroCampo(campos[2], &novo.quantidade) ||
+           !lerInteiroCampo(campos[3], &novo.prioridade)) {
+            est->rejeitados++;
+            return;
+        }
+        copiarCampo(novo.nome, campos[0], strlen(campos[0]), sizeof(novo.nome));
+        copiarCampo(novo.tipo, campos[1], strlen(campos[1]), sizeof(novo.tipo));
+        if(novo.nome[0] == '\0') {
+            est->rejeitados++;
+            return;
+        }
+    }
+    if(adicionarComponente(m, &novo))
+        est->registros++;
+    else
+        est->recusados++;
+}
+
+/**
+ * @brief Importa componentes de CSV ou JSON Lines em blocos de tamanho fixo
+ *
+ * Algoritmo:
+ * - fread de até TAM_BLOCO_ES bytes após o resto da linha incompleta do bloco anterior
+ * - memchr localiza cada '\n'; a linha é processada no próprio bloco
+ * - A linha incompleta no fim do bloco é movida para o início (memmove)
+ * - Uma linha maior que o bloco inteiro é descartada (conta como rejeitada)
+ *
+ * Memória: um bloco de 1 MB, independentemente do tamanho do arquivo.
+ */
+int mochilaImportar(Mochila *m, const char caminho[], FormatoArquivo formato, EstatisticasTransferencia *est) {
+    memset(est, 0, sizeof(*est));
+    FILE *entrada = strcmp(caminho, "-") == 0 ? stdin : fopen(caminho, "rb");
+    char *bloco = malloc(TAM_BLOCO_ES + 1);
+    if(entrada == NULL || bloco == NULL) {
+        fprintf(stderr, "[ERRO] Nao foi possivel abrir '%s'.\n", caminho);
+        if(entrada != NULL && entrada != stdin)
+            fclose(entrada);
+        free(bloco);
+        return 0;
+    }
+
+    Medicao med;
+    medicaoIniciar(&med);
+    size_t pendente = 0;      // Bytes da linha incompleta no início do bloco
+    int descartandoLinha = 0; // Dentro de uma linha maior que o bloco
+    int primeira = 1;
+    int ok = 1;
+    for(;;) {
+        size_t pedidos = TAM_BLOCO_ES - pendente;
+        size_t lidos = fread(bloco + pendente, 1, pedidos, entrada);
+        est->bytes += (long long)lidos;
+        char *inicio = bloco, *fim = bloco + pendente + lidos;
+
+        char *quebra;
+        while((quebra = memchr(inicio, '\n', (size_t)(fim - inicio))) != NULL) {
+            *quebra = '\0';
+            if(descartandoLinha)
+                descartandoLinha = 0;
+            else
+                importarLinha(m, inicio, (size_t)(quebra - inicio), formato, primeira, est);
+            primeira = 0;
+            inicio = quebra + 1;
+        }
+        pendente = (size_t)(fim - inicio);
+
+        if(lidos < pedidos) { // Fim do arquivo (ou erro)
+            ok = !ferror(entrada);
+            if(pendente > 0 && !descartandoLinha) {
+                inicio[pendente] = '\0'; // Há TAM_BLOCO_ES + 1 bytes no bloco
+                importarLinha(m, inicio, pendente, formato, primeira, est);
+            }
+            break;
+        }
+        if(pendente == TAM_BLOCO_ES) { // Nenhuma quebra no bloco inteiro
+            if(!descartandoLinha)
+                est->rejeitados++;
+            descartandoLinha = 1;
+            pendente = 0;
+        } else {
+            memmove(bloco, inicio, pendente);
+        }
+    }
+    medicaoFinalizar(&med);
+    est->tempoNs = med.tempoParedeNs;
+
+    free(bloco);
+    if(entrada != stdin)
+        fclose(entrada);
+    if(!ok)
+        fprintf(stderr, "[ERRO] Falha de leitura em '%s'.\n", caminho);
+    return ok;
+}
+
+/**
+ * @brief Copia um texto para o formato CSV (entre aspas se necessário)
+ * @return Bytes escritos em destino (destino precisa de 2 × strlen + 3 bytes)
+ */
+static size_t formatarCampoCsv(char *destino, const char texto[]) {
+    size_t tamanho = strlen(texto);
+    int aspas = strpbrk(texto, ",\"\r\n") != NULL ||
+                (tamanho > 0 && (texto[0] == ' ' || texto[tamanho - 1] == ' '));
+    char *p = destino;
+    if(aspas)
+        *p++ = '"';
+    for(const char *t = texto; *t != '\0'; t++) {
+        if(*t == '"')
+            *p++ = '"';
+        *p++ = *t;
+    }
+    if(aspas)
+        *p++ = '"';
+    return (size_t)(p - destino);
+}
+
+/**
+ * @brief Copia um texto como string JSON (com aspas e escapes)
+ * @return Bytes escritos em destino (destino precisa de 6 × strlen + 3 bytes)
+ */
+static size_t formatarStringJson(char *destino, const char texto[]) {
+    char *p = destino;
+    *p++ = '"';
+    for(const unsigned char *t = (const unsigned char *)texto; *t != '\0'; t++) {
+        if(*t == '"' || *t == '\\') {
+            *p++ = '\\';
+            *p++ = (char)*t;
+        } else if(*t < 0x20) {
+            p += sprintf(p, "\\u%04x", *t);
+        } else {
+            *p++ = (char)*t;
+        }
+    }
+    *p++ = '"';
+    return (size_t)(p - destino);
+}
+
+/**
+ * @brief Exporta a mochila em blocos de tamanho fixo
+ * @details Cada registro é formatado direto no bloco; quando o próximo
+ *          registro não cabe, o bloco é gravado com um único fwrite
+ */
+int mochilaExportar(const Mochila *m, const char caminho[], FormatoArquivo formato, EstatisticasTransferencia *est) {
+    memset(est, 0, sizeof(*est));
+    FILE *saida = strcmp(caminho, "-") == 0 ? stdout : fopen(caminho, "wb");
+    char *bloco = malloc(TAM_BLOCO_ES);
+    if(saida == NULL || bloco == NULL) {
+        fprintf(stderr, "[ERRO] Nao foi possivel criar '%s'.\n", caminho);
+        if(saida != NULL && saida != stdout)
+            fclose(saida);
+        free(bloco);
+        return 0;
+    }
+
+    // Pior caso de um registro: textos com todos os caracteres escapados
+    const size_t maiorRegistro = 6 * (sizeof(m->itens->nome) + sizeof(m->itens->tipo)) + 128;
+    Medicao med;
+    medicaoIniciar(&med);
+    size_t usados = 0;
+    int ok = 1;
+    if(formato == ARQUIVO_CSV)
+        usados = (size_t)sprintf(bloco, "nome,tipo,quantidade,prioridade\n");
+    for(int i = 0; ok && i < m->quantidade; i++) {
+        if(TAM_BLOCO_ES - usados < maiorRegistro) {
+            ok = fwrite(bloco, 1, usados, saida) == usados;
+            est->bytes += (long long)usados;
+            usados = 0;
+        }
+        const Componente *c = &m->itens[i];
+        char *p = bloco + usados;
+        if(formato == ARQUIVO_CSV) {
+            p += formatarCampoCsv(p, c->nome);
+            *p++ = ',';
+            p += formatarCampoCsv(p, c->tipo);
+            p += sprintf(p, ",%d,%d\n", c->quantidade, c->prioridade);
+        } else {
+            p += sprintf(p, "{\"nome\": ");
+            p += formatarStringJson(p, c->nome);
+            p += sprintf(p, ", \"tipo\": ");
+            p += formatarStringJson(p, c->tipo);
+            p += sprintf(p, ", \"quantidade\": %d, \"prioridade\": %d}\n", c->quantidade, c->prioridade);
+        }
+        usados = (size_t)(p - bloco);
+        est->registros++;
+    }
+    ok = ok && fwrite(bloco, 1, usados, saida) == usados;
+    est->bytes += (long long)usados;
+    ok = fflush(saida) == 0 && ok;
+    if(saida != stdout)
+        ok = fclose(saida) == 0 && ok;
+    medicaoFinalizar(&med);
+    est->tempoNs = med.tempoParedeNs;
+    free(bloco);
+    if(!ok)
+        fprintf(stderr, "[ERRO] Falha ao gravar '%s'.\n", caminho);
+    return ok;
+}
+
+/**
+ * @brief Exibe o resultado de uma importação/exportação
+ *
+ * Formato:
+ * [Importacao] R registros | B MB em T s -> X MB/s | Y registros/s
+ * -> Linhas rejeitadas: N | recusadas pela mochila: M
+ */
+void mostrarEstatisticasTransferencia(const char operacao[], const EstatisticasTransferencia *est) {
+    double segundos = est->tempoNs / 1e9;
+    double megabytes = est->bytes / (1024.0 * 1024.0);
+    printf("\n[%s] %lld registros | %.2f MB em %.6f s -> %.1f MB/s | %.0f registros/s\n", operacao, est->registros,
+           megabytes, segundos, segundos > 0 ? megabytes / segundos : 0.0,
+           segundos > 0 ? est->registros / segundos : 0.0);
+    if(est->rejeitados > 0 || est->recusados > 0)
+        printf("-> Linhas rejeitadas: %lld | recusadas pela mochila (limite/memoria): %lld\n", est->rejeitados,
+               est->recusados);
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DOS KERNELS DE COMPARAÇÃO (SIMD)
+// ============================================================================
+
+// Os kernels leem blocos inteiros a partir de nome/tipo: garante que isso não sai do Componente
+_Static_assert(offsetof(Componente, nome) == 0 && sizeof(((Componente *)0)->nome) == 30 &&
+                   offsetof(Componente, tipo) == 30 && sizeof(((Componente *)0)->tipo) == 20,
+               "kernels de comparacao assumem nome[30] seguido de tipo[20]");
+
+static int (*compararNomeFixo)(const char a[], const char b[]) = strcmp;
+static int (*compararTipoFixo)(const char a[], const char b[]) = strcmp;
+static KernelComparacao kernelAtivo = KERNEL_ESCALAR;
+
+#ifdef COMPARACAO_SIMD_X86
+/**
+ * @brief Resultado de strcmp a partir da máscara "byte difere ou a termina"
+ * @details O primeiro bit ligado é a posição onde strcmp pararia: se os bytes
+ *          diferem, a diferença decide; se a termina com b igual, os dois terminam
+ */
+static inline int resultadoMascara(const char a[], const char b[], unsigned mascara) {
+    int i = __builtin_ctz(mascara);
+    return (unsigned char)a[i] - (unsigned char)b[i];
+}
+
+/** @brief Máscara de 16 bits para o bloco de 16 bytes em desloc */
+__attribute__((target("sse2"))) static inline unsigned mascaraBloco16(const char a[], const char b[], int desloc) {
+    __m128i va = _mm_loadu_si128((const __m128i *)(a + desloc));
+    __m128i vb = _mm_loadu_si128((const __m128i *)(b + desloc));
+    __m128i iguais = _mm_cmpeq_epi8(va, vb);
+    __m128i fim = _mm_cmpeq_epi8(va, _mm_setzero_si128());
+    return ((unsigned)~_mm_movemask_epi8(iguais) | (unsigned)_mm_movemask_epi8(fim)) & 0xFFFFu;
+}
+
+/**
+ * @brief Nome (30 bytes) em dois blocos sobrepostos: [0, 16) e [14, 30)
+ * @details A sobreposição não gera falsos positivos: se o primeiro bloco não
+ *          tinha diferença nem terminador, os bytes 14 e 15 são iguais e não nulos
+ */
+__attribute__((target("sse2"))) static int compararNomeSse2(const char a[], const char b[]) {
+    unsigned mascara = mascaraBloco16(a, b, 0);
+    if(mascara)
+        return resultadoMascara(a, b, mascara);
+    mascara = mascaraBloco16(a, b, 14);
+    return mascara ? resultadoMascara(a + 14, b + 14, mascara) : 0;
+}
+
+/** @brief Tipo (20 bytes) em dois blocos sobrepostos: [0, 16) e [4, 20) */
+__attribute__((target("sse2"))) static int compararTipoSse2(const char a[], const char b[]) {
+    unsigned mascara = mascaraBloco16(a, b, 0);
+    if(mascara)
+        return resultadoMascara(a, b, mascara);
+    mascara = mascaraBloco16(a, b, 4);
+    return mascara ? resultadoMascara(a + 4, b + 4, mascara) : 0;
+}
+
+/**
+ * @brief Nome inteiro em um bloco de 32 bytes
+ * @details Os 2 bytes além do nome (início do tipo, ou a folga da chave
+ *          preparada) são descartados pela máscara de 30 bits
+ */
+__attribute__((target("avx2"))) static int compararNomeAvx2(const char a[], const char b[]) {
+    __m256i va = _mm256_loadu_si256((const __m256i *)a);
+    __m256i vb = _mm256_loadu_si256((const __m256i *)b);
+    __m256i iguais = _mm256_cmpeq_epi8(va, vb);
+    __m256i fim = _mm256_cmpeq_epi8(va, _mm256_setzero_si256());
+    unsigned mascara = ((unsigned)~_mm256_movemask_epi8(iguais) | (unsigned)_mm256_movemask_epi8(fim)) & 0x3FFFFFFFu;
+    return mascara ? resultadoMascara(a, b, mascara) : 0;
+}
+#endif
+
+/** @brief 1 se a CPU (e o compilador) suportam o kernel */
+int kernelComparacaoDisponivel(KernelComparacao kernel) {
+    switch(kernel) {
+    case KERNEL_ESCALAR:
+        return 1;
+#ifdef COMPARACAO_SIMD_X86
+    case KERNEL_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case KERNEL_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Ativa um kernel de comparação
+ * @details O tipo (20 bytes) não cabe em um bloco de 32 sem ler além do
+ *          Componente, então o kernel AVX2 usa o tipo SSE2
+ */
+int selecionarKernelComparacao(KernelComparacao kernel) {
+    if(!kernelComparacaoDisponivel(kernel))
+        return 0;
+    switch(kernel) {
+#ifdef COMPARACAO_SIMD_X86
+    case KERNEL_SSE2:
+        compararNomeFixo = compararNomeSse2;
+        compararTipoFixo = compararTipoSse2;
+        break;
+    case KERNEL_AVX2:
+        compararNomeFixo = compararNomeAvx2;
+        compararTipoFixo = compararTipoSse2;
+        break;
+#endif
+    default:
+        compararNomeFixo = strcmp;
+        compararTipoFixo = strcmp;
+        break;
+    }
+    kernelAtivo = kernel;
+    return 1;
+}
+
+/** @brief Ativa o melhor kernel disponível (AVX2 > SSE2 > escalar) */
+KernelComparacao selecionarMelhorKernelComparacao(void) {
+    for(int k = TOTAL_KERNELS - 1; k > KERNEL_ESCALAR; k--)
+        if(selecionarKernelComparacao((KernelComparacao)k))
+            return (KernelComparacao)k;
+    selecionarKernelComparacao(KERNEL_ESCALAR);
+    return KERNEL_ESCALAR;
+}
+
+/** @brief Kernel em uso */
+KernelComparacao kernelComparacaoAtivo(void) {
+    return kernelAtivo;
+}
+
+/** @brief Nome do kernel ("escalar", "sse2", "avx2") */
+const char *nomeKernelComparacao(KernelComparacao kernel) {
+    static const char *nomes[TOTAL_KERNELS] = {"escalar", "sse2", "avx2"};
+    return kernel < TOTAL_KERNELS ? nomes[kernel] : "?";
+}
+
+/** @brief Copia até 30 bytes do nome para uma chave zerada de TAM_CHAVE_NOME bytes */
+void prepararChaveNome(char chave[TAM_CHAVE_NOME], const char nome[]) {
+    memset(chave, 0, TAM_CHAVE_NOME);
+    strncpy(chave, nome, MAX_STR_LEN);
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO ARMAZENAMENTO EM ARENA
+// ============================================================================
+
+void armazemIniciar(ArmazemArena *a) {
+    memset(a, 0, sizeof(*a));
+}
+
+/**
+ * @brief Entrega bytes alinhados do bloco atual, abrindo um bloco novo quando ele se esgota
+ * @details Blocos dobram de tamanho (4 KB, 8 KB, ... 1 MB), então n registros
+ *          custam O(log n) + n / 1 MB chamadas ao sistema. O resto do bloco
+ *          anterior é abandonado (menos que um registro ou um nome)
+ */
+static void *arenaAlocar(ArmazemArena *a, size_t bytes, size_t alinhamento) {
+    BlocoArena *bloco = a->blocos;
+    if(bloco != NULL) {
+        size_t inicio = (bloco->usado + alinhamento - 1) & ~(alinhamento - 1);
+        if(inicio + bytes <= bloco->capacidade) {
+            bloco->usado = inicio + bytes;
+            return bloco->dados + inicio;
+        }
+    }
+
+    size_t capacidade = bloco == NULL ? TAM_BLOCO_ARENA_MIN
+                        : bloco->capacidade < TAM_BLOCO_ARENA_MAX ? 2 * bloco->capacidade
+                                                                  : TAM_BLOCO_ARENA_MAX;
+    if(capacidade < bytes)
+        capacidade = bytes;
+    BlocoArena *novo = malloc(sizeof(BlocoArena) + capacidade);
+    if(novo == NULL)
+        return NULL;
+    novo->anterior = bloco;
+    novo->usado = bytes;
+    novo->capacidade = capacidade;
+    a->blocos = novo;
+    a->alocacoesSistema++;
+    a->bytesReservados += sizeof(BlocoArena) + capacidade;
+    return novo->dados;
+}
+
+/** @brief Dobra a tabela de internação (fator de carga máximo de 50%) */
+static int armazemCrescerStrings(ArmazemArena *a) {
+    int novaCapacidade = a->capacidadeStrings > 0 ? a->capacidadeStrings * 2 : 64;
+    const char **strings = calloc((size_t)novaCapacidade, sizeof(*strings));
+    unsigned *hashes = malloc((size_t)novaCapacidade * sizeof(*hashes));
+    if(strings == NULL || hashes == NULL) {
+        free(strings);
+        free(hashes);
+        return 0;
+    }
+
+    unsigned mascara = (unsigned)novaCapacidade - 1;
+    for(int i = 0; i < a->capacidadeStrings; i++) {
+        if(a->strings[i] == NULL)
+            continue;
+        unsigned s = a->hashes[i] & mascara;
+        while(strings[s] != NULL)
+            s = (s + 1) & mascara;
+        strings[s] = a->strings[i];
+        hashes[s] = a->hashes[i];
+    }
+
+    size_t bytesPorSlot = sizeof(*strings) + sizeof(*hashes);
+    a->bytesReservados += ((size_t)novaCapacidade - (size_t)a->capacidadeStrings) * bytesPorSlot;
+    a->alocacoesSistema += 2;
+    free(a->strings);
+    free(a->hashes);
+    a->strings = strings;
+    a->hashes = hashes;
+    a->capacidadeStrings = novaCapacidade;
+    return 1;
+}
+
+/** @brief Copia texto para o pool de strings sem procurá-lo na tabela de internação */
+static const char *armazemCopiar(ArmazemArena *a, const char texto[]) {
+    size_t bytes = strlen(texto) + 1;
+    char *copia = arenaAlocar(a, bytes, 1);
+    if(copia == NULL)
+        return NULL;
+    memcpy(copia, texto, bytes);
+    a->bytesStrings += bytes;
+    return copia;
+}
+
+const char *armazemInternar(ArmazemArena *a, const char texto[]) {
+    if(2 * (a->totalStrings + 1) > a->capacidadeStrings && !armazemCrescerStrings(a))
+        return NULL;
+
+    unsigned hash = hashNome(texto);
+    unsigned mascara = (unsigned)a->capacidadeStrings - 1;
+    unsigned s = hash & mascara;
+    for(; a->strings[s] != NULL; s = (s + 1) & mascara)
+        if(a->hashes[s] == hash && strcmp(a->strings[s], texto) == 0)
+            return a->strings[s];
+
+    const char *copia = armazemCopiar(a, texto);
+    if(copia == NULL)
+        return NULL;
+    a->strings[s] = copia;
+    a->hashes[s] = hash;
+    a->totalStrings++;
+    return copia;
+}
+
+RegistroArena *armazemCriar(ArmazemArena *a, const char nome[], const char tipo[], int quantidade, int prioridade) {
+    const char *tipoInternado = armazemInternar(a, tipo);
+    const char *nomeCopiado = tipoInternado != NULL ? armazemCopiar(a, nome) : NULL;
+    if(nomeCopiado == NULL)
+        return NULL;
+
+    NoRegistroArena *no = a->livres;
+    if(no != NULL) {
+        a->livres = no->proximoLivre;
+        a->reaproveitados++;
+    } else {
+        no = arenaAlocar(a, sizeof(NoRegistroArena), _Alignof(NoRegistroArena));
+        if(no == NULL)
+            return NULL;
+        a->registrosCriados++;
+    }
+
+    no->registro.nome = nomeCopiado;
+    no->registro.tipo = tipoInternado;
+    no->registro.quantidade = quantidade;
+    no->registro.prioridade = prioridade;
+    a->registrosAtivos++;
+    return &no->registro;
+}
+
+void armazemDescartar(ArmazemArena *a, RegistroArena *r) {
+    NoRegistroArena *no = (NoRegistroArena *)r;
+    no->proximoLivre = a->livres;
+    a->livres = no;
+    a->registrosAtivos--;
+}
+
+void armazemLiberar(ArmazemArena *a) {
+    BlocoArena *bloco = a->blocos;
+    while(bloco != NULL) {
+        BlocoArena *anterior = bloco->anterior;
+        free(bloco);
+        bloco = anterior;
+    }
+    free(a->strings);
+    free(a->hashes);
+    armazemIniciar(a);
+}
+
+size_t armazemMemoriaBytes(const ArmazemArena *a) {
+    return a->bytesReservados;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO MOTOR DE ORDENAÇÃO O(n log n)
+// ============================================================================
+
+/** @def LIMITE_INSERTION Partições com até este tamanho são finalizadas com Insertion Sort */
+#define LIMITE_INSERTION 16
+
+/**
+ * @brief Compara um campo em ordem crescente (A-Z, prioridade 1-10), sem contar
+ */
+static int compararCampoCrescente(CriterioOrdenacao campo, const Componente *a, const Componente *b) {
+    switch(campo) {
+    case CRITERIO_NOME:
+        return compararNomeFixo(a->nome, b->nome);
+    case CRITERIO_TIPO:
+        return compararTipoFixo(a->tipo, b->tipo);
+    default:
+        return (a->prioridade > b->prioridade) - (a->prioridade < b->prioridade);
+    }
+}
+
+/**
+ * @brief Compara dois componentes pelo critério do contexto (conta a comparação)
+ * @return < 0 se a vem antes de b, 0 se empatam, > 0 se a vem depois de b
+ * @details Com especificação, cada chave só é consultada se as anteriores empatarem
+ */
+static int compararComponentes(ContextoOrdenacao *ctx, const Componente *a, const Componente *b) {
+    ctx->comparacoes++;
+    if(ctx->especificacao != NULL) {
+        for(int k = 0; k < ctx->especificacao->total; k++) {
+            const ChaveComposta *chave = &ctx->especificacao->chaves[k];
+            int r = compararCampoCrescente(chave->campo, a, b);
+            if(r != 0)
+                return chave->decrescente ? (r < 0) - (r > 0) : r;
+        }
+        return 0;
+    }
+    switch(ctx->criterio) {
+    case CRITERIO_NOME:
+        return compararNomeFixo(a->nome, b->nome);
+    case CRITERIO_TIPO:
+        return compararTipoFixo(a->tipo, b->tipo);
+    default:
+        // Decrescente: maior prioridade primeiro (sem risco de overflow da subtração)
+        return (a->prioridade < b->prioridade) - (a->prioridade > b->prioridade);
+    }
+}
+
+/** @brief Troca dois componentes de posição (conta a troca) */
+static void trocarComponentes(ContextoOrdenacao *ctx, Componente *a, Componente *b) {
+    Componente temp = *a;
+    *a = *b;
+    *b = temp;
+    ctx->trocas++;
+    ctx->bytesMovidos += 3 * (long long)sizeof(Componente);
+}
+
+/**
+ * @brief Insertion Sort genérico (usado para partições pequenas)
+ * @details Estável; cada deslocamento conta como um movimento
+ */
+static void insertionSortContexto(Componente arr[], int tamanho, ContextoOrdenacao *ctx) {
+    for(int i = 1; i < tamanho; i++) {
+        Componente chave = arr[i];
+        int j = i - 1;
+        while(j >= 0 && compararComponentes(ctx, &arr[j], &chave) > 0) {
+            arr[j + 1] = arr[j];
+            ctx->trocas++;
+            ctx->bytesMovidos += (long long)sizeof(Componente);
+            j--;
+        }
+        arr[j + 1] = chave;
+        ctx->bytesMovidos += 2 * (long long)sizeof(Componente);
+    }
+}
+
+/** @brief Desce o elemento raiz no heap máximo (auxiliar do Heapsort) */
+static void descerHeap(Componente arr[], int raiz, int tamanho, ContextoOrdenacao *ctx) {
+    for(;;) {
+        int maior = raiz;
+        int esq = 2 * raiz + 1, dir = esq + 1;
+        if(esq < tamanho && compararComponentes(ctx, &arr[esq], &arr[maior]) > 0)
+            maior = esq;
+        if(dir < tamanho && compararComponentes(ctx, &arr[dir], &arr[maior]) > 0)
+            maior = dir;
+        if(maior == raiz)
+            return;
+        trocarComponentes(ctx, &arr[raiz], &arr[maior]);
+        raiz = maior;
+    }
+}
+
+/**
+ * @brief Heapsort - fallback do IntroSort quando a recursão fica profunda demais
+ * @details Garante O(n log n) mesmo em entradas adversárias ao Quicksort
+ */
+static void heapSortContexto(Componente arr[], int tamanho, ContextoOrdenacao *ctx) {
+    for(int i = tamanho / 2 - 1; i >= 0; i--)
+        descerHeap(arr, i, tamanho, ctx);
+    for(int fim = tamanho - 1; fim > 0; fim--) {
+        trocarComponentes(ctx, &arr[0], &arr[fim]);
+        descerHeap(arr, 0, fim, ctx);
+    }
+}
+
+/**
+ * @brief Laço principal do IntroSort
+ * @param profundidade Níveis de recursão restantes antes de recorrer ao Heapsort
+ *
+ * Algoritmo:
+ * - Pivô = mediana de três (início, meio, fim)
+ * - Partição de Hoare
+ * - Recursão na menor partição e iteração na maior (pilha O(log n))
+ * - Partições com até LIMITE_INSERTION elementos ficam para o Insertion Sort final
+ */
+static void introSortRecursivo(Componente arr[], int tamanho, int profundidade, ContextoOrdenacao *ctx) {
+    while(tamanho > LIMITE_INSERTION) {
+        if(profundidade == 0) {
+            heapSortContexto(arr, tamanho, ctx);
+            return;
+        }
+        profundidade--;
+
+        // Mediana de três: ordena arr[0], arr[meio], arr[fim]
+        int meio = tamanho / 2, fim = tamanho - 1;
+        if(compararComponentes(ctx, &arr[meio], &arr[0]) < 0)
+            trocarComponentes(ctx, &arr[meio], &arr[0]);
+        if(compararComponentes(ctx, &arr[fim], &arr[meio]) < 0) {
+            trocarComponentes(ctx, &arr[fim], &arr[meio]);
+            if(compararComponentes(ctx, &arr[meio], &arr[0]) < 0)
+                trocarComponentes(ctx, &arr[meio], &arr[0]);
+        }
+        Componente pivo = arr[meio];
+
+        // Partição de Hoare: [0..j] <= pivô <= [j+1..fim]
+        int i = -1, j = tamanho;
+        for(;;) {
+            do
+                i++;
+            while(compararComponentes(ctx, &arr[i], &pivo) < 0);
+            do
+                j--;
+            while(compararComponentes(ctx, &arr[j], &pivo) > 0);
+            if(i >= j)
+                break;
+            trocarComponentes(ctx, &arr[i], &arr[j]);
+        }
+
+        int tamEsq = j + 1, tamDir = tamanho - j - 1;
+        if(tamEsq < tamDir) {
+            introSortRecursivo(arr, tamEsq, profundidade, ctx);
+            arr += tamEsq;
+            tamanho = tamDir;
+        } else {
+            introSortRecursivo(arr + tamEsq, tamDir, profundidade, ctx);
+            tamanho = tamEsq;
+        }
+    }
+}
+
+/**
+ * @brief IntroSort completo: Quicksort limitado + Heapsort + Insertion Sort final
+ * @details Complexidade: O(n log n) no pior caso; não estável
+ */
+static void introSortContexto(Componente arr[], int tamanho, ContextoOrdenacao *ctx) {
+    int profundidade = 0;
+    for(int n = tamanho; n > 1; n >>= 1)
+        profundidade += 2; // 2·log2(n)
+    introSortRecursivo(arr, tamanho, profundidade, ctx);
+    insertionSortContexto(arr, tamanho, ctx); // Cada elemento está a < LIMITE_INSERTION posições do destino
+}
+
+/**
+ * @brief Merge Sort top-down recursivo
+ * @param aux Buffer auxiliar com pelo menos tamanho posições
+ *
+ * Algoritmo:
+ * - Divide ao meio, ordena cada metade recursivamente
+ * - Pula a intercalação se as metades já estão em ordem (entrada pré-ordenada => O(n))
+ * - Intercala copiando a metade esquerda para o buffer; empates favorecem a
+ *   esquerda, o que torna o algoritmo estável
+ */
+static void mergeSortRecursivo(Componente arr[], Componente aux[], int tamanho, ContextoOrdenacao *ctx) {
+    if(tamanho <= LIMITE_INSERTION) {
+        insertionSortContexto(arr, tamanho, ctx);
+        return;
+    }
+    int meio = tamanho / 2;
+    mergeSortRecursivo(arr, aux, meio, ctx);
+    mergeSortRecursivo(arr + meio, aux, tamanho - meio, ctx);
+
+    if(compararComponentes(ctx, &arr[meio - 1], &arr[meio]) <= 0)
+        return; // Metades já estão em ordem
+
+    memcpy(aux, arr, (size_t)meio * sizeof(Componente));
+    ctx->trocas += meio;
+    ctx->bytesMovidos += (long long)meio * (long long)sizeof(Componente);
+
+    int i = 0, j = meio, k = 0;
+    while(i < meio && j < tamanho) {
+        if(compararComponentes(ctx, &arr[j], &aux[i]) < 0)
+            arr[k++] = arr[j++];
+        else
+            arr[k++] = aux[i++];
+        ctx->trocas++;
+    }
+    while(i < meio) {
+        arr[k++] = aux[i++];
+        ctx->trocas++;
+    }
+    ctx->bytesMovidos += (long long)k * (long long)sizeof(Componente);
+}
+
+/** @def RUN_MINIMO_MAXIMO Sequências curtas são estendidas até minrun, que fica entre 16 e 32 */
+#define RUN_MINIMO_MAXIMO 32
+/** @def PILHA_SEQUENCIAS Sequências pendentes: as invariantes fazem os tamanhos crescerem como Fibonacci */
+#define PILHA_SEQUENCIAS 64
+
+/**
+ * @brief Calcula o minrun do TimSort: n / minrun fica igual ou logo abaixo de uma potência de 2
+ * @details Assim as intercalações finais juntam sequências de tamanhos parecidos
+ */
+static int calcularRunMinimo(int tamanho) {
+    int resto = 0;
+    while(tamanho >= RUN_MINIMO_MAXIMO) {
+        resto |= tamanho & 1;
+        tamanho >>= 1;
+    }
+    return tamanho + resto;
+}
+
+/**
+ * @brief Mede a sequência já ordenada no início do vetor
+ * @return Comprimento da sequência (>= 1)
+ * @details Sequências estritamente decrescentes são invertidas no lugar; exigir
+ *          "estritamente" garante que a inversão não troque a ordem de empates
+ */
+static int medirSequencia(Componente arr[], int tamanho, ContextoOrdenacao *ctx) {
+    if(tamanho < 2)
+        return tamanho;
+    int fim = 2;
+    if(compararComponentes(ctx, &arr[1], &arr[0]) < 0) {
+        while(fim < tamanho && compararComponentes(ctx, &arr[fim], &arr[fim - 1]) < 0)
+            fim++;
+        for(int i = 0, j = fim - 1; i < j; i++, j--)
+            trocarComponentes(ctx, &arr[i], &arr[j]);
+    } else {
+        while(fim < tamanho && compararComponentes(ctx, &arr[fim], &arr[fim - 1]) >= 0)
+            fim++;
+    }
+    return fim;
+}
+
+/**
+ * @brief Primeira posição de arr[0..tamanho) cujo elemento vem depois de chave
+ * @details Se inclusivo, devolve a primeira posição que não vem antes de chave
+ *          (limite inferior); caso contrário, o limite superior
+ */
+static int limiteSequencia(const Componente arr[], int tamanho, const Componente *chave, int inclusivo,
+                           ContextoOrdenacao *ctx) {
+    int inicio = 0, fim = tamanho;
+    while(inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        int r = compararComponentes(ctx, &arr[meio], chave);
+        if(r < 0 || (r == 0 && !inclusivo))
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    return inicio;
+}
+
+/**
+ * @brief Insertion Sort binário: arr[0..ordenados) já está em ordem
+ * @details Cada elemento é inserido após os iguais (limite superior), o que
+ *          mantém a estabilidade; o deslocamento é um único memmove
+ */
+static void insercaoBinariaContexto(Componente arr[], int tamanho, int ordenados, ContextoOrdenacao *ctx) {
+    for(int i = ordenados; i < tamanho; i++) {
+        Componente chave = arr[i];
+        int pos = limiteSequencia(arr, i, &chave, 0, ctx);
+        memmove(&arr[pos + 1], &arr[pos], (size_t)(i - pos) * sizeof(Componente));
+        arr[pos] = chave;
+        ctx->trocas += i - pos;
+        ctx->bytesMovidos += (long long)(i - pos + 2) * (long long)sizeof(Componente);
+    }
+}
+
+/**
+ * @brief Como limiteSequencia, mas sondando a partir de uma ponta (busca exponencial)
+ * @param daDireita 0 = sonda as posições 0, 1, 3, 7...; 1 = sonda a partir do fim
+ * @details Custa O(log k), onde k é a distância do limite até a ponta sondada:
+ *          é o "galope" do TimSort, barato quando o limite está perto
+ */
+static int galoparSequencia(const Componente arr[], int tamanho, const Componente *chave, int inclusivo, int daDireita,
+                            ContextoOrdenacao *ctx) {
+    int inicio = 0, fim = tamanho;
+    long long pos = daDireita ? tamanho - 1 : 0, salto = 1;
+    while(pos >= 0 && pos < tamanho) {
+        int r = compararComponentes(ctx, &arr[pos], chave);
+        int antes = r < 0 || (r == 0 && !inclusivo);
+        if(antes) {
+            inicio = (int)pos + 1;
+            if(daDireita)
+                break;
+            pos += salto;
+        } else {
+            fim = (int)pos;
+            if(!daDireita)
+                break;
+            pos -= salto;
+        }
+        salto *= 2;
+    }
+    return inicio + limiteSequencia(arr + inicio, fim - inicio, chave, inclusivo, ctx);
+}
+
+/** @def MIN_GALOPE Vitórias seguidas do mesmo lado que ativam o galope na intercalação */
+#define MIN_GALOPE 7
+
+/**
+ * @brief Intercala as sequências vizinhas arr[0..tamEsq) e arr[tamEsq..tamEsq+tamDir)
+ * @param aux Buffer com pelo menos min(tamEsq, tamDir) posições
+ *
+ * Algoritmo:
+ * - Dois galopes descartam o que já está no lugar: o início da esquerda menor ou
+ *   igual ao primeiro da direita e o fim da direita maior ou igual ao último da esquerda
+ * - Copia para o buffer a menor das partes restantes e intercala para frente
+ *   (esquerda no buffer) ou para trás (direita no buffer)
+ * - Quando um lado vence MIN_GALOPE vezes seguidas, passa a galopar: localiza o
+ *   bloco inteiro que vem antes do outro lado e o move de uma vez (memmove)
+ * - Empates sempre favorecem a esquerda, o que mantém a estabilidade
+ */
+static void intercalarSequencias(Componente arr[], Componente aux[], int tamEsq, int tamDir, ContextoOrdenacao *ctx) {
+    int pulados = galoparSequencia(arr, tamEsq, &arr[tamEsq], 0, 0, ctx);
+    arr += pulados;
+    tamEsq -= pulados;
+    if(tamEsq == 0)
+        return;
+    Componente *dir = arr + tamEsq;
+    tamDir = galoparSequencia(dir, tamDir, &arr[tamEsq - 1], 1, 1, ctx);
+    if(tamDir == 0)
+        return;
+
+    long long movidos = 0;
+    int seguidosEsq = 0, seguidosDir = 0;
+    if(tamEsq <= tamDir) {
+        memcpy(aux, arr, (size_t)tamEsq * sizeof(Componente));
+        int i = 0, j = 0, k = 0;
+        while(i < tamEsq && j < tamDir) {
+            if(compararComponentes(ctx, &dir[j], &aux[i]) < 0) {
+                arr[k++] = dir[j++];
+                seguidosDir++;
+                seguidosEsq = 0;
+            } else {
+                arr[k++] = aux[i++];
+                seguidosEsq++;
+                seguidosDir = 0;
+            }
+            while((seguidosEsq >= MIN_GALOPE || seguidosDir >= MIN_GALOPE) && i < tamEsq && j < tamDir) {
+                // Esquerda menor ou igual a dir[j], depois direita menor que aux[i]
+                int blocoEsq = galoparSequencia(aux + i, tamEsq - i, &dir[j], 0, 0, ctx);
+                memcpy(&arr[k], &aux[i], (size_t)blocoEsq * sizeof(Componente));
+                k += blocoEsq;
+                i += blocoEsq;
+                if(i == tamEsq)
+                    break;
+                int blocoDir = galoparSequencia(dir + j, tamDir - j, &aux[i], 1, 0, ctx);
+                memmove(&arr[k], &dir[j], (size_t)blocoDir * sizeof(Componente));
+                k += blocoDir;
+                j += blocoDir;
+                seguidosEsq = blocoEsq;
+                seguidosDir = blocoDir;
+            }
+        }
+        memcpy(&arr[k], &aux[i], (size_t)(tamEsq - i) * sizeof(Componente));
+        k += tamEsq - i;
+        movidos = tamEsq + k;
+    } else {
+        memcpy(aux, dir, (size_t)tamDir * sizeof(Componente));
+        int i = tamEsq - 1, j = tamDir - 1, k = tamEsq + tamDir - 1;
+        while(i >= 0 && j >= 0) {
+            if(compararComponentes(ctx, &aux[j], &arr[i]) < 0) {
+                arr[k--] = arr[i--];
+                seguidosEsq++;
+                seguidosDir = 0;
+            } else {
+                arr[k--] = aux[j--];
+                seguidosDir++;
+                seguidosEsq = 0;
+            }
+            while((seguidosEsq >= MIN_GALOPE || seguidosDir >= MIN_GALOPE) && i >= 0 && j >= 0) {
+                // Do fim: esquerda maior que aux[j], depois direita maior ou igual a arr[i]
+                int blocoEsq = i + 1 - galoparSequencia(arr, i + 1, &aux[j], 0, 1, ctx);
+                memmove(&arr[k - blocoEsq + 1], &arr[i - blocoEsq + 1], (size_t)blocoEsq * sizeof(Componente));
+                k -= blocoEsq;
+                i -= blocoEsq;
+                if(i < 0)
+                    break;
+                int blocoDir = j + 1 - galoparSequencia(aux, j + 1, &arr[i], 1, 1, ctx);
+                memcpy(&arr[k - blocoDir + 1], &aux[j - blocoDir + 1], (size_t)blocoDir * sizeof(Componente));
+                k -= blocoDir;
+                j -= blocoDir;
+                seguidosEsq = blocoEsq;
+                seguidosDir = blocoDir;
+            }
+        }
+        memcpy(arr, aux, (size_t)(j + 1) * sizeof(Componente));
+        k -= j + 1;
+        movidos = tamDir + (tamEsq + tamDir - 1 - k);
+    }
+    ctx->trocas += movidos;
+    ctx->bytesMovidos += movidos * (long long)sizeof(Componente);
+}
+
+/**
+ * @brief Intercala as sequências pendentes até restaurar as invariantes do TimSort
+ * @param forcar 1 = intercala tudo (fim da entrada)
+ * @details Invariantes (do topo para baixo): X > Y + Z e Y > Z, versão corrigida
+ *          que também verifica o quarto elemento da pilha
+ */
+static void colapsarSequencias(Componente arr[], Componente aux[], int base[], int comprimento[], int *pendentes,
+                               int forcar, ContextoOrdenacao *ctx) {
+    while(*pendentes > 1) {
+        int k = *pendentes - 2;
+        if(forcar) {
+            if(k > 0 && comprimento[k - 1] < comprimento[k + 1])
+                k--;
+        } else if((k > 0 && comprimento[k - 1] <= comprimento[k] + comprimento[k + 1]) ||
+                  (k > 1 && comprimento[k - 2] <= comprimento[k - 1] + comprimento[k])) {
+            if(comprimento[k - 1] < comprimento[k + 1])
+                k--;
+        } else if(comprimento[k] > comprimento[k + 1]) {
+            break;
+        }
+        intercalarSequencias(arr + base[k], aux, comprimento[k], comprimento[k + 1], ctx);
+        comprimento[k] += comprimento[k + 1];
+        for(int p = k + 1; p < *pendentes - 1; p++) {
+            base[p] = base[p + 1];
+            comprimento[p] = comprimento[p + 1];
+        }
+        (*pendentes)--;
+    }
+}
+
+/**
+ * @brief TimSort: ordenação estável que aproveita sequências já ordenadas
+ * @param aux Buffer auxiliar com pelo menos tamanho / 2 posições
+ *
+ * Algoritmo:
+ * - Percorre o vetor medindo sequências crescentes (ou estritamente decrescentes,
+ *   que são invertidas); as curtas são estendidas até minrun por inserção binária
+ * - Empilha cada sequência e intercala vizinhas quando os tamanhos violam as invariantes
+ * - Vetor já ordenado: uma sequência só, n - 1 comparações e nenhum movimento
+ * - Poucos itens fora do lugar: as buscas binárias da intercalação pulam o resto
+ */
+static void timSortContexto(Componente arr[], Componente aux[], int tamanho, ContextoOrdenacao *ctx) {
+    int base[PILHA_SEQUENCIAS], comprimento[PILHA_SEQUENCIAS], pendentes = 0;
+    int runMinimo = calcularRunMinimo(tamanho);
+
+    for(int inicio = 0; inicio < tamanho;) {
+        int restante = tamanho - inicio;
+        int run = medirSequencia(arr + inicio, restante, ctx);
+        if(run < runMinimo) {
+            int estendido = restante < runMinimo ? restante : runMinimo;
+            insercaoBinariaContexto(arr + inicio, estendido, run, ctx);
+            run = estendido;
+        }
+        base[pendentes] = inicio;
+        comprimento[pendentes] = run;
+        pendentes++;
+        colapsarSequencias(arr, aux, base, comprimento, &pendentes, 0, ctx);
+        inicio += run;
+    }
+    colapsarSequencias(arr, aux, base, comprimento, &pendentes, 1, ctx);
+}
+
+/**
+ * @brief Radix Sort LSD por prioridade (decrescente)
+ * @param aux Buffer auxiliar com tamanho posições
+ *
+ * A chave ~(p XOR 0x80000000) transforma a ordem decrescente de inteiros com
+ * sinal em ordem crescente sem sinal. São até 4 passadas estáveis de 8 bits;
+ * passadas em que todos os elementos têm o mesmo byte são puladas (no caso
+ * comum, prioridades 1-10, só a primeira passada é executada).
+ */
+static void radixSortPrioridadeContexto(Componente arr[], Componente aux[], int tamanho, ContextoOrdenacao *ctx) {
+    Componente *origem = arr, *destino = aux;
+
+    for(int deslocamento = 0; deslocamento < 32; deslocamento += 8) {
+        int contagem[257] = {0};
+        for(int i = 0; i < tamanho; i++) {
+            unsigned chave = ~((unsigned)origem[i].prioridade ^ 0x80000000u);
+            contagem[((chave >> deslocamento) & 0xFF) + 1]++;
+        }
+        int passadaInutil = 0;
+        for(int b = 1; b <= 256; b++)
+            if(contagem[b] == tamanho)
+                passadaInutil = 1;
+        if(passadaInutil)
+            continue;
+
+        for(int b = 1; b <= 256; b++)
+            contagem[b] += contagem[b - 1];
+        for(int i = 0; i < tamanho; i++) {
+            unsigned chave = ~((unsigned)origem[i].prioridade ^ 0x80000000u);
+            destino[contagem[(chave >> deslocamento) & 0xFF]++] = origem[i];
+        }
+        ctx->trocas += tamanho;
+        ctx->bytesMovidos += (long long)tamanho * (long long)sizeof(Componente);
+
+        Componente *t = origem;
+        origem = destino;
+        destino = t;
+    }
+    if(origem != arr) {
+        memcpy(arr, origem, (size_t)tamanho * sizeof(Componente));
+        ctx->trocas += tamanho;
+        ctx->bytesMovidos += (long long)tamanho * (long long)sizeof(Componente);
+    }
+}
+
+/**
+ * @brief Radix Sort MSD para campos de texto (nome ou tipo)
+ * @param deslocamentoCampo offsetof(Componente, nome|tipo)
+ * @param larguraCampo Tamanho do buffer do campo (30 ou 20)
+ * @param profundidade Índice do caractere usado nesta passada
+ *
+ * Distribui os registros em 256 baldes pelo caractere atual; o balde 0 ('\0')
+ * contém textos que terminaram e já estão na posição final. Baldes pequenos
+ * são finalizados com Insertion Sort. Estável.
+ */
+static void radixSortTextoContexto(Componente arr[], Componente aux[], int tamanho, size_t deslocamentoCampo,
+                                   int larguraCampo, int profundidade, ContextoOrdenacao *ctx) {
+    if(tamanho <= LIMITE_INSERTION * 2) {
+        insertionSortContexto(arr, tamanho, ctx);
+        return;
+    }
+    if(profundidade >= larguraCampo)
+        return;
+
+    int contagem[257] = {0};
+    for(int i = 0; i < tamanho; i++) {
+        unsigned char c = (unsigned char)((const char *)&arr[i])[deslocamentoCampo + profundidade];
+        contagem[c + 1]++;
+    }
+    // Prefixo comum (ex: "Tipo-"): todos no mesmo balde, não há o que distribuir
+    unsigned char primeiro = (unsigned char)((const char *)&arr[0])[deslocamentoCampo + profundidade];
+    if(contagem[primeiro + 1] == tamanho) {
+        if(primeiro != '\0')
+            radixSortTextoContexto(arr, aux, tamanho, deslocamentoCampo, larguraCampo, profundidade + 1, ctx);
+        return;
+    }
+    int inicioBalde[257];
+    for(int b = 0; b < 257; b++)
+        inicioBalde[b] = contagem[b];
+    for(int b = 1; b < 257; b++)
+        inicioBalde[b] += inicioBalde[b - 1];
+
+    int posicao[256];
+    memcpy(posicao, inicioBalde, sizeof(posicao));
+    for(int i = 0; i < tamanho; i++) {
+        unsigned char c = (unsigned char)((const char *)&arr[i])[deslocamentoCampo + profundidade];
+        aux[posicao[c]++] = arr[i];
+    }
+    memcpy(arr, aux, (size_t)tamanho * sizeof(Componente));
+    ctx->trocas += 2LL * tamanho;
+    ctx->bytesMovidos += 2LL * tamanho * (long long)sizeof(Componente);
+
+    // Balde 0 = texto terminado; demais baldes seguem para o próximo caractere
+    for(int c = 1; c < 256; c++) {
+        int n = contagem[c + 1];
+        if(n > 1)
+            radixSortTextoContexto(arr + inicioBalde[c], aux, n, deslocamentoCampo, larguraCampo, profundidade + 1, ctx);
+    }
+}
+
+/**
+ * @brief Codifica os 8 primeiros bytes de um texto em big-endian
+ * @details Textos menores são completados com zeros, então comparar as chaves
+ *          como inteiros sem sinal equivale a strcmp nesses 8 bytes
+ */
+static unsigned long long prefixoNormalizado(const char texto[]) {
+    unsigned long long chave = 0;
+    int i = 0;
+    for(; i < 8 && texto[i] != '\0'; i++)
+        chave = (chave << 8) | (unsigned char)texto[i];
+    return i > 0 ? chave << (8 * (8 - i)) : 0; // Texto vazio: deslocar 64 bits seria indefinido
+}
+
+/**
+ * @brief Compara dois pares chave/índice (conta a comparação)
+ * @details Empate de prefixos com 8 bytes preenchidos: o restante do texto
+ *          é comparado no próprio registro (acesso raro ao Componente)
+ */
+static int compararChaves(ContextoOrdenacao *ctx, const Componente arr[], const ChaveOrdenacao *a,
+                          const ChaveOrdenacao *b) {
+    ctx->comparacoes++;
+    if(a->chave != b->chave)
+        return a->chave < b->chave ? -1 : 1;
+    if(ctx->criterio == CRITERIO_PRIORIDADE || (a->chave & 0xFF) == 0)
+        return 0; // Texto terminou dentro do prefixo: textos iguais
+    if(ctx->criterio == CRITERIO_NOME)
+        return strcmp(arr[a->indice].nome + 8, arr[b->indice].nome + 8);
+    return strcmp(arr[a->indice].tipo + 8, arr[b->indice].tipo + 8);
+}
+
+/**
+ * @brief Merge Sort estável sobre os pares chave/índice
+ * @details Mesma estrutura de mergeSortRecursivo, mas cada movimento copia
+ *          16 bytes em vez de um Componente inteiro
+ */
+static void mergeSortChaves(const Componente arr[], ChaveOrdenacao chaves[], ChaveOrdenacao aux[], int tamanho,
+                            ContextoOrdenacao *ctx) {
+    if(tamanho <= LIMITE_INSERTION) {
+        for(int i = 1; i < tamanho; i++) {
+            ChaveOrdenacao atual = chaves[i];
+            int j = i - 1;
+            while(j >= 0 && compararChaves(ctx, arr, &chaves[j], &atual) > 0) {
+                chaves[j + 1] = chaves[j];
+                ctx->bytesMovidos += (long long)sizeof(ChaveOrdenacao);
+                j--;
+            }
+            chaves[j + 1] = atual;
+            ctx->bytesMovidos += 2 * (long long)sizeof(ChaveOrdenacao);
+        }
+        return;
+    }
+    int meio = tamanho / 2;
+    mergeSortChaves(arr, chaves, aux, meio, ctx);
+    mergeSortChaves(arr, chaves + meio, aux, tamanho - meio, ctx);
+
+    if(compararChaves(ctx, arr, &chaves[meio - 1], &chaves[meio]) <= 0)
+        return;
+
+    memcpy(aux, chaves, (size_t)meio * sizeof(ChaveOrdenacao));
+    int i = 0, j = meio, k = 0;
+    while(i < meio && j < tamanho) {
+        if(compararChaves(ctx, arr, &chaves[j], &aux[i]) < 0)
+            chaves[k++] = chaves[j++];
+        else
+            chaves[k++] = aux[i++];
+    }
+    while(i < meio)
+        chaves[k++] = aux[i++];
+    ctx->bytesMovidos += (long long)(meio + k) * (long long)sizeof(ChaveOrdenacao);
+}
+
+/**
+ * @brief Ordenação por chaves extraídas (layout "structure of arrays")
+ * @param chaves Buffer com tamanho pares; aux Buffer auxiliar com tamanho pares
+ *
+ * Algoritmo:
+ * 1. Extrai um par {chave de 8 bytes, índice} por registro
+ * 2. Ordena os pares com Merge Sort estável (trabalho em 16 bytes por elemento)
+ * 3. Aplica a permutação resultante in-place seguindo os ciclos: cada
+ *    registro é copiado uma única vez (+1 cópia temporária por ciclo)
+ *
+ * trocas = registros movidos na permutação final (no máximo n + ciclos)
+ */
+static void chavesSortContexto(Componente arr[], ChaveOrdenacao chaves[], ChaveOrdenacao aux[], int tamanho,
+                               ContextoOrdenacao *ctx) {
+    for(int i = 0; i < tamanho; i++) {
+        if(ctx->criterio == CRITERIO_PRIORIDADE)
+            chaves[i].chave = ~((unsigned)arr[i].prioridade ^ 0x80000000u) & 0xFFFFFFFFu; // Decrescente
+        else
+            chaves[i].chave = prefixoNormalizado(ctx->criterio == CRITERIO_NOME ? arr[i].nome : arr[i].tipo);
+        chaves[i].indice = i;
+    }
+    ctx->bytesMovidos += (long long)tamanho * (long long)sizeof(ChaveOrdenacao);
+
+    mergeSortChaves(arr, chaves, aux, tamanho, ctx);
+
+    // Permutação por ciclos: destino k recebe o registro chaves[k].indice
+    for(int inicio = 0; inicio < tamanho; inicio++) {
+        if(chaves[inicio].indice == inicio)
+            continue;
+        Componente temp = arr[inicio];
+        int atual = inicio;
+        while(chaves[atual].indice != inicio) {
+            int origem = chaves[atual].indice;
+            arr[atual] = arr[origem];
+            chaves[atual].indice = atual; // Marca como posicionado
+            atual = origem;
+            ctx->trocas++;
+        }
+        arr[atual] = temp;
+        chaves[atual].indice = atual;
+        ctx->trocas += 2; // Entrada e saída da cópia temporária
+    }
+    ctx->bytesMovidos += ctx->trocas * (long long)sizeof(Componente);
+}
+
+/**
+ * @brief Counting Sort estável por tipo sobre ids de um dicionário com postos válidos
+ * @param ids ids[i] = id do tipo de arr[i]
+ * @param idsAux Se não for NULL, recebe os ids na nova ordem (copiados de volta para ids)
+ * @return 1 em caso de sucesso, 0 se faltou memória (arr intacto)
+ *
+ * Algoritmo (k = tipos distintos):
+ * 1. Conta os itens de cada posto alfabético: O(n)
+ * 2. Soma de prefixos: início de cada posto no resultado, O(k)
+ * 3. Distribui cada registro na posição do seu posto, em ordem: O(n), estável
+ */
+static int contagemSortTipoContexto(Componente arr[], Componente aux[], uint16_t ids[], uint16_t idsAux[],
+                                    int tamanho, const DicionarioTipos *d, ContextoOrdenacao *ctx) {
+    int *inicio = calloc((size_t)d->total + 1, sizeof(int));
+    if(inicio == NULL)
+        return 0;
+    for(int i = 0; i < tamanho; i++)
+        inicio[d->entradas[ids[i]].posto + 1]++;
+    for(int p = 1; p <= d->total; p++)
+        inicio[p] += inicio[p - 1];
+    for(int i = 0; i < tamanho; i++) {
+        int destino = inicio[d->entradas[ids[i]].posto]++;
+        aux[destino] = arr[i];
+        if(idsAux != NULL)
+            idsAux[destino] = ids[i];
+    }
+    memcpy(arr, aux, (size_t)tamanho * sizeof(Componente));
+    if(idsAux != NULL)
+        memcpy(ids, idsAux, (size_t)tamanho * sizeof(uint16_t));
+    free(inicio);
+
+    ctx->trocas += 2LL * tamanho;
+    ctx->bytesMovidos += 2LL * tamanho * (long long)sizeof(Componente);
+    return 1;
+}
+
+/**
+ * @brief Counting Sort por tipo de um vetor avulso: monta um dicionário temporário
+ * @return 1 em caso de sucesso, 0 se faltou memória (arr intacto)
+ * @details Sem os ids da inserção, cada item paga um hash e, em geral, uma
+ *          confirmação de texto (contadas como comparações)
+ */
+static int contagemSortTipoVetor(Componente arr[], Componente aux[], int tamanho, ContextoOrdenacao *ctx) {
+    DicionarioTipos d = {0};
+    uint16_t *ids = malloc((size_t)tamanho * sizeof(uint16_t));
+    int ok = ids != NULL && dicionarioTiposReconstruir(&d, arr, tamanho, ids) && dicionarioTiposOrdenar(&d) &&
+             contagemSortTipoContexto(arr, aux, ids, NULL, tamanho, &d, ctx);
+    ctx->comparacoes += d.comparacoes;
+    dicionarioTiposLiberar(&d);
+    free(ids);
+    return ok;
+}
+
+int mochilaOrdenarPorTipo(Mochila *m) {
+    ContextoOrdenacao ctx = {CRITERIO_TIPO, 0, 0, 0, NULL};
+    long long comparacoesAntes = m->tipos.comparacoes;
+    long long inicio = metricasInicio(METRICA_ORDENACAO);
+    if(m->quantidade > 0) {
+        Componente *aux = malloc((size_t)m->quantidade * sizeof(Componente));
+        uint16_t *idsAux = malloc((size_t)m->quantidade * sizeof(uint16_t));
+        int ok = aux != NULL && idsAux != NULL && dicionarioTiposOrdenar(&m->tipos) &&
+                 contagemSortTipoContexto(m->itens, aux, m->idsTipo, idsAux, m->quantidade, &m->tipos, &ctx);
+        free(aux);
+        free(idsAux);
+        if(!ok)
+            return 0;
+    }
+
+    // Os ids foram permutados junto com os itens: só os índices por posição são refeitos
+    m->ordenadaPorNome = 0;
+    indicesReconstruir(m);
+
+    comparacoesVetor = (m->tipos.comparacoes - comparacoesAntes);
+    trocasVetor = ctx.trocas;
+    bytesMovidosVetor = ctx.bytesMovidos;
+    metricasRegistrarOrdenacao(ALGORITMO_CONTAGEM, inicio);
+    if(!modoSilencioso) {
+        printf("\n[CONTAGEM] Ordenacao por TIPO concluida (%d tipos distintos, ids da insercao).\n", m->tipos.total);
+        printf("-> Comparacoes: %lld | Trocas: %lld\n", comparacoesVetor, trocasVetor);
+    }
+    return 1;
+}
+
+static void mergeSortParalelo(Componente arr[], Componente aux[], int tamanho, ContextoOrdenacao *ctx);
+
+/**
+ * @brief Ordena componentes com o algoritmo e o critério escolhidos
+ * @param arr Array de componentes (MODIFICADO in-place)
+ * @param tamanho Número de elementos
+ * @param algoritmo Estratégia de ordenação
+ * @param criterio Campo usado como chave
+ *
+ * Telemetria:
+ * - comparacoesVetor: comparações entre chaves (Radix LSD não compara)
+ * - trocasVetor: trocas (IntroSort) ou registros movidos (Merge/Radix/Chaves/Contagem)
+ * - bytesMovidosVetor: bytes copiados de registros e de pares chave/índice
+ */
+void ordenarComponentes(Componente arr[], int tamanho, AlgoritmoOrdenacao algoritmo, CriterioOrdenacao criterio) {
+    static const char *nomesCriterio[TOTAL_CRITERIOS] = {"NOME", "TIPO", "PRIORIDADE"};
+    static const char *rotulos[TOTAL_ALGORITMOS] = {"", "INTROSORT", "MERGE SORT", "RADIX SORT", "CHAVES EXTRAIDAS",
+                                                    "MERGE PARALELO", "CONTAGEM", "ADAPTATIVO"};
+
+    if(algoritmo == ALGORITMO_CLASSICO) {
+        funcaoOrdenacao(algoritmo, criterio)(arr, tamanho); // Registra as métricas por conta própria
+        return;
+    }
+    if(tamanho == 0)
+        return;
+
+    long long inicio = metricasInicio(METRICA_ORDENACAO);
+    ContextoOrdenacao ctx = {criterio, 0, 0, 0, NULL};
+    Componente *aux = NULL;
+    if(algoritmo == ALGORITMO_CHAVES) {
+        // Um único bloco: pares ordenados + buffer auxiliar do Merge Sort
+        aux = malloc((size_t)tamanho * 2 * sizeof(ChaveOrdenacao));
+        if(aux == NULL)
+            algoritmo = ALGORITMO_INTROSORT;
+    } else if(algoritmo != ALGORITMO_INTROSORT) {
+        aux = malloc((size_t)tamanho * sizeof(Componente));
+        if(aux == NULL)
+            algoritmo = ALGORITMO_INTROSORT; // Sem memória auxiliar: IntroSort é in-place
+    }
+
+    switch(algoritmo) {
+    case ALGORITMO_MERGESORT:
+        mergeSortRecursivo(arr, aux, tamanho, &ctx);
+        break;
+    case ALGORITMO_RADIXSORT:
+        if(criterio == CRITERIO_PRIORIDADE)
+            radixSortPrioridadeContexto(arr, aux, tamanho, &ctx);
+        else if(criterio == CRITERIO_NOME)
+            radixSortTextoContexto(arr, aux, tamanho, offsetof(Componente, nome), (int)sizeof(arr->nome), 0, &ctx);
+        else
+            radixSortTextoContexto(arr, aux, tamanho, offsetof(Componente, tipo), (int)sizeof(arr->tipo), 0, &ctx);
+        break;
+    case ALGORITMO_PARALELO:
+        mergeSortParalelo(arr, aux, tamanho, &ctx);
+        break;
+    case ALGORITMO_ADAPTATIVO:
+        timSortContexto(arr, aux, tamanho, &ctx);
+        break;
+    case ALGORITMO_CONTAGEM: // Contagem só compensa com poucas chaves distintas: nome e prioridade vão para o Radix
+        if(criterio == CRITERIO_PRIORIDADE)
+            radixSortPrioridadeContexto(arr, aux, tamanho, &ctx);
+        else if(criterio == CRITERIO_NOME)
+            radixSortTextoContexto(arr, aux, tamanho, offsetof(Componente, nome), (int)sizeof(arr->nome), 0, &ctx);
+        else if(!contagemSortTipoVetor(arr, aux, tamanho, &ctx))
+            introSortContexto(arr, tamanho, &ctx);
+        break;
+    case ALGORITMO_CHAVES: {
+        ChaveOrdenacao *chaves = (ChaveOrdenacao *)(void *)aux;
+        chavesSortContexto(arr, chaves, chaves + tamanho, tamanho, &ctx);
+        break;
+    }
+    default:
+        introSortContexto(arr, tamanho, &ctx);
+        break;
+    }
+    free(aux);
+
+    comparacoesVetor = ctx.comparacoes;
+    trocasVetor = ctx.trocas;
+    bytesMovidosVetor = ctx.bytesMovidos;
+    metricasRegistrarOrdenacao(algoritmo, inicio); // O algoritmo que de fato rodou (sem memória: IntroSort)
+    if(modoSilencioso)
+        return;
+    printf("\n[%s] Ordenacao por %s concluida.\n", rotulos[algoritmo], nomesCriterio[criterio]);
+    printf("-> Comparacoes: %lld | Trocas: %lld\n", comparacoesVetor, trocasVetor);
+    if(algoritmo == ALGORITMO_PARALELO)
+        printf("-> Threads: %d (contadores somados de todas as threads)\n", threadsTrabalho());
+}
+
+void introSortNome(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_INTROSORT, CRITERIO_NOME); }
+void introSortTipo(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_INTROSORT, CRITERIO_TIPO); }
+void introSortPrioridade(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_INTROSORT, CRITERIO_PRIORIDADE); }
+void mergeSortNome(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_MERGESORT, CRITERIO_NOME); }
+void mergeSortTipo(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_MERGESORT, CRITERIO_TIPO); }
+void mergeSortPrioridade(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_MERGESORT, CRITERIO_PRIORIDADE); }
+void radixSortNome(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_RADIXSORT, CRITERIO_NOME); }
+void radixSortTipo(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_RADIXSORT, CRITERIO_TIPO); }
+void radixSortPrioridade(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_RADIXSORT, CRITERIO_PRIORIDADE); }
+void chavesSortNome(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_CHAVES, CRITERIO_NOME); }
+void chavesSortTipo(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_CHAVES, CRITERIO_TIPO); }
+void chavesSortPrioridade(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_CHAVES, CRITERIO_PRIORIDADE); }
+void mergeParaleloNome(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_PARALELO, CRITERIO_NOME); }
+void mergeParaleloTipo(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_PARALELO, CRITERIO_TIPO); }
+void mergeParaleloPrioridade(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_PARALELO, CRITERIO_PRIORIDADE); }
+void contagemSortNome(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_CONTAGEM, CRITERIO_NOME); }
+void contagemSortTipo(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_CONTAGEM, CRITERIO_TIPO); }
+void contagemSortPrioridade(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_CONTAGEM, CRITERIO_PRIORIDADE); }
+void adaptativoSortNome(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_ADAPTATIVO, CRITERIO_NOME); }
+void adaptativoSortTipo(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_ADAPTATIVO, CRITERIO_TIPO); }
+void adaptativoSortPrioridade(Componente arr[], int tamanho) { ordenarComponentes(arr, tamanho, ALGORITMO_ADAPTATIVO, CRITERIO_PRIORIDADE); }
+
+/**
+ * @brief Tabela [algoritmo][critério] com as funções compatíveis com medirTempo
+ */
+static void (*const tabelaOrdenacao[TOTAL_ALGORITMOS][TOTAL_CRITERIOS])(Componente[], int) = {
+    {bubbleSortNome, insertionSortTipo, selectionSortPrioridade},
+    {introSortNome, introSortTipo, introSortPrioridade},
+    {mergeSortNome, mergeSortTipo, mergeSortPrioridade},
+    {radixSortNome, radixSortTipo, radixSortPrioridade},
+    {chavesSortNome, chavesSortTipo, chavesSortPrioridade},
+    {mergeParaleloNome, mergeParaleloTipo, mergeParaleloPrioridade},
+    {contagemSortNome, contagemSortTipo, contagemSortPrioridade},
+    {adaptativoSortNome, adaptativoSortTipo, adaptativoSortPrioridade},
+};
+
+/** @brief Descrições exibidas por medirTempo para cada par [algoritmo][critério] */
+static const char *const tabelaDescricoes[TOTAL_ALGORITMOS][TOTAL_CRITERIOS] = {
+    {"BUBBLE SORT - Por Nome", "INSERTION SORT - Por Tipo", "SELECTION SORT - Por Prioridade"},
+    {"INTROSORT - Por Nome", "INTROSORT - Por Tipo", "INTROSORT - Por Prioridade"},
+    {"MERGE SORT - Por Nome", "MERGE SORT - Por Tipo", "MERGE SORT - Por Prioridade"},
+    {"RADIX SORT - Por Nome", "RADIX SORT - Por Tipo", "RADIX SORT - Por Prioridade"},
+    {"CHAVES EXTRAIDAS - Por Nome", "CHAVES EXTRAIDAS - Por Tipo", "CHAVES EXTRAIDAS - Por Prioridade"},
+    {"MERGE PARALELO - Por Nome", "MERGE PARALELO - Por Tipo", "MERGE PARALELO - Por Prioridade"},
+    {"CONTAGEM (RADIX) - Por Nome", "CONTAGEM - Por Tipo", "CONTAGEM (RADIX) - Por Prioridade"},
+    {"ADAPTATIVO (TIMSORT) - Por Nome", "ADAPTATIVO (TIMSORT) - Por Tipo", "ADAPTATIVO (TIMSORT) - Por Prioridade"},
+};
+
+void (*funcaoOrdenacao(AlgoritmoOrdenacao algoritmo, CriterioOrdenacao criterio))(Componente[], int) {
+    return tabelaOrdenacao[algoritmo][criterio];
+}
+
+const char *descricaoOrdenacao(AlgoritmoOrdenacao algoritmo, CriterioOrdenacao criterio) {
+    return tabelaDescricoes[algoritmo][criterio];
+}
+
+/**
+ * @brief Converte o nome de um algoritmo no enum correspondente
+ * @details Aceita CLASSICO, INTRO/INTROSORT, MERGE/MERGESORT, RADIX/RADIXSORT, CHAVES/SOA, PARALELO/PMERGE,
+ *          CONTAGEM/COUNTING e ADAPTATIVO/TIMSORT
+ */
+int algoritmoPorNome(const char nome[], AlgoritmoOrdenacao *algoritmo) {
+    static const char *nomes[TOTAL_ALGORITMOS][2] = {
+        {"CLASSICO", "CLASSIC"}, {"INTRO", "INTROSORT"}, {"MERGE", "MERGESORT"},
+        {"RADIX", "RADIXSORT"},  {"CHAVES", "SOA"},     {"PARALELO", "PMERGE"},
+        {"CONTAGEM", "COUNTING"}, {"ADAPTATIVO", "TIMSORT"}};
+
+    for(int a = 0; a < TOTAL_ALGORITMOS; a++) {
+        if(strcasecmp(nome, nomes[a][0]) == 0 || strcasecmp(nome, nomes[a][1]) == 0) {
+            *algoritmo = (AlgoritmoOrdenacao)a;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *nomeAlgoritmo(AlgoritmoOrdenacao algoritmo) {
+    static const char *nomes[TOTAL_ALGORITMOS] = {"classico", "introsort", "mergesort", "radixsort",
+                                                  "chaves",   "paralelo",  "contagem",  "adaptativo"};
+    return nomes[algoritmo];
+}
+
+int especificacaoPorTexto(const char texto[], EspecificacaoOrdenacao *espec) {
+    static const char *campos[TOTAL_CRITERIOS] = {"NOME", "TIPO", "PRIORIDADE"};
+    espec->total = 0;
+    for(const char *p = texto;;) {
+        size_t tamanho = strcspn(p, ",");
+        char campo[MAX_STR_LEN] = "", sentido[MAX_STR_LEN] = "", sobra[MAX_STR_LEN] = "";
+        char trecho[MAX_LINHA_LOTE];
+        snprintf(trecho, sizeof(trecho), "%.*s", (int)tamanho, p);
+        if(sscanf(trecho, "%29s %29s %29s", campo, sentido, sobra) < 1 || sobra[0] != '\0')
+            return 0;
+
+        int c = 0;
+        while(c < TOTAL_CRITERIOS && strcasecmp(campo, campos[c]) != 0)
+            c++;
+        if(c == TOTAL_CRITERIOS || espec->total == TOTAL_CRITERIOS)
+            return 0;
+        for(int k = 0; k < espec->total; k++)
+            if(espec->chaves[k].campo == (CriterioOrdenacao)c)
+                return 0; // Campo repetido nunca desempataria nada
+
+        ChaveComposta *chave = &espec->chaves[espec->total++];
+        chave->campo = (CriterioOrdenacao)c;
+        if(sentido[0] == '\0')
+            chave->decrescente = c == CRITERIO_PRIORIDADE; // Mesmo sentido do critério simples
+        else if(strcasecmp(sentido, "ASC") == 0)
+            chave->decrescente = 0;
+        else if(strcasecmp(sentido, "DESC") == 0)
+            chave->decrescente = 1;
+        else
+            return 0;
+
+        if(p[tamanho] == '\0')
+            break;
+        p += tamanho + 1;
+    }
+    return 1;
+}
+
+void descreverEspecificacao(const EspecificacaoOrdenacao *espec, char destino[], size_t tamanho) {
+    static const char *campos[TOTAL_CRITERIOS] = {"nome", "tipo", "prioridade"};
+    size_t usado = 0;
+    destino[0] = '\0';
+    for(int k = 0; k < espec->total && usado < tamanho; k++) {
+        int escrito = snprintf(destino + usado, tamanho - usado, "%s%s %s", k > 0 ? ", " : "",
+                               campos[espec->chaves[k].campo], espec->chaves[k].decrescente ? "desc" : "asc");
+        if(escrito < 0)
             break;
+        usado += (size_t)escrito;
+    }
+}
+
+/**
+ * @brief Ordenação por várias chaves com o TimSort
+ * @details O comparador percorre as chaves em ordem, então uma única passada
+ *          estável produz o mesmo resultado que ordenar pela última chave, depois
+ *          pela penúltima, e assim por diante
+ */
+void ordenarPorEspecificacao(Componente arr[], int tamanho, const EspecificacaoOrdenacao *espec) {
+    if(tamanho == 0 || espec->total == 0)
+        return;
+
+    long long inicio = metricasInicio(METRICA_ORDENACAO);
+    ContextoOrdenacao ctx = {espec->chaves[0].campo, 0, 0, 0, espec};
+    Componente *aux = malloc((size_t)(tamanho / 2 + 1) * sizeof(Componente));
+    int estavel = aux != NULL;
+    if(estavel)
+        timSortContexto(arr, aux, tamanho, &ctx);
+    else
+        introSortContexto(arr, tamanho, &ctx); // Sem memória auxiliar: respeita as chaves, mas não é estável
+    free(aux);
+
+    comparacoesVetor = ctx.comparacoes;
+    trocasVetor = ctx.trocas;
+    bytesMovidosVetor = ctx.bytesMovidos;
+    metricasRegistrarOrdenacao(estavel ? ALGORITMO_ADAPTATIVO : ALGORITMO_INTROSORT, inicio);
+    if(modoSilencioso)
+        return;
+    char descricao[64];
+    descreverEspecificacao(espec, descricao, sizeof(descricao));
+    printf("\n[%s] Ordenacao por %s concluida.\n", estavel ? "ADAPTATIVO" : "INTROSORT", descricao);
+    printf("-> Comparacoes: %lld | Trocas: %lld\n", comparacoesVetor, trocasVetor);
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO PARALELISMO
+// ============================================================================
+
+/** @def LIMIAR_PARALELO Abaixo deste tamanho o custo de coordenar as threads supera o ganho */
+#define LIMIAR_PARALELO 8192
+
+/**
+ * @struct PoolThreads
+ * @brief Threads auxiliares reutilizadas por todas as operações paralelas
+ * @details Uma rodada de trabalho = um vetor de tarefas; as threads (e o
+ *          chamador) retiram o próximo índice sob a trava até esgotá-lo
+ */
+typedef struct {
+    pthread_t threads[MAX_THREADS];
+    int totalThreads;              /**< Threads auxiliares (sem contar o chamador) */
+    pthread_mutex_t trava;
+    pthread_cond_t haTrabalho;     /**< Sinalizada quando uma rodada começa ou o pool encerra */
+    pthread_cond_t rodadaConcluida;/**< Sinalizada quando a última tarefa termina */
+    void (*tarefa)(void *);
+    char *argumentos;
+    size_t tamanhoArgumento;
+    int totalTarefas;
+    int proximaTarefa;
+    int tarefasConcluidas;
+    int encerrar;
+} PoolThreads;
+
+static PoolThreads pool;
+static int poolIniciado = 0;
+
+/**
+ * @brief Retira e executa tarefas da rodada atual até não haver mais nenhuma
+ * @details Chamada com a trava adquirida; a libera durante cada tarefa
+ */
+static void consumirTarefas(PoolThreads *p) {
+    while(p->proximaTarefa < p->totalTarefas) {
+        int indice = p->proximaTarefa++;
+        pthread_mutex_unlock(&p->trava);
+        p->tarefa(p->argumentos + (size_t)indice * p->tamanhoArgumento);
+        pthread_mutex_lock(&p->trava);
+        if(++p->tarefasConcluidas == p->totalTarefas)
+            pthread_cond_signal(&p->rodadaConcluida);
+    }
+}
+
+/** @brief Laço das threads auxiliares: dormem até haver trabalho ou o pool encerrar */
+static void *lacoThreadAuxiliar(void *argumento) {
+    PoolThreads *p = argumento;
+    pthread_mutex_lock(&p->trava);
+    while(!p->encerrar) {
+        consumirTarefas(p);
+        if(!p->encerrar)
+            pthread_cond_wait(&p->haTrabalho, &p->trava);
+    }
+    pthread_mutex_unlock(&p->trava);
+    return NULL;
+}
+
+/** @brief Encerra e aguarda as threads auxiliares (registrada com atexit) */
+static void encerrarPool(void) {
+    pthread_mutex_lock(&pool.trava);
+    pool.encerrar = 1;
+    pthread_cond_broadcast(&pool.haTrabalho);
+    pthread_mutex_unlock(&pool.trava);
+    for(int i = 0; i < pool.totalThreads; i++)
+        pthread_join(pool.threads[i], NULL);
+}
+
+/**
+ * @brief Número de threads usadas pelas operações paralelas
+ */
+int threadsTrabalho(void) {
+    int threads = threadsConfiguradas;
+    if(threads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    return threads > MAX_THREADS ? MAX_THREADS : threads;
+}
+
+/**
+ * @brief Executa tarefas independentes no pool de threads
+ */
+void executarEmParalelo(void (*tarefa)(void *), void *argumentos, size_t tamanhoArgumento, int totalTarefas) {
+    if(!poolIniciado) {
+        pthread_mutex_init(&pool.trava, NULL);
+        pthread_cond_init(&pool.haTrabalho, NULL);
+        pthread_cond_init(&pool.rodadaConcluida, NULL);
+        int auxiliares = threadsTrabalho() - 1;
+        while(pool.totalThreads < auxiliares &&
+              pthread_create(&pool.threads[pool.totalThreads], NULL, lacoThreadAuxiliar, &pool) == 0)
+            pool.totalThreads++; // Se a criação falhar, segue com as threads já criadas
+        poolIniciado = 1;
+        atexit(encerrarPool);
+    }
+
+    pthread_mutex_lock(&pool.trava);
+    pool.tarefa = tarefa;
+    pool.argumentos = argumentos;
+    pool.tamanhoArgumento = tamanhoArgumento;
+    pool.totalTarefas = totalTarefas;
+    pool.proximaTarefa = 0;
+    pool.tarefasConcluidas = 0;
+    pthread_cond_broadcast(&pool.haTrabalho);
+
+    consumirTarefas(&pool); // A thread chamadora também trabalha
+    while(pool.tarefasConcluidas < pool.totalTarefas)
+        pthread_cond_wait(&pool.rodadaConcluida, &pool.trava);
+    pool.totalTarefas = 0;
+    pthread_mutex_unlock(&pool.trava);
+}
+
+/**
+ * @struct TarefaOrdenacao
+ * @brief Argumento de uma tarefa do Merge Sort paralelo
+ * @details Na fase 1, ordena origem[0..tamanhoA) usando destino como buffer.
+ *          Na fase 2, gera as posições [saidaInicio, saidaFim) da
+ *          intercalação de origem[0..tamanhoA) com origem[tamanhoA..tamanhoA+tamanhoB)
+ */
+typedef struct {
+    Componente *origem;
+    Componente *destino;
+    int tamanhoA;
+    int tamanhoB;
+    int saidaInicio;
+    int saidaFim;
+    ContextoOrdenacao ctx; /**< Contadores próprios da tarefa (somados no final) */
+} TarefaOrdenacao;
+
+/** @brief Fase 1: ordena um pedaço com o Merge Sort sequencial */
+static void tarefaOrdenarPedaco(void *argumento) {
+    TarefaOrdenacao *t = argumento;
+    mergeSortRecursivo(t->origem, t->destino, t->tamanhoA, &t->ctx);
+}
+
+/**
+ * @brief Quantos elementos de A estão entre as primeiras pos saídas da intercalação estável
+ * @details Busca binária na "diagonal" do merge path: empates favorecem A,
+ *          como em mergeSortRecursivo
+ */
+static int posicaoDiagonal(const Componente a[], int tamanhoA, const Componente b[], int tamanhoB, int pos,
+                           ContextoOrdenacao *ctx) {
+    int baixo = pos > tamanhoB ? pos - tamanhoB : 0;
+    int alto = pos < tamanhoA ? pos : tamanhoA;
+    while(baixo < alto) {
+        int i = baixo + (alto - baixo) / 2;
+        int j = pos - i;
+        if(j > 0 && compararComponentes(ctx, &a[i], &b[j - 1]) <= 0)
+            baixo = i + 1; // a[i] sai antes de b[j-1]: faltam elementos de A
+        else
+            alto = i;
+    }
+    return baixo;
+}
+
+/** @brief Fase 2: intercala um trecho da saída (merge path), independente dos demais trechos */
+static void tarefaIntercalarTrecho(void *argumento) {
+    TarefaOrdenacao *t = argumento;
+    const Componente *a = t->origem, *b = t->origem + t->tamanhoA;
+    int i = posicaoDiagonal(a, t->tamanhoA, b, t->tamanhoB, t->saidaInicio, &t->ctx);
+    int fimA = posicaoDiagonal(a, t->tamanhoA, b, t->tamanhoB, t->saidaFim, &t->ctx);
+    int j = t->saidaInicio - i, fimB = t->saidaFim - fimA;
+
+    Componente *saida = t->destino + t->saidaInicio;
+    int k = 0;
+    while(i < fimA && j < fimB) {
+        if(compararComponentes(&t->ctx, &b[j], &a[i]) < 0)
+            saida[k++] = b[j++];
+        else
+            saida[k++] = a[i++];
+    }
+    while(i < fimA)
+        saida[k++] = a[i++];
+    while(j < fimB)
+        saida[k++] = b[j++];
+    t->ctx.trocas += k;
+    t->ctx.bytesMovidos += (long long)k * (long long)sizeof(Componente);
+}
+
+/** @brief Soma os contadores das tarefas no contexto do chamador */
+static void somarContadores(ContextoOrdenacao *ctx, const TarefaOrdenacao tarefas[], int total) {
+    for(int i = 0; i < total; i++) {
+        ctx->comparacoes += tarefas[i].ctx.comparacoes;
+        ctx->trocas += tarefas[i].ctx.trocas;
+        ctx->bytesMovidos += tarefas[i].ctx.bytesMovidos;
+    }
+}
+
+/**
+ * @brief Merge Sort paralelo
+ * @param aux Buffer auxiliar com tamanho posições
+ *
+ * Algoritmo:
+ * 1. Divide o vetor em p pedaços (p = threads) ordenados em paralelo
+ * 2. Intercala pares de sequências vizinhas em rodadas (p, p/2, ..., 1);
+ *    cada intercalação é dividida pelo "merge path" em trechos de saída
+ *    independentes, então até a última rodada usa todas as threads
+ * 3. As rodadas alternam arr/aux; se o resultado terminar em aux, é copiado
+ *
+ * Estável. Abaixo de LIMIAR_PARALELO (ou com 1 thread) usa o Merge Sort sequencial.
+ */
+static void mergeSortParalelo(Componente arr[], Componente aux[], int tamanho, ContextoOrdenacao *ctx) {
+    int threads = threadsTrabalho();
+    if(threads == 1 || tamanho < LIMIAR_PARALELO) {
+        mergeSortRecursivo(arr, aux, tamanho, ctx);
+        return;
+    }
+
+    // Cada rodada tem no máximo threads + sequências/2 tarefas
+    TarefaOrdenacao *tarefas = malloc(sizeof(TarefaOrdenacao) * (size_t)(2 * threads + 1));
+    int *limites = malloc(sizeof(int) * (size_t)(threads + 1));
+    if(tarefas == NULL || limites == NULL) {
+        free(tarefas);
+        free(limites);
+        mergeSortRecursivo(arr, aux, tamanho, ctx);
+        return;
+    }
+
+    // -------- Fase 1: pedaços ordenados em paralelo --------
+    int sequencias = threads;
+    for(int p = 0; p <= sequencias; p++)
+        limites[p] = (int)((long long)tamanho * p / sequencias);
+    for(int p = 0; p < sequencias; p++) {
+        tarefas[p] = (TarefaOrdenacao){arr + limites[p], aux + limites[p], limites[p + 1] - limites[p], 0, 0, 0,
+                                       {ctx->criterio, 0, 0, 0, ctx->especificacao}};
+    }
+    executarEmParalelo(tarefaOrdenarPedaco, tarefas, sizeof(TarefaOrdenacao), sequencias);
+    somarContadores(ctx, tarefas, sequencias);
+
+    // -------- Fase 2: rodadas de intercalação --------
+    Componente *origem = arr, *destino = aux;
+    while(sequencias > 1) {
+        int pares = sequencias / 2;
+        int trechosPorPar = (threads + pares - 1) / pares;
+        int total = 0;
+        for(int s = 0; s + 1 < sequencias; s += 2) {
+            int inicio = limites[s], meio = limites[s + 1], fim = limites[s + 2];
+            for(int t = 0; t < trechosPorPar; t++) {
+                tarefas[total++] = (TarefaOrdenacao){origem + inicio, destino + inicio, meio - inicio, fim - meio,
+                                                     (int)((long long)(fim - inicio) * t / trechosPorPar),
+                                                     (int)((long long)(fim - inicio) * (t + 1) / trechosPorPar),
+                                                     {ctx->criterio, 0, 0, 0, ctx->especificacao}};
+            }
+        }
+        if(sequencias % 2 == 1) { // Sequência sem par: apenas copiada para o destino
+            int inicio = limites[sequencias - 1];
+            tarefas[total++] = (TarefaOrdenacao){origem + inicio, destino + inicio, tamanho - inicio, 0, 0,
+                                                 tamanho - inicio, {ctx->criterio, 0, 0, 0, ctx->especificacao}};
+        }
+        executarEmParalelo(tarefaIntercalarTrecho, tarefas, sizeof(TarefaOrdenacao), total);
+        somarContadores(ctx, tarefas, total);
+
+        // Os limites das sequências intercaladas se fundem
+        int novas = 0;
+        for(int s = 0; s < sequencias; s += 2)
+            limites[novas++] = limites[s];
+        limites[novas] = tamanho;
+        sequencias = novas;
+
+        Componente *troca = origem;
+        origem = destino;
+        destino = troca;
+    }
+    if(origem != arr) {
+        memcpy(arr, origem, (size_t)tamanho * sizeof(Componente));
+        ctx->trocas += tamanho;
+        ctx->bytesMovidos += (long long)tamanho * (long long)sizeof(Componente);
+    }
+    free(tarefas);
+    free(limites);
+}
+
+/**
+ * @struct TarefaBusca
+ * @brief Argumento de uma tarefa da busca binária paralela (uma faixa de consultas)
+ */
+typedef struct {
+    const Componente *arr;
+    int tamanho;
+    char (*nomes)[MAX_STR_LEN];
+    int *resultados;
+    int inicio;             /**< Primeira consulta da faixa */
+    int fim;                /**< Uma após a última consulta da faixa */
+    long long comparacoes;  /**< Comparações desta faixa */
+    int encontrados;        /**< Nomes encontrados nesta faixa */
+} TarefaBusca;
+
+/** @brief Responde uma faixa de consultas com a busca binária (mesma lógica de buscaBinariaPorNome) */
+static void tarefaBuscarFaixa(void *argumento) {
+    TarefaBusca *t = argumento;
+    for(int q = t->inicio; q < t->fim; q++) {
+        int inicio = 0, fim = t->tamanho - 1, encontrado = -1;
+        char chave[TAM_CHAVE_NOME];
+        prepararChaveNome(chave, t->nomes[q]);
+        while(inicio <= fim) {
+            int meio = inicio + (fim - inicio) / 2;
+            t->comparacoes++;
+            int comp = compararNomeFixo(t->arr[meio].nome, chave);
+            if(comp == 0) {
+                encontrado = meio;
+                break;
+            }
+            if(comp < 0)
+                inicio = meio + 1;
+            else
+                fim = meio - 1;
+        }
+        t->resultados[q] = encontrado;
+        t->encontrados += encontrado != -1;
+    }
+}
+
+/**
+ * @brief Busca binária de muitos nomes, dividida entre as threads
+ * @details Faixas contíguas de consultas por tarefa (4 por thread, para
+ *          equilibrar a carga); comparacoesVetor recebe a soma de todas as faixas
+ */
+int buscaBinariaParalela(const Componente arr[], int tamanho, char nomes[][MAX_STR_LEN], int totalConsultas,
+                         int resultados[]) {
+    long long inicio = metricasInicio(METRICA_BUSCA_LOTE);
+    int faixas = threadsTrabalho() * 4;
+    if(faixas > totalConsultas)
+        faixas = totalConsultas > 0 ? totalConsultas : 1;
+    TarefaBusca *tarefas = malloc(sizeof(TarefaBusca) * (size_t)faixas);
+    if(tarefas == NULL)
+        faixas = 0;
+
+    TarefaBusca unica = {arr, tamanho, nomes, resultados, 0, totalConsultas, 0, 0};
+    for(int f = 0; f < faixas; f++) {
+        tarefas[f] = unica;
+        tarefas[f].inicio = (int)((long long)totalConsultas * f / faixas);
+        tarefas[f].fim = (int)((long long)totalConsultas * (f + 1) / faixas);
+    }
+    if(faixas > 1) {
+        executarEmParalelo(tarefaBuscarFaixa, tarefas, sizeof(TarefaBusca), faixas);
+    } else { // Sem memória para as faixas, ou só uma: resolve na thread atual
+        tarefaBuscarFaixa(&unica);
+        faixas = 0;
+    }
+
+    long long comparacoes = unica.comparacoes;
+    int encontrados = unica.encontrados;
+    for(int f = 0; f < faixas; f++) {
+        comparacoes += tarefas[f].comparacoes;
+        encontrados += tarefas[f].encontrados;
+    }
+    free(tarefas);
+    comparacoesVetor = comparacoes;
+    metricasRegistrar(METRICA_BUSCA_LOTE, inicio, comparacoes, encontrados, totalConsultas - encontrados);
+    return encontrados;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DO BENCHMARK
+// ============================================================================
+
+/** @brief Gerador pseudoaleatório xorshift64 (rápido e reprodutível entre plataformas) */
+static unsigned long long proximoAleatorio(unsigned long long *estado) {
+    unsigned long long x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *estado = x;
+    return x;
+}
+
+const char *nomeDistribuicao(DistribuicaoDados distribuicao) {
+    static const char *nomes[TOTAL_DISTRIBUICOES] = {"aleatoria", "ordenada", "reversa", "poucos_tipos",
+                                                     "prioridade_enviesada", "quase_ordenada"};
+    return nomes[distribuicao];
+}
+
+/**
+ * @brief Gera um inventário sintético determinístico
+ *
+ * Formato dos campos:
+ * - nome: "item-XXXXXXXX" (hexadecimal; crescente nas distribuições ordenadas)
+ * - tipo: "Tipo-NN" (24 tipos, ou 3 em DIST_POUCOS_TIPOS); zero à esquerda
+ *   mantém a ordem alfabética igual à numérica
+ * - prioridade: 1-10 (decrescente nas distribuições ordenadas)
+ * - quase ordenada: parte da ordenada e troca n / 100 pares de posições sorteadas
+ *   (o inventário reordenado depois de poucas inserções e descartes)
+ */
+void gerarComponentes(Componente arr[], int tamanho, DistribuicaoDados distribuicao, unsigned long long semente) {
+    unsigned long long estado = semente ? semente : 88172645463325252ULL;
+
+    for(int i = 0; i < tamanho; i++) {
+        Componente *c = &arr[i];
+        unsigned long long r = proximoAleatorio(&estado);
+        int ordenado = distribuicao == DIST_ORDENADA || distribuicao == DIST_REVERSA ||
+                       distribuicao == DIST_QUASE_ORDENADA;
+        int k = distribuicao == DIST_REVERSA ? tamanho - 1 - i : i; // Posição na ordem crescente
+
+        memset(c, 0, sizeof(*c));
+        if(ordenado) {
+            unsigned passo = tamanho > 1 ? 0xFFFFFFFFu / (unsigned)tamanho : 1;
+            snprintf(c->nome, sizeof(c->nome), "item-%08x", (unsigned)k * passo);
+            snprintf(c->tipo, sizeof(c->tipo), "Tipo-%02d", (int)((long long)k * 24 / tamanho));
+            c->prioridade = 10 - (int)((long long)k * 10 / tamanho);
+        } else {
+            snprintf(c->nome, sizeof(c->nome), "item-%08x", (unsigned)(r >> 32));
+            int tipos = distribuicao == DIST_POUCOS_TIPOS ? 3 : 24;
+            snprintf(c->tipo, sizeof(c->tipo), "Tipo-%02d", (int)((r >> 8) % (unsigned)tipos));
+            if(distribuicao == DIST_PRIORIDADE_ENVIESADA) {
+                int p = (int)((r >> 16) % 100);
+                c->prioridade = p < 60 ? 1 : p < 80 ? 2 : p < 90 ? 3 : 4 + (int)((r >> 24) % 7);
+            } else {
+                c->prioridade = 1 + (int)((r >> 16) % 10);
+            }
+        }
+        c->quantidade = 1 + (int)(r % 100);
+    }
+    for(int t = 0; distribuicao == DIST_QUASE_ORDENADA && t < tamanho / 100; t++) {
+        unsigned long long r = proximoAleatorio(&estado);
+        int i = (int)((r >> 32) % (unsigned)tamanho), j = (int)((unsigned)r % (unsigned)tamanho);
+        Componente temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+    }
+}
+
+/** @brief Comparação de long long para qsort (ordena as amostras de tempo) */
+static int compararLongLong(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Calcula mediana e p99 (nearest-rank) de amostras de tempo
+ * @param amostras Vetor de tempos em ns (MODIFICADO: é ordenado)
+ */
+static void resumirAmostras(long long amostras[], int n, long long *mediana, long long *p99) {
+    qsort(amostras, (size_t)n, sizeof(long long), compararLongLong);
+    *mediana = amostras[(n - 1) / 2];
+    int rank = (99 * n + 99) / 100; // ceil(0.99·n)
+    *p99 = amostras[rank > 0 ? rank - 1 : 0];
+}
+
+/** @brief Mediana de um campo long long de um vetor de medições (tmp: rascunho com n posições) */
+static long long medianaCampo(const Medicao amostras[], int n, size_t deslocamento, long long tmp[]) {
+    for(int i = 0; i < n; i++)
+        tmp[i] = *(const long long *)((const char *)&amostras[i] + deslocamento);
+    qsort(tmp, (size_t)n, sizeof(long long), compararLongLong);
+    return tmp[(n - 1) / 2];
+}
+
+/**
+ * @struct ResultadoBenchmark
+ * @brief Uma linha do relatório
+ */
+typedef struct {
+    const char *suite;        /**< "ordenacao" ou "busca" */
+    int tamanho;              /**< n */
+    const char *distribuicao; /**< Nome da distribuição */
+    const char *algoritmo;    /**< Algoritmo / estrutura */
+    const char *criterio;     /**< Chave (nome, tipo, prioridade) */
+    int repeticoes;           /**< Amostras */
+    long long medianaNs;      /**< Mediana do tempo de parede (ns; por consulta nas buscas) */
+    long long p99Ns;          /**< p99 do tempo de parede */
+    double comparacoes;       /**< Comparações (médias por consulta nas buscas) */
+    double trocas;            /**< Trocas/movimentos */
+    long long bytesMovidos;   /**< Bytes de registros/chaves copiados (tráfego de memória da ordenação) */
+    long long cpuNs;          /**< Mediana do tempo de CPU */
+    long long ciclos;         /**< Mediana dos ciclos (-1 = indisponível) */
+    long long instrucoes;     /**< Mediana das instruções (-1 = indisponível) */
+    long long falhasCache;    /**< Mediana das falhas de cache (-1 = indisponível) */
+    long long falhasDesvio;   /**< Mediana dos desvios mal previstos (-1 = indisponível) */
+} ResultadoBenchmark;
+
+/**
+ * @brief Preenche os campos de tempo/contadores do resultado a partir das amostras
+ * @param divisor Divide os valores (ex: número de consultas para obter o custo por consulta)
+ */
+static void resumirMedicoes(ResultadoBenchmark *res, Medicao amostras[], int n, long long divisor, long long tmp[]) {
+    for(int i = 0; i < n; i++)
+        tmp[i] = amostras[i].tempoParedeNs / divisor;
+    resumirAmostras(tmp, n, &res->medianaNs, &res->p99Ns);
+    res->cpuNs = medianaCampo(amostras, n, offsetof(Medicao, tempoCpuNs), tmp) / divisor;
+
+    size_t campos[4] = {offsetof(Medicao, ciclos), offsetof(Medicao, instrucoes), offsetof(Medicao, falhasCache),
+                        offsetof(Medicao, falhasDesvio)};
+    long long *destinos[4] = {&res->ciclos, &res->instrucoes, &res->falhasCache, &res->falhasDesvio};
+    for(int c = 0; c < 4; c++) {
+        long long v = medianaCampo(amostras, n, campos[c], tmp);
+        *destinos[c] = v < 0 ? -1 : v / divisor;
+    }
+}
+
+/** @brief Grava uma linha do relatório no formato escolhido */
+static void gravarResultado(FILE *saida, FormatoSaida formato, const ResultadoBenchmark *r, int primeiro) {
+    if(formato == SAIDA_CSV) {
+        fprintf(saida, "%s,%d,%s,%s,%s,%d,%lld,%lld,%.2f,%.2f,%lld,%lld,%lld,%lld,%lld,%lld\n", r->suite, r->tamanho,
+                r->distribuicao, r->algoritmo, r->criterio, r->repeticoes, r->medianaNs, r->p99Ns, r->comparacoes,
+                r->trocas, r->bytesMovidos, r->cpuNs, r->ciclos, r->instrucoes, r->falhasCache, r->falhasDesvio);
+    } else {
+        fprintf(saida,
+                "%s  {\"suite\": \"%s\", \"tamanho\": %d, \"distribuicao\": \"%s\", \"algoritmo\": \"%s\", "
+                "\"criterio\": \"%s\", \"repeticoes\": %d, \"mediana_ns\": %lld, \"p99_ns\": %lld, "
+                "\"comparacoes\": %.2f, \"trocas\": %.2f, \"bytes_movidos\": %lld, \"cpu_ns\": %lld, \"ciclos\": %lld, \"instrucoes\": %lld, "
+                "\"falhas_cache\": %lld, \"falhas_desvio\": %lld}",
+                primeiro ? "" : ",\n", r->suite, r->tamanho, r->distribuicao, r->algoritmo, r->criterio,
+                r->repeticoes, r->medianaNs, r->p99Ns, r->comparacoes, r->trocas, r->bytesMovidos, r->cpuNs, r->ciclos, r->instrucoes,
+                r->falhasCache, r->falhasDesvio);
+    }
+}
+
+/** @brief Bytes que o alocador de fato reservou para um bloco de pedido bytes (com cabeçalho) */
+static size_t bytesAlocador(void *bloco, size_t pedido) {
+#ifdef __GLIBC__
+    (void)pedido;
+    return malloc_usable_size(bloco) + sizeof(size_t);
+#else
+    (void)bloco;
+    return (pedido + sizeof(size_t) + 15) & ~(size_t)15;
+#endif
+}
+
+/**
+ * @brief Prefixo no vetor ordenado: limite inferior por busca binária e varredura em ordem
+ * @return Componentes com o prefixo visitados (no máximo maximo); referência da busca por prefixo
+ */
+static int buscaPrefixoVetor(const Componente arr[], int tamanho, const char prefixo[], int maximo) {
+    size_t tamanhoPrefixo = strlen(prefixo);
+    int baixo = 0, alto = tamanho;
+    while(baixo < alto) {
+        int meio = baixo + (alto - baixo) / 2;
+        if(strcmp(arr[meio].nome, prefixo) < 0)
+            baixo = meio + 1;
+        else
+            alto = meio;
+    }
+    int total = 0;
+    while(baixo + total < tamanho && total < maximo && strncmp(arr[baixo + total].nome, prefixo, tamanhoPrefixo) == 0)
+        total++;
+    return total;
+}
+
+/**
+ * @brief Distância de edição (Levenshtein) entre a e b, saturada em limite + 1
+ * @details Para a linha assim que nenhuma célula cabe no limite; é a varredura
+ *          de referência da busca aproximada
+ */
+static int distanciaEdicaoLimitada(const char a[], const char b[], int limite) {
+    int linha[MAX_STR_LEN + 1], tamanhoB = (int)strnlen(b, MAX_STR_LEN);
+    for(int j = 0; j <= tamanhoB; j++)
+        linha[j] = j;
+    for(int i = 1; a[i - 1] != '\0'; i++) {
+        int diagonal = linha[0], menor = linha[0] = i;
+        for(int j = 1; j <= tamanhoB; j++) {
+            int v = diagonal + (a[i - 1] != b[j - 1]);
+            if(linha[j] + 1 < v)
+                v = linha[j] + 1;
+            if(linha[j - 1] + 1 < v)
+                v = linha[j - 1] + 1;
+            diagonal = linha[j];
+            linha[j] = v;
+            if(v < menor)
+                menor = v;
+        }
+        if(menor > limite)
+            return limite + 1;
+    }
+    return linha[tamanhoB] <= limite ? linha[tamanhoB] : limite + 1;
+}
+
+/**
+ * @brief Executa o benchmark completo
+ *
+ * Metodologia:
+ * - Cada medição parte de uma cópia intacta do inventário gerado
+ * - Cada amostra é uma Medicao (parede, CPU e, com --perf, contadores de hardware);
+ *   mediana e p99 do tempo de parede, medianas dos demais campos
+ * - Algoritmos O(n²) só rodam até cfg->limiteQuadratico
+ * - Buscas: metade das consultas acerta (nomes do inventário), metade erra;
+ *   tempo e comparações reportados por consulta; bytes_movidos = memória do índice
+ * - Busca aproximada: prefixos de nomes existentes (10 primeiros resultados) e
+ *   nomes com 1 ou 2 erros de digitação (distância de edição <= 2);
+ *   trocas = resultados por consulta
+ * - Memória: cria n registros, descarta 1/4, recria os descartados e libera
+ *   tudo; trocas = chamadas ao alocador e bytes_movidos = bytes ocupados no pico
+ */
+int executarBenchmark(const ConfiguracaoBenchmark *cfg) {
+    static const char *nomesAlgoritmo[TOTAL_ALGORITMOS] = {"classico", "introsort", "mergesort", "radixsort",
+                                                           "chaves",   "paralelo",  "contagem",  "adaptativo"};
+    static const char *nomesCriterio[TOTAL_CRITERIOS] = {"nome", "tipo", "prioridade"};
+    static const char *nomesBusca[7] = {"binaria_vetor", "indice_hash", "indice_ordenado", "binaria_paralela",
+                                        "eytzinger", "lote_ordenado", "radix"};
+    static const char *nomesSecundario[4] = {"indice_tipo", "varredura_tipo", "indice_faixa_prioridade",
+                                             "varredura_faixa_prioridade"};
+    static const char *nomesTopK[3] = {"heap_topk10", "selecao_completa", "introsort_completo"};
+    static const char *nomesMemoria[3] = {"vetor_inline", "malloc_por_item", "arena"};
+    static const char *nomesListagem[2] = {"printf_por_linha", "buffer_write"};
+    static const char *nomesDiario[3] = {"fsync_por_operacao", "group_commit", "replay"};
+
+    FILE *saida = stdout;
+    if(cfg->arquivoSaida != NULL && (saida = fopen(cfg->arquivoSaida, "w")) == NULL) {
+        fprintf(stderr, "[ERRO] Nao foi possivel criar '%s'.\n", cfg->arquivoSaida);
+        return 1;
+    }
+    int repeticoes = cfg->repeticoes > 0 ? cfg->repeticoes : 1;
+    int consultas = cfg->consultas > 0 ? cfg->consultas : 1;
+    int tamanhoMaximo = cfg->tamanhoMaximo >= 10 ? cfg->tamanhoMaximo : 10;
+    int divergencias = 0; // Verificações de corretude que falharam (saída 1)
+
+    Componente *base = malloc((size_t)tamanhoMaximo * sizeof(Componente));
+    Componente *trabalho = malloc((size_t)tamanhoMaximo * sizeof(Componente));
+    long long *amostras = malloc((size_t)repeticoes * sizeof(long long));
+    Medicao *medicoes = malloc((size_t)repeticoes * sizeof(Medicao));
+    char (*nomesConsulta)[MAX_STR_LEN] = malloc((size_t)consultas * MAX_STR_LEN);
+    int *resultadosConsulta = malloc((size_t)consultas * sizeof(int));
+    RegistroArena **registros = malloc((size_t)tamanhoMaximo * sizeof(RegistroArena *));
+    if(base == NULL || trabalho == NULL || amostras == NULL || medicoes == NULL || nomesConsulta == NULL ||
+       resultadosConsulta == NULL || registros == NULL) {
+        fprintf(stderr, "[ERRO] Memoria insuficiente para o benchmark (n = %d).\n", tamanhoMaximo);
+        free(base);
+        free(trabalho);
+        free(amostras);
+        free(medicoes);
+        free(nomesConsulta);
+        free(resultadosConsulta);
+        free(registros);
+        if(saida != stdout)
+            fclose(saida);
+        return 1;
+    }
+
+    if(cfg->formato == SAIDA_CSV)
+        fprintf(saida, "suite,tamanho,distribuicao,algoritmo,criterio,repeticoes,mediana_ns,p99_ns,comparacoes,trocas,bytes_movidos,"
+                       "cpu_ns,ciclos,instrucoes,falhas_cache,falhas_desvio\n");
+    else
+        fprintf(saida, "[\n");
+
+    fprintf(stderr, "[BENCH] kernel de comparacao de nome/tipo: %s\n", nomeKernelComparacao(kernelComparacaoAtivo()));
+    modoSilencioso = 1;
+    calibracaoGarantir(); // Fora das medições da ordenação automática
+    int primeiro = 1;
+    for(long long tamanho = 10; tamanho <= tamanhoMaximo; tamanho *= 10) {
+        int n = (int)tamanho;
+        for(int d = 0; d < TOTAL_DISTRIBUICOES; d++) {
+            fprintf(stderr, "[BENCH] n = %d, distribuicao = %s\n", n, nomeDistribuicao((DistribuicaoDados)d));
+            gerarComponentes(base, n, (DistribuicaoDados)d, cfg->semente + (unsigned long long)n);
+
+            // -------- Ordenações: todos os pares algoritmo/critério --------
+            long long medianaMerge[TOTAL_CRITERIOS] = {0}; // Referência sequencial do speedup paralelo
+            long long medianaIntroTipo = 0, medianaContagemTipo = 0; // Referências do Counting Sort por tipo
+            long long medianaIntroNome = 0; // Referência do TimSort (sequências já ordenadas)
+            long long melhorMediana[TOTAL_CRITERIOS] = {0}; // Referência da ordenação automática
+            for(int a = 0; a < TOTAL_ALGORITMOS; a++) {
+                if(a == ALGORITMO_CLASSICO && n > cfg->limiteQuadratico)
+                    continue; // O(n²) inviável neste tamanho
+                for(int c = 0; c < TOTAL_CRITERIOS; c++) {
+                    void (*ordenar)(Componente[], int) = funcaoOrdenacao((AlgoritmoOrdenacao)a, (CriterioOrdenacao)c);
+                    for(int r = 0; r < repeticoes; r++) {
+                        memcpy(trabalho, base, (size_t)n * sizeof(Componente));
+                        medirAlgoritmo(ordenar, trabalho, n, &medicoes[r]);
+                    }
+                    ResultadoBenchmark res = {"ordenacao", n, nomeDistribuicao((DistribuicaoDados)d), nomesAlgoritmo[a],
+                                              nomesCriterio[c], repeticoes, 0, 0, comparacoesVetor, trocasVetor, bytesMovidosVetor, 0, 0, 0, 0, 0};
+                    resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                    gravarResultado(saida, cfg->formato, &res, primeiro);
+                    primeiro = 0;
+                    if(a == ALGORITMO_INTROSORT && c == CRITERIO_TIPO)
+                        medianaIntroTipo = res.medianaNs;
+                    else if(a == ALGORITMO_INTROSORT && c == CRITERIO_NOME)
+                        medianaIntroNome = res.medianaNs;
+                    else if(a == ALGORITMO_ADAPTATIVO && c == CRITERIO_NOME && res.medianaNs > 0)
+                        fprintf(stderr, "[BENCH] speedup adaptativo x introsort (nome): %.2fx, %.0f comparacoes (n = %d)\n",
+                                (double)medianaIntroNome / res.medianaNs, res.comparacoes, n);
+                    else if(a == ALGORITMO_CONTAGEM && c == CRITERIO_TIPO)
+                        medianaContagemTipo = res.medianaNs;
+                    if(melhorMediana[c] == 0 || res.medianaNs < melhorMediana[c])
+                        melhorMediana[c] = res.medianaNs;
+                    if(a == ALGORITMO_MERGESORT)
+                        medianaMerge[c] = res.medianaNs;
+                    else if(a == ALGORITMO_PARALELO && res.medianaNs > 0)
+                        fprintf(stderr, "[BENCH] speedup merge paralelo x sequencial (%s): %.2fx com %d threads\n",
+                                nomesCriterio[c], (double)medianaMerge[c] / res.medianaNs, threadsTrabalho());
+                }
+            }
+
+            // -------- Automática: amostragem + algoritmo escolhido pela calibração --------
+            for(int c = 0; c < TOTAL_CRITERIOS; c++) {
+                AlgoritmoOrdenacao escolhido = ALGORITMO_INTROSORT;
+                for(int r = 0; r < repeticoes; r++) {
+                    memcpy(trabalho, base, (size_t)n * sizeof(Componente));
+                    medicaoIniciar(&medicoes[r]);
+                    escolhido = ordenarAutomatico(trabalho, n, (CriterioOrdenacao)c);
+                    medicaoFinalizar(&medicoes[r]);
+                }
+                ResultadoBenchmark res = {"ordenacao", n, nomeDistribuicao((DistribuicaoDados)d), "automatico",
+                                          nomesCriterio[c], repeticoes, 0, 0, comparacoesVetor, trocasVetor, bytesMovidosVetor, 0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+                if(res.medianaNs > 0)
+                    fprintf(stderr, "[BENCH] automatico (%s) escolheu %s: %.2fx o tempo do melhor medido\n",
+                            nomesCriterio[c], nomeAlgoritmo(escolhido), (double)res.medianaNs / melhorMediana[c]);
+            }
+
+            // -------- Várias chaves: uma passada do TimSort x três Merge Sorts estáveis --------
+            EspecificacaoOrdenacao espec = {3, {{CRITERIO_TIPO, 0}, {CRITERIO_PRIORIDADE, 1}, {CRITERIO_NOME, 0}}};
+            long long medianaPassadas = 0;
+            for(int t = 0; t < 2; t++) {
+                long long comparacoesCompostas = 0, trocasCompostas = 0, bytesCompostos = 0;
+                for(int r = 0; r < repeticoes; r++) {
+                    memcpy(trabalho, base, (size_t)n * sizeof(Componente));
+                    medicaoIniciar(&medicoes[r]);
+                    if(t == 0) {
+                        ordenarPorEspecificacao(trabalho, n, &espec);
+                        comparacoesCompostas = comparacoesVetor;
+                        trocasCompostas = trocasVetor;
+                        bytesCompostos = bytesMovidosVetor;
+                    } else { // Da última chave para a primeira
+                        comparacoesCompostas = trocasCompostas = bytesCompostos = 0;
+                        for(int k = espec.total - 1; k >= 0; k--) {
+                            ordenarComponentes(trabalho, n, ALGORITMO_MERGESORT, espec.chaves[k].campo);
+                            comparacoesCompostas += comparacoesVetor;
+                            trocasCompostas += trocasVetor;
+                            bytesCompostos += bytesMovidosVetor;
+                        }
+                    }
+                    medicaoFinalizar(&medicoes[r]);
+                }
+                ResultadoBenchmark res = {"ordenacao", n, nomeDistribuicao((DistribuicaoDados)d),
+                                          t == 0 ? "adaptativo_composto" : "mergesort_3_passadas",
+                                          "tipo+prioridade+nome", repeticoes, 0, 0, comparacoesCompostas,
+                                          trocasCompostas, bytesCompostos, 0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+                if(t == 0)
+                    medianaPassadas = res.medianaNs;
+                else if(medianaPassadas > 0)
+                    fprintf(stderr, "[BENCH] speedup varias chaves, uma passada x 3 merge sorts: %.2fx\n",
+                            (double)res.medianaNs / medianaPassadas);
+            }
+
+            // -------- Buscas: vetor ordenado, índice hash e índice ordenado --------
+            unsigned long long estado = cfg->semente ^ 0x9E3779B97F4A7C15ULL;
+            for(int q = 0; q < consultas; q++) {
+                unsigned long long r = proximoAleatorio(&estado);
+                if(q % 2 == 0)
+                    strcpy(nomesConsulta[q], base[r % (unsigned)n].nome); // Acerto
+                else
+                    snprintf(nomesConsulta[q], MAX_STR_LEN, "ausente-%08x", (unsigned)r); // Erro
+            }
+
+            Mochila mochila;
+            mochilaIniciar(&mochila, 0);
+            for(int i = 0; i < n; i++)
+                adicionarComponente(&mochila, &base[i]);
+            memcpy(trabalho, base, (size_t)n * sizeof(Componente));
+            introSortNome(trabalho, n);
+
+            IndiceEytzinger eytzinger = {0}; // Mesmo vetor ordenado da busca binária, em layout de largura
+            eytzingerConstruir(&eytzinger, trabalho, NULL, n);
+            IndiceRadix radix = {0}; // Árvore radix sobre o mesmo vetor ordenado
+            radixConstruir(&radix, trabalho, NULL, n);
+
+            long long medianaBinaria = 0; // Referência dos speedups da busca paralela, da Eytzinger e da radix
+            for(int b = 0; b < 7; b++) {
+                long long totalComparacoes = 0;
+                for(int r = 0; r < repeticoes; r++) {
+                    totalComparacoes = 0;
+                    medicaoIniciar(&medicoes[r]);
+                    if(b == 3) { // Todas as consultas de uma vez, divididas entre as threads
+                        buscaBinariaParalela(trabalho, n, nomesConsulta, consultas, resultadosConsulta);
+                        totalComparacoes = comparacoesVetor;
+                    } else if(b == 5) { // Todas as consultas ordenadas e resolvidas em uma passada
+                        buscaEmLotePorNome(trabalho, n, nomesConsulta, consultas, resultadosConsulta);
+                        totalComparacoes = comparacoesVetor;
+                    }
+                    for(int q = 0; b != 3 && b != 5 && q < consultas; q++) {
+                        if(b == 0)
+                            buscaBinariaPorNome(trabalho, n, nomesConsulta[q]);
+                        else if(b == 1)
+                            mochilaBuscarPorNome(&mochila, nomesConsulta[q]);
+                        else if(b == 2)
+                            mochilaBuscaBinariaIndexada(&mochila, nomesConsulta[q]);
+                        else if(b == 4)
+                            eytzingerBuscar(&eytzinger, nomesConsulta[q]);
+                        else
+                            radixBuscar(&radix, nomesConsulta[q]);
+                        totalComparacoes += comparacoesVetor;
+                    }
+                    medicaoFinalizar(&medicoes[r]);
+                }
+                ResultadoBenchmark res = {"busca", n, nomeDistribuicao((DistribuicaoDados)d), nomesBusca[b], "nome",
+                                          repeticoes, 0, 0, (double)totalComparacoes / consultas, 0,
+                                          b == 6 ? (long long)radixMemoriaBytes(&radix) : 0, 0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, consultas, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+                if(b == 0)
+                    medianaBinaria = res.medianaNs;
+                else if(b == 3 && res.medianaNs > 0)
+                    fprintf(stderr, "[BENCH] speedup busca binaria paralela x sequencial: %.2fx com %d threads\n",
+                            (double)medianaBinaria / res.medianaNs, threadsTrabalho());
+                else if(b == 4 && res.medianaNs > 0)
+                    fprintf(stderr, "[BENCH] speedup busca eytzinger x binaria: %.2fx\n",
+                            (double)medianaBinaria / res.medianaNs);
+                else if(b == 5 && res.medianaNs > 0)
+                    fprintf(stderr, "[BENCH] vazao busca em lote x binaria em laco: %.0f x %.0f consultas/s (%.2fx)\n",
+                            1e9 / res.medianaNs, medianaBinaria > 0 ? 1e9 / medianaBinaria : 0.0,
+                            (double)medianaBinaria / res.medianaNs);
+                else if(b == 6 && res.medianaNs > 0)
+                    fprintf(stderr, "[BENCH] busca radix x binaria: %.2fx | memoria %.1f bytes/nome (%d nos, vetor: %zu)\n",
+                            (double)medianaBinaria / res.medianaNs, (double)radixMemoriaBytes(&radix) / n,
+                            radix.totalNos, sizeof(Componente));
+            }
+            eytzingerLiberar(&eytzinger);
+
+            // -------- Busca aproximada: árvore radix x vetor ordenado / varredura --------
+            // Prefixos de 8 caracteres ("item-" + 3 dígitos) e nomes com 1 ou 2 caracteres trocados
+            int consultasAproximadas = consultas < 100 ? consultas : 100;
+            for(int q = 0; q < consultasAproximadas; q++) {
+                unsigned long long r = proximoAleatorio(&estado);
+                strcpy(nomesConsulta[q], base[r % (unsigned)n].nome);
+                if(q % 2 == 0) {
+                    nomesConsulta[q][8] = '\0';
+                } else {
+                    size_t tamanho = strlen(nomesConsulta[q]);
+                    for(int e = 0; e <= (int)((r >> 40) & 1); e++)
+                        nomesConsulta[q][5 + (r >> (48 + 4 * e)) % (tamanho - 5)] = "0123456789abcdef"[(r >> (56 + 4 * e)) & 15];
+                }
+            }
+            // A varredura custa O(n) distâncias de edição por consulta: limita o total a ~2e7
+            int consultasVarredura = (int)(20000000LL / n) / 2 * 2;
+            if(consultasVarredura < 2)
+                consultasVarredura = 2;
+            if(consultasVarredura > consultasAproximadas)
+                consultasVarredura = consultasAproximadas;
+            static const char *nomesAproximada[4] = {"prefixo_radix", "prefixo_binaria", "levenshtein2_radix",
+                                                     "levenshtein2_varredura"};
+            long long medianaAproximada[4] = {0};
+            for(int t = 0; consultasAproximadas >= 2 && t < 4; t++) {
+                int primeiraConsulta = t < 2 ? 0 : 1, totalConsultas = t == 3 ? consultasVarredura : consultasAproximadas;
+                long long totalComparacoes = 0, totalResultados = 0;
+                for(int r = 0; r < repeticoes; r++) {
+                    totalComparacoes = totalResultados = 0;
+                    medicaoIniciar(&medicoes[r]);
+                    for(int q = primeiraConsulta; q < totalConsultas; q += 2) {
+                        int primeiroPrefixo, encontrados = 0;
+                        SugestaoNome *sugestoes = NULL;
+                        switch(t) {
+                        case 0:
+                            encontrados = radixPrefixo(&radix, nomesConsulta[q], &primeiroPrefixo);
+                            encontrados = encontrados < 10 ? encontrados : 10;
+                            totalComparacoes += comparacoesVetor;
+                            break;
+                        case 1:
+                            encontrados = buscaPrefixoVetor(trabalho, n, nomesConsulta[q], 10);
+                            break;
+                        case 2:
+                            encontrados = radixAproximado(&radix, nomesConsulta[q], 2, &sugestoes);
+                            free(sugestoes);
+                            totalComparacoes += comparacoesVetor;
+                            break;
+                        default:
+                            for(int i = 0; i < n; i++)
+                                encontrados += distanciaEdicaoLimitada(trabalho[i].nome, nomesConsulta[q], 2) <= 2;
+                            totalComparacoes += n;
+                            break;
+                        }
+                        totalResultados += encontrados;
+                    }
+                    medicaoFinalizar(&medicoes[r]);
+                }
+                int medidas = (totalConsultas - primeiraConsulta + 1) / 2;
+                ResultadoBenchmark res = {"busca_aproximada", n, nomeDistribuicao((DistribuicaoDados)d),
+                                          nomesAproximada[t], "nome", repeticoes, 0, 0,
+                                          (double)totalComparacoes / medidas, totalResultados / medidas,
+                                          t % 2 == 0 ? (long long)radixMemoriaBytes(&radix) : 0, 0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, medidas, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+                medianaAproximada[t] = res.medianaNs;
+            }
+            if(medianaAproximada[0] > 0 && medianaAproximada[2] > 0)
+                fprintf(stderr, "[BENCH] radix x vetor: prefixo %.2fx | levenshtein<=2 %.1fx a varredura\n",
+                        (double)medianaAproximada[1] / medianaAproximada[0],
+                        (double)medianaAproximada[3] / medianaAproximada[2]);
+            radixLiberar(&radix);
 
-        // ============== CASO 0: ENCERRAR PROGRAMA ==============
-        case 0:
-            printf("\n");
-            printf("========================================================\n");
-            printf("  TORRE DE FUGA ATIVADA! Preparando para evacuacao...\n");
-            printf("========================================================\n");
-            printf("Sistema encerrado com sucesso.\n");
-            break;
+            // -------- Top-K por prioridade: heap mantido x ordenação completa --------
+            const int k = 10;
+            for(int t = 0; t < 3; t++) {
+                if(t == 1 && n > cfg->limiteQuadratico)
+                    continue; // Selection sort completo é O(n²)
+                long long comparacoesTopK = 0;
+                for(int r = 0; r < repeticoes; r++) {
+                    if(t > 0)
+                        memcpy(trabalho, base, (size_t)n * sizeof(Componente));
+                    medicaoIniciar(&medicoes[r]);
+                    if(t == 0) {
+                        int total;
+                        free(mochilaTopK(&mochila, k, &total));
+                    } else {
+                        funcaoOrdenacao(t == 1 ? ALGORITMO_CLASSICO : ALGORITMO_INTROSORT, CRITERIO_PRIORIDADE)(trabalho, n);
+                    }
+                    medicaoFinalizar(&medicoes[r]);
+                    comparacoesTopK = comparacoesVetor;
+                }
+                ResultadoBenchmark res = {"topk", n, nomeDistribuicao((DistribuicaoDados)d), nomesTopK[t], "prioridade",
+                                          repeticoes, 0, 0, comparacoesTopK, t == 0 ? 0 : trocasVetor, bytesMovidosVetor, 0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+            }
 
-        // ============== CASO PADRÃO: OPÇÃO INVÁLIDA ==============
-        default:
-            printf("\n[ERRO] Opcao invalida! Escolha entre 0-5.\n");
-        }
+            // -------- Índices secundários x varredura completa --------
+            for(int t = 0; t < 4; t++) {
+                long long comparacoesSecundario = 0;
+                volatile int encontradosSecundario = 0; // Impede o compilador de descartar as varreduras
+                for(int r = 0; r < repeticoes; r++) {
+                    const char *tipo = base[(int)(((long long)r * 7919) % n)].tipo;
+                    int total = 0;
+                    medicaoIniciar(&medicoes[r]);
+                    switch(t) {
+                    case 0: // "todos do tipo X": o grupo já está pronto
+                        mochilaBuscarPorTipo(&mochila, tipo, &total, NULL);
+                        comparacoesSecundario = comparacoesVetor;
+                        break;
+                    case 1:
+                        for(int i = 0; i < n; i++)
+                            total += strcmp(mochila.itens[i].tipo, tipo) == 0;
+                        comparacoesSecundario = n;
+                        break;
+                    case 2: // Prioridades 8..10, em ordem
+                        free(mochilaBuscarFaixaPrioridade(&mochila, 8, 10, &total));
+                        comparacoesSecundario = comparacoesVetor;
+                        break;
+                    default:
+                        for(int i = 0; i < n; i++)
+                            total += mochila.itens[i].prioridade >= 8 && mochila.itens[i].prioridade <= 10;
+                        comparacoesSecundario = 2LL * n;
+                        break;
+                    }
+                    encontradosSecundario = total;
+                    medicaoFinalizar(&medicoes[r]);
+                }
+                (void)encontradosSecundario;
+                ResultadoBenchmark res = {"secundario", n, nomeDistribuicao((DistribuicaoDados)d), nomesSecundario[t],
+                                          t < 2 ? "tipo" : "prioridade", repeticoes, 0, 0, comparacoesSecundario, 0, 0,
+                                          0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+            }
 
-        // Pausa para leitura do resultado (exceto ao sair)
-        if(opcao != 0) {
-            printf("\nPressione ENTER para continuar...");
-            getchar();
+            // -------- Counting Sort por tipo com os ids calculados na inserção da mochila --------
+            uint16_t *idsTrabalho = malloc((size_t)n * 2 * sizeof(uint16_t));
+            Componente *auxContagem = malloc((size_t)n * sizeof(Componente));
+            if(idsTrabalho != NULL && auxContagem != NULL) {
+                ContextoOrdenacao ctx = {CRITERIO_TIPO, 0, 0, 0, NULL};
+                for(int r = 0; r < repeticoes; r++) {
+                    memcpy(trabalho, mochila.itens, (size_t)n * sizeof(Componente));
+                    memcpy(idsTrabalho, mochila.idsTipo, (size_t)n * sizeof(uint16_t));
+                    ctx.trocas = ctx.bytesMovidos = 0;
+                    medicaoIniciar(&medicoes[r]);
+                    dicionarioTiposOrdenar(&mochila.tipos);
+                    contagemSortTipoContexto(trabalho, auxContagem, idsTrabalho, idsTrabalho + n, n, &mochila.tipos, &ctx);
+                    medicaoFinalizar(&medicoes[r]);
+                }
+                ResultadoBenchmark res = {"ordenacao", n, nomeDistribuicao((DistribuicaoDados)d), "contagem_ids", "tipo",
+                                          repeticoes, 0, 0, 0, ctx.trocas, ctx.bytesMovidos, 0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+                if(res.medianaNs > 0 && medianaContagemTipo > 0)
+                    fprintf(stderr, "[BENCH] speedup contagem x introsort (tipo): %.2fx (vetor avulso), %.2fx (ids da insercao)\n",
+                            (double)medianaIntroTipo / medianaContagemTipo, (double)medianaIntroTipo / res.medianaNs);
+            }
+            free(idsTrabalho);
+            free(auxContagem);
+
+            // -------- Armazenamento: vetor inline x malloc por item x arena --------
+            double kbMemoria[3];
+            long long alocacoesMemoria[3];
+            for(int t = 0; t < 3; t++) {
+                size_t bytesOcupados = 0;
+                long long alocacoes = 0;
+                for(int r = 0; r < repeticoes; r++) {
+                    bytesOcupados = 0;
+                    alocacoes = 0;
+                    medicaoIniciar(&medicoes[r]);
+                    if(t == 0) { // Registros de 60 bytes num vetor que dobra; descarte = último ocupa o buraco
+                        Mochila vetor;
+                        mochilaIniciar(&vetor, 0);
+                        for(int i = 0; i < n; i++) {
+                            int capacidadeAntes = vetor.capacidade;
+                            if(!mochilaReservar(&vetor, i + 1))
+                                break;
+                            alocacoes += vetor.capacidade != capacidadeAntes;
+                            vetor.itens[vetor.quantidade++] = base[i];
+                        }
+                        for(int i = (n - 1) / 4 * 4; i >= 0; i -= 4)
+                            vetor.itens[i] = vetor.itens[--vetor.quantidade];
+                        for(int i = 0; i < n; i += 4)
+                            vetor.itens[vetor.quantidade++] = base[i];
+                        bytesOcupados = (size_t)vetor.capacidade * sizeof(Componente);
+                        mochilaLiberar(&vetor);
+                    } else if(t == 1) { // Registro + duas cópias de string por item, cada um com seu malloc
+                        for(int i = 0; i < n; i++) {
+                            registros[i] = malloc(sizeof(RegistroArena));
+                            registros[i]->nome = strdup(base[i].nome);
+                            registros[i]->tipo = strdup(base[i].tipo);
+                            registros[i]->quantidade = base[i].quantidade;
+                            registros[i]->prioridade = base[i].prioridade;
+                        }
+                        for(int i = 0; i < n; i += 4) {
+                            free((char *)registros[i]->nome);
+                            free((char *)registros[i]->tipo);
+                            free(registros[i]);
+                        }
+                        for(int i = 0; i < n; i += 4) {
+                            registros[i] = malloc(sizeof(RegistroArena));
+                            registros[i]->nome = strdup(base[i].nome);
+                            registros[i]->tipo = strdup(base[i].tipo);
+                            registros[i]->quantidade = base[i].quantidade;
+                            registros[i]->prioridade = base[i].prioridade;
+                        }
+                        alocacoes = 3LL * (n + (n + 3) / 4);
+                        bytesOcupados = (size_t)n * sizeof(RegistroArena *);
+                        for(int i = 0; i < n; i++) {
+                            bytesOcupados += bytesAlocador(registros[i], sizeof(RegistroArena)) +
+                                             bytesAlocador((char *)registros[i]->nome, strlen(registros[i]->nome) + 1) +
+                                             bytesAlocador((char *)registros[i]->tipo, strlen(registros[i]->tipo) + 1);
+                            free((char *)registros[i]->nome);
+                            free((char *)registros[i]->tipo);
+                            free(registros[i]);
+                        }
+                    } else { // Strings internadas, registros da lista de livres, liberação em bloco
+                        ArmazemArena armazem;
+                        armazemIniciar(&armazem);
+                        for(int i = 0; i < n; i++)
+                            registros[i] = armazemCriar(&armazem, base[i].nome, base[i].tipo, base[i].quantidade,
+                                                        base[i].prioridade);
+                        for(int i = 0; i < n; i += 4)
+                            armazemDescartar(&armazem, registros[i]);
+                        for(int i = 0; i < n; i += 4)
+                            registros[i] = armazemCriar(&armazem, base[i].nome, base[i].tipo, base[i].quantidade,
+                                                        base[i].prioridade);
+                        alocacoes = armazem.alocacoesSistema;
+                        bytesOcupados = (size_t)n * sizeof(RegistroArena *) + armazemMemoriaBytes(&armazem);
+                        armazemLiberar(&armazem);
+                    }
+                    medicaoFinalizar(&medicoes[r]);
+                }
+                ResultadoBenchmark res = {"memoria", n, nomeDistribuicao((DistribuicaoDados)d), nomesMemoria[t],
+                                          "registros", repeticoes, 0, 0, 0, (double)alocacoes, (long long)bytesOcupados,
+                                          0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+                kbMemoria[t] = bytesOcupados / 1024.0;
+                alocacoesMemoria[t] = alocacoes;
+            }
+            fprintf(stderr, "[BENCH] memoria (KB / alocacoes): %s %.1f / %lld | %s %.1f / %lld | %s %.1f / %lld\n",
+                    nomesMemoria[0], kbMemoria[0], alocacoesMemoria[0], nomesMemoria[1], kbMemoria[1],
+                    alocacoesMemoria[1], nomesMemoria[2], kbMemoria[2], alocacoesMemoria[2]);
+
+            // -------- Listagem: printf por linha x buffer + write, para /dev/null --------
+            FILE *nulo = d == DIST_ALEATORIA ? fopen("/dev/null", "w") : NULL; // O texto independe da distribuição
+            double linhasPorSegundo[2] = {0, 0};
+            for(int t = 0; nulo != NULL && t < 2; t++) {
+                EstatisticasListagem custo = {0, 0, 0, 0};
+                for(int r = 0; r < repeticoes; r++) {
+                    medicaoIniciar(&medicoes[r]);
+                    if(t == 0) { // Caminho original de mostrarComponentes
+                        fprintf(nulo, "\n--- INVENTARIO ATUAL (%d componentes) ---\n", n);
+                        for(int i = 0; i < n; i++)
+                            fprintf(nulo, "%-20s | %-15s | %-11d | %-10d\n", base[i].nome, base[i].tipo,
+                                    base[i].quantidade, base[i].prioridade);
+                        fflush(nulo);
+                    } else {
+                        escreverComponentes(nulo, base, n, 0, 0, &custo);
+                    }
+                    medicaoFinalizar(&medicoes[r]);
+                }
+                ResultadoBenchmark res = {"listagem", n, nomeDistribuicao((DistribuicaoDados)d), nomesListagem[t],
+                                          "linhas", repeticoes, 0, 0, 0, (double)custo.escritas, custo.bytes,
+                                          0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+                linhasPorSegundo[t] = res.medianaNs > 0 ? n * 1e9 / res.medianaNs : 0;
+            }
+            if(nulo != NULL) {
+                fclose(nulo);
+                fprintf(stderr, "[BENCH] listagem (linhas/s): printf %.0f x buffer %.0f (%.2fx)\n", linhasPorSegundo[0],
+                        linhasPorSegundo[1], linhasPorSegundo[0] > 0 ? linhasPorSegundo[1] / linhasPorSegundo[0] : 0.0);
+            }
+
+            // -------- Diário: fsync por operação x group commit, e recuperação do que foi gravado --------
+            char baseDiario[64];
+            double operacoesPorSegundo[3] = {0, 0, 0};
+            snprintf(baseDiario, sizeof(baseDiario), "/tmp/ffdiario-%d", (int)getpid());
+            for(int t = 0; d == DIST_ALEATORIA && t < 3; t++) {
+                if(t == 0 && n > 10000)
+                    continue; // Um fsync por operação: lento demais nos tamanhos maiores
+                char caminho[96];
+                long long sincronizacoes = 0, bytesGravados = 0;
+                for(int r = 0; r < repeticoes; r++) {
+                    Mochila recuperada;
+                    DiarioOperacoes diario;
+                    mochilaIniciar(&recuperada, 0);
+                    if(t < 2) { // Começa do zero: sem snapshot nem diário anteriores
+                        snprintf(caminho, sizeof(caminho), "%s.wal", baseDiario);
+                        remove(caminho);
+                        snprintf(caminho, sizeof(caminho), "%s.snap", baseDiario);
+                        remove(caminho);
+                        if(!diarioAbrir(&diario, &recuperada, baseDiario, t == 0 ? 1 : 0, 0, 0))
+                            break;
+                        medicaoIniciar(&medicoes[r]);
+                        for(int i = 0; i < n; i++) {
+                            adicionarComponente(&recuperada, &base[i]);
+                            if(t == 0)
+                                diarioSincronizar(&diario); // Cada operação só retorna depois do seu fsync
+                        }
+                        diarioSincronizar(&diario);
+                        medicaoFinalizar(&medicoes[r]);
+                        sincronizacoes = diario.sincronizacoes;
+                        bytesGravados = diario.bytesGravados;
+                    } else { // Reabre o que a última repetição do group commit gravou
+                        medicaoIniciar(&medicoes[r]);
+                        if(!diarioAbrir(&diario, &recuperada, baseDiario, 0, 0, 0))
+                            break;
+                        medicaoFinalizar(&medicoes[r]);
+                        sincronizacoes = 0;
+                        bytesGravados = diario.tamanhoArquivo;
+                    }
+                    diarioFechar(&diario, &recuperada);
+                    mochilaLiberar(&recuperada);
+                }
+                ResultadoBenchmark res = {"diario", n, nomeDistribuicao((DistribuicaoDados)d), nomesDiario[t],
+                                          "operacoes", repeticoes, 0, 0, 0, (double)sincronizacoes, bytesGravados,
+                                          0, 0, 0, 0, 0};
+                resumirMedicoes(&res, medicoes, repeticoes, 1, amostras);
+                gravarResultado(saida, cfg->formato, &res, primeiro);
+                operacoesPorSegundo[t] = res.medianaNs > 0 ? n * 1e9 / res.medianaNs : 0;
+            }
+            // Verificação: um descarte que dispara a compactação não pode reaparecer na recuperação
+            if(d == DIST_ALEATORIA) {
+                int itensVerificacao = n < 5000 ? n : 5000, esperados = -1, recuperados = -2;
+                char caminho[96];
+                Mochila original, recuperada;
+                DiarioOperacoes diario;
+                snprintf(caminho, sizeof(caminho), "%s.wal", baseDiario);
+                remove(caminho);
+                snprintf(caminho, sizeof(caminho), "%s.snap", baseDiario);
+                remove(caminho);
+                mochilaIniciar(&original, 0);
+                mochilaIniciar(&recuperada, 0);
+                if(diarioAbrir(&diario, &original, baseDiario, 0, 0, 1024)) { // ~12 registros: compacta sem parar
+                    for(int i = 0; i < itensVerificacao; i++)
+                        adicionarComponente(&original, &base[i]);
+                    for(int i = 0; i < itensVerificacao; i += 3)
+                        descartarComponente(&original, base[i].nome);
+                    esperados = original.quantidade;
+                    diarioFechar(&diario, &original);
+                    if(diarioAbrir(&diario, &recuperada, baseDiario, 0, 0, 0)) {
+                        recuperados = recuperada.quantidade;
+                        diarioFechar(&diario, &recuperada);
+                    }
+                }
+                if(recuperados != esperados) {
+                    fprintf(stderr, "[ERRO] diario: %d itens recuperados apos compactacao, esperados %d (n = %d)\n",
+                            recuperados, esperados, itensVerificacao);
+                    divergencias++;
+                }
+                mochilaLiberar(&original);
+                mochilaLiberar(&recuperada);
+            }
+            if(d == DIST_ALEATORIA) {
+                char caminho[96];
+                snprintf(caminho, sizeof(caminho), "%s.wal", baseDiario);
+                remove(caminho);
+                snprintf(caminho, sizeof(caminho), "%s.snap", baseDiario);
+                remove(caminho);
+                fprintf(stderr, "[BENCH] diario (op/s): fsync por operacao %.0f x group commit %.0f | replay %.0f\n",
+                        operacoesPorSegundo[0], operacoesPorSegundo[1], operacoesPorSegundo[2]);
+            }
+
+            // -------- Kernels de comparação: mesma ordenação/busca com cada kernel disponível --------
+            KernelComparacao kernelOriginal = kernelComparacaoAtivo();
+            for(int k = 0; k < TOTAL_KERNELS; k++) {
+                if(!selecionarKernelComparacao((KernelComparacao)k))
+                    continue;
+                for(int t = 0; t < 3; t++) {
+                    char algoritmo[32];
+                    snprintf(algoritmo, sizeof(algoritmo), "%s_%s", t < 2 ? "introsort" : "binaria_vetor",
+                             nomeKernelComparacao((KernelComparacao)k));
+                    long long comparacoesKernel = 0;
+                    for(int r = 0; r < repeticoes; r++) {
+                        if(t < 2) {
+                            memcpy(trabalho, base, (size_t)n * sizeof(Componente));
+                            medirAlgoritmo(t == 0 ? introSortTipo : introSortNome, trabalho, n, &medicoes[r]);
+                            comparacoesKernel = comparacoesVetor;
+                        } else { // trabalho ficou ordenado por nome na linha anterior
+                            comparacoesKernel = 0;
+                            medicaoIniciar(&medicoes[r]);
+                            for(int q = 0; q < consultas; q++) {
+                                buscaBinariaPorNome(trabalho, n, nomesConsulta[q]);
+                                comparacoesKernel += comparacoesVetor;
+                            }
+                            medicaoFinalizar(&medicoes[r]);
+                        }
+                    }
+                    ResultadoBenchmark res = {"simd", n, nomeDistribuicao((DistribuicaoDados)d), algoritmo,
+                                              t == 0 ? "tipo" : "nome", repeticoes, 0, 0,
+                                              t < 2 ? comparacoesKernel : (double)comparacoesKernel / consultas,
+                                              t < 2 ? trocasVetor : 0, t < 2 ? bytesMovidosVetor : 0, 0, 0, 0, 0, 0};
+                    resumirMedicoes(&res, medicoes, repeticoes, t < 2 ? 1 : consultas, amostras);
+                    gravarResultado(saida, cfg->formato, &res, primeiro);
+                }
+            }
+            selecionarKernelComparacao(kernelOriginal);
+            mochilaLiberar(&mochila);
+            fflush(saida);
         }
-    } while(opcao != 0);
+    }
+    modoSilencioso = 0;
+
+    if(cfg->formato == SAIDA_JSON)
+        fprintf(saida, "\n]\n");
+    if(saida != stdout)
+        fclose(saida);
+    free(base);
+    free(trabalho);
+    free(amostras);
+    free(medicoes);
+    free(nomesConsulta);
+    free(resultadosConsulta);
+    free(registros);
+    return divergencias > 0;
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DA MEDIÇÃO DE DESEMPENHO
+// ============================================================================
+
+/** @brief Lê um relógio POSIX em nanossegundos */
+static long long lerRelogioNs(clockid_t relogio) {
+    struct timespec ts;
+    clock_gettime(relogio, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/** @def TOTAL_CONTADORES Contadores de hardware do grupo perf (ciclos, instruções, cache, desvios) */
+#define TOTAL_CONTADORES 4
 
+/**
+ * @brief Descritores do grupo perf_event (abertos uma única vez, sob demanda)
+ * @details descritoresPerf[0] é o líder do grupo; -1 = não aberto.
+ *          estadoPerf: 0 = não tentado, 1 = disponível, -1 = indisponível
+ */
+static int descritoresPerf[TOTAL_CONTADORES] = {-1, -1, -1, -1};
+static int estadoPerf = 0;
+
+/**
+ * @brief Abre o grupo de contadores de hardware do processo atual
+ * @return 1 se disponível, 0 caso contrário (o motivo é informado uma vez em stderr)
+ */
+static int abrirContadoresHardware(void) {
+    if(estadoPerf != 0)
+        return estadoPerf == 1;
+    estadoPerf = -1;
+#ifdef __linux__
+    static const unsigned long long eventos[TOTAL_CONTADORES] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+    for(int i = 0; i < TOTAL_CONTADORES; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = eventos[i];
+        attr.disabled = i == 0; // O líder controla o grupo inteiro
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : descritoresPerf[0], 0);
+        if(fd < 0) {
+            fprintf(stderr, "[AVISO] Contadores de hardware indisponiveis (perf_event_open); medindo apenas tempos.\n");
+            for(int j = 0; j < i; j++) {
+                close(descritoresPerf[j]);
+                descritoresPerf[j] = -1;
+            }
+            return 0;
+        }
+        descritoresPerf[i] = (int)fd;
+    }
+    estadoPerf = 1;
+    return 1;
+#else
+    fprintf(stderr, "[AVISO] Contadores de hardware disponiveis apenas no Linux.\n");
     return 0;
+#endif
+}
+
+/**
+ * @brief Inicia uma medição: zera e liga os contadores, marca os relógios
+ */
+void medicaoIniciar(Medicao *med) {
+    memset(med, 0, sizeof(*med));
+    med->ciclos = med->instrucoes = med->falhasCache = med->falhasDesvio = -1;
+    bytesMovidosVetor = 0; // Trechos que não ordenam não movem registros
+#ifdef __linux__
+    if(contadoresHardwareAtivos && abrirContadoresHardware()) {
+        ioctl(descritoresPerf[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(descritoresPerf[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+    med->inicioCpu = lerRelogioNs(CLOCK_PROCESS_CPUTIME_ID);
+    med->inicioParede = lerRelogioNs(CLOCK_MONOTONIC);
+}
+
+/**
+ * @brief Finaliza a medição: lê relógios (na ordem inversa do início) e contadores
+ */
+void medicaoFinalizar(Medicao *med) {
+    med->tempoParedeNs = lerRelogioNs(CLOCK_MONOTONIC) - med->inicioParede;
+    med->tempoCpuNs = lerRelogioNs(CLOCK_PROCESS_CPUTIME_ID) - med->inicioCpu;
+#ifdef __linux__
+    if(contadoresHardwareAtivos && estadoPerf == 1) {
+        unsigned long long valores[1 + TOTAL_CONTADORES]; // PERF_FORMAT_GROUP: {nr, v0, v1, ...}
+        ioctl(descritoresPerf[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        if(read(descritoresPerf[0], valores, sizeof(valores)) == (ssize_t)sizeof(valores)) {
+            med->ciclos = (long long)valores[1];
+            med->instrucoes = (long long)valores[2];
+            med->falhasCache = (long long)valores[3];
+            med->falhasDesvio = (long long)valores[4];
+        }
+    }
+#endif
+    med->comparacoes = comparacoesVetor;
+    med->trocas = trocasVetor;
+    med->bytesMovidos = bytesMovidosVetor;
+}
+
+/**
+ * @brief Executa e mede um algoritmo compatível com medirTempo
+ */
+void medirAlgoritmo(void (*algoritmo)(Componente[], int), Componente arr[], int tamanho, Medicao *med) {
+    medicaoIniciar(med);
+    algoritmo(arr, tamanho);
+    medicaoFinalizar(med);
+}
+
+/** @brief Escreve uma duração em ns com a unidade mais legível (ns, us, ms, s) */
+static void formatarDuracao(char destino[], size_t tamanho, long long ns) {
+    if(ns < 10000)
+        snprintf(destino, tamanho, "%lld ns", ns);
+    else if(ns < 10000000)
+        snprintf(destino, tamanho, "%.3f us", ns / 1e3);
+    else if(ns < 10000000000LL)
+        snprintf(destino, tamanho, "%.3f ms", ns / 1e6);
+    else
+        snprintf(destino, tamanho, "%.3f s", ns / 1e9);
+}
+
+/**
+ * @brief Exibe uma medição
+ *
+ * Formato:
+ * Tempo de parede: 12.345 us | Tempo de CPU: 12.001 us
+ * Bytes movidos: B (trafego de registros/chaves da ordenacao)
+ * Contadores: ciclos C | instrucoes I (IPC x.xx) | falhas de cache F | desvios errados D
+ */
+void mostrarMedicao(const Medicao *med) {
+    char parede[32], cpu[32];
+    formatarDuracao(parede, sizeof(parede), med->tempoParedeNs);
+    formatarDuracao(cpu, sizeof(cpu), med->tempoCpuNs);
+    printf("Tempo de parede: %s | Tempo de CPU: %s\n", parede, cpu);
+    if(med->bytesMovidos > 0)
+        printf("Bytes movidos: %lld (trafego de registros/chaves da ordenacao)\n", med->bytesMovidos);
+    if(med->ciclos >= 0)
+        printf("Contadores: ciclos %lld | instrucoes %lld (IPC %.2f) | falhas de cache %lld | desvios errados %lld\n",
+               med->ciclos, med->instrucoes, med->ciclos > 0 ? (double)med->instrucoes / med->ciclos : 0.0,
+               med->falhasCache, med->falhasDesvio);
 }
 
 // ============================================================================
-// IMPLEMENTAÇÃO DAS FUNÇÕES OBRIGATÓRIAS - DESAFIO MESTRE
+// IMPLEMENTAÇÃO DAS MÉTRICAS DE OPERAÇÃO
 // ============================================================================
 
 /**
- * @brief Exibe tabela formatada com todos os componentes da mochila
- * @param arr Array de componentes a exibir
- * @param tamanho Número de elementos a mostrar
+ * @struct FragmentoMetricas
+ * @brief Métricas de uma thread: só ela escreve, o exportador só lê
+ * @details Fragmentos nunca são liberados: quando a thread termina, o
+ *          fragmento fica livre para a próxima thread criada (conexões do
+ *          servidor vêm e vão sem fazer a lista crescer) e os contadores
+ *          continuam somando, como todo contador monotônico
+ */
+typedef struct FragmentoMetricas {
+    MetricasOperacao series[TOTAL_METRICAS];
+    struct FragmentoMetricas *proximo; /**< Lista de todos os fragmentos (só cresce, pelo início) */
+    int emUso;                         /**< 1 = pertence a uma thread viva (sob travaMetricas) */
+} FragmentoMetricas;
+
+static FragmentoMetricas *fragmentosMetricas = NULL; // Início da lista (acesso atômico)
+static pthread_mutex_t travaMetricas = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t chaveFragmento;                 // Destrutor devolve o fragmento ao fim da thread
+static pthread_once_t chaveFragmentoCriada = PTHREAD_ONCE_INIT;
+static int intervaloAmostragem = AMOSTRAGEM_METRICAS_PADRAO;
+static _Thread_local FragmentoMetricas *fragmentoLocal = NULL;
+static _Thread_local int contagemAmostragem = 0;     // Operações que faltam até a próxima amostra
+static _Thread_local int metricasPausadas = 0;       // metricasPausar(1) na thread atual
+
+/**
+ * @brief Rótulos operacao/estrutura de cada série que não é ordenação
+ * @details As ordenações usam operacao="ordenacao" e estrutura=nomeAlgoritmo
+ */
+static const char *rotulosMetricas[METRICA_ORDENACAO][2] = {
+    {"busca", "indice_hash"},      {"busca", "vetor_ordenado"}, {"busca", "indice_ordenado"},
+    {"busca", "eytzinger"},        {"intervalo", "indice_ordenado"}, {"busca_lote", "vetor_ordenado"},
+    {"busca", "snapshot"},         {"prefixo", "radix"},        {"aproximada", "radix"},
+    {"adicao", "mochila"},         {"descarte", "indice_hash"}};
+
+static void liberarFragmento(void *fragmento) {
+    pthread_mutex_lock(&travaMetricas);
+    ((FragmentoMetricas *)fragmento)->emUso = 0;
+    pthread_mutex_unlock(&travaMetricas);
+}
+
+static void criarChaveFragmento(void) { pthread_key_create(&chaveFragmento, liberarFragmento); }
+
+/**
+ * @brief Fragmento da thread atual: reaproveita um livre ou cria um novo
+ * @return Fragmento, ou NULL se faltou memória (a operação não é registrada)
+ * @details Só roda na primeira operação de cada thread; a trava garante que
+ *          o novo dono enxerga os contadores deixados pelo anterior
+ */
+static FragmentoMetricas *fragmentoDaThread(void) {
+    pthread_once(&chaveFragmentoCriada, criarChaveFragmento);
+    pthread_mutex_lock(&travaMetricas);
+    FragmentoMetricas *f = fragmentosMetricas;
+    while(f != NULL && f->emUso)
+        f = f->proximo;
+    if(f == NULL && (f = calloc(1, sizeof(FragmentoMetricas))) != NULL) {
+        f->proximo = fragmentosMetricas;
+        __atomic_store_n(&fragmentosMetricas, f, __ATOMIC_RELEASE);
+    }
+    if(f != NULL)
+        f->emUso = 1;
+    pthread_mutex_unlock(&travaMetricas);
+    if(f != NULL)
+        pthread_setspecific(chaveFragmento, f);
+    fragmentoLocal = f;
+    return f;
+}
+
+/**
+ * @brief Soma valor a um contador do próprio fragmento
+ * @details Só o dono escreve: leitura e escrita relaxadas bastam (sem prefixo
+ *          lock), e o exportador nunca lê um valor rasgado
+ */
+static inline void acumularContador(uint64_t *contador, uint64_t valor) {
+    __atomic_store_n(contador, __atomic_load_n(contador, __ATOMIC_RELAXED) + valor, __ATOMIC_RELAXED);
+}
+
+/** @brief Balde da duração: o menor i com ns <= 2^i (o último balde recebe o excedente) */
+static int baldeLatencia(long long ns) {
+    if(ns <= 1)
+        return 0;
+    int i = 64 - __builtin_clzll((unsigned long long)(ns - 1));
+    return i < BALDES_HISTOGRAMA - 1 ? i : BALDES_HISTOGRAMA - 1;
+}
+
+static void registrarSerie(TipoMetrica tipo, long long inicio, long long comparacoes, long long trocas,
+                           long long bytes, int acertos, int falhas) {
+    if(metricasPausadas)
+        return;
+    FragmentoMetricas *f = fragmentoLocal != NULL ? fragmentoLocal : fragmentoDaThread();
+    if(f == NULL)
+        return;
+    MetricasOperacao *m = &f->series[tipo];
+    acumularContador(&m->chamadas, 1);
+    acumularContador(&m->comparacoes, (uint64_t)comparacoes);
+    if(tipo >= METRICA_ORDENACAO) {
+        acumularContador(&m->trocas, (uint64_t)trocas);
+        acumularContador(&m->bytesMovidos, (uint64_t)bytes);
+    } else {
+        acumularContador(&m->acertos, (uint64_t)acertos);
+        acumularContador(&m->falhas, (uint64_t)falhas);
+    }
+    if(inicio >= 0) {
+        long long ns = lerRelogioNs(CLOCK_MONOTONIC) - inicio;
+        acumularContador(&m->amostras, 1);
+        acumularContador(&m->somaNs, (uint64_t)(ns > 0 ? ns : 0));
+        acumularContador(&m->baldes[baldeLatencia(ns)], 1);
+    }
+}
+
+void metricasConfigurar(int intervalo) { intervaloAmostragem = intervalo > 0 ? intervalo : 0; }
+
+void metricasPausar(int pausar) { metricasPausadas = pausar; }
+
+long long metricasInicio(TipoMetrica tipo) {
+    if(tipo < METRICA_ORDENACAO) {
+        if(intervaloAmostragem == 0 || contagemAmostragem-- > 0)
+            return -1;
+        contagemAmostragem = intervaloAmostragem - 1;
+    }
+    return lerRelogioNs(CLOCK_MONOTONIC);
+}
+
+void metricasRegistrar(TipoMetrica tipo, long long inicio, long long comparacoes, int acertos, int falhas) {
+    registrarSerie(tipo, inicio, comparacoes, 0, 0, acertos, falhas);
+}
+
+void metricasRegistrarOrdenacao(AlgoritmoOrdenacao algoritmo, long long inicio) {
+    registrarSerie((TipoMetrica)(METRICA_ORDENACAO + algoritmo), inicio, comparacoesVetor, trocasVetor,
+                   bytesMovidosVetor, 0, 0);
+}
+
+void metricasSomar(MetricasOperacao destino[]) {
+    const size_t campos = sizeof(MetricasOperacao) * TOTAL_METRICAS / sizeof(uint64_t);
+    uint64_t *soma = (uint64_t *)(void *)destino;
+    memset(destino, 0, sizeof(MetricasOperacao) * TOTAL_METRICAS);
+    for(FragmentoMetricas *f = __atomic_load_n(&fragmentosMetricas, __ATOMIC_ACQUIRE); f != NULL; f = f->proximo) {
+        uint64_t *origem = (uint64_t *)(void *)f->series;
+        for(size_t c = 0; c < campos; c++)
+            soma[c] += __atomic_load_n(&origem[c], __ATOMIC_RELAXED);
+    }
+}
+
+/** @brief Limite superior do balde i em ns (o último balde não tem limite: devolve o do penúltimo) */
+static long long limiteBalde(int i) {
+    return 1LL << (i < BALDES_HISTOGRAMA - 1 ? i : BALDES_HISTOGRAMA - 2);
+}
+
+/** @brief Percentil estimado pelos baldes: limite superior do balde que contém a posição q */
+static long long percentilBaldes(const MetricasOperacao *m, double q) {
+    uint64_t alvo = (uint64_t)(q * (double)m->amostras + 0.999999), acumulado = 0;
+    for(int i = 0; i < BALDES_HISTOGRAMA; i++) {
+        acumulado += m->baldes[i];
+        if(acumulado >= alvo && acumulado > 0)
+            return limiteBalde(i);
+    }
+    return 0;
+}
+
+static void rotulosSerie(int tipo, const char **operacao, const char **estrutura) {
+    if(tipo >= METRICA_ORDENACAO) {
+        *operacao = "ordenacao";
+        *estrutura = nomeAlgoritmo((AlgoritmoOrdenacao)(tipo - METRICA_ORDENACAO));
+    } else {
+        *operacao = rotulosMetricas[tipo][0];
+        *estrutura = rotulosMetricas[tipo][1];
+    }
+}
+
+/**
+ * @brief Exporta as métricas
  *
- * Formato da Tabela:
- * | NOME | TIPO | QUANTIDADE | PRIORIDADE |
- * Colunas com largura fixa para melhor legibilidade
- * Inclui separadores visuais (linhas de traço)
+ * Prometheus (um bloco HELP/TYPE por métrica, uma linha por série):
+ *   freefire_operacoes_total{operacao="busca",estrutura="indice_hash"} 1200
+ *   freefire_operacao_duracao_segundos_bucket{operacao="busca",estrutura="indice_hash",le="1.28e-07"} 70
+ *
+ * JSON:
+ *   {"amostragem": 16, "series": [{"operacao": "busca", "estrutura": "indice_hash", "chamadas": 1200, ...}]}
  */
-void mostrarComponentes(Componente arr[], int tamanho) {
-    // Validação: se a mochila está vazia
-    if(tamanho == 0) {
-        printf("\n[RELATORIO] Nenhum componente cadastrado.\n");
+void metricasExportar(FILE *saida, FormatoMetricas formato) {
+    static const struct {
+        const char *nome;
+        const char *ajuda;
+        size_t campo;
+        int ordenacao; /**< 1 = só ordenações, 0 = só as demais, -1 = todas */
+    } contadores[] = {
+        {"operacoes", "Operacoes registradas", offsetof(MetricasOperacao, chamadas), -1},
+        {"comparacoes", "Comparacoes de chave (sondagens no indice hash)", offsetof(MetricasOperacao, comparacoes), -1},
+        {"trocas", "Trocas ou registros movidos pelas ordenacoes", offsetof(MetricasOperacao, trocas), 1},
+        {"bytes_movidos", "Bytes de registros e chaves copiados pelas ordenacoes", offsetof(MetricasOperacao, bytesMovidos), 1},
+        {"acertos", "Buscas com resultado e escritas aceitas", offsetof(MetricasOperacao, acertos), 0},
+        {"falhas", "Buscas sem resultado e escritas recusadas", offsetof(MetricasOperacao, falhas), 0},
+    };
+    const int totalContadores = (int)(sizeof(contadores) / sizeof(contadores[0]));
+    MetricasOperacao total[TOTAL_METRICAS];
+    const char *operacao, *estrutura;
+    metricasSomar(total);
+
+    if(formato == METRICAS_JSON) {
+        int primeiro = 1;
+        fprintf(saida, "{\"amostragem\": %d, \"series\": [", intervaloAmostragem);
+        for(int t = 0; t < TOTAL_METRICAS; t++) {
+            const MetricasOperacao *m = &total[t];
+            if(m->chamadas == 0)
+                continue;
+            rotulosSerie(t, &operacao, &estrutura);
+            fprintf(saida, "%s\n  {\"operacao\": \"%s\", \"estrutura\": \"%s\"", primeiro ? "" : ",", operacao, estrutura);
+            for(int c = 0; c < totalContadores; c++)
+                if(contadores[c].ordenacao < 0 || contadores[c].ordenacao == (t >= METRICA_ORDENACAO))
+                    fprintf(saida, ", \"%s\": %llu", contadores[c].nome,
+                            (unsigned long long)*(const uint64_t *)(const void *)((const char *)m + contadores[c].campo));
+            if(t < METRICA_ORDENACAO && m->acertos + m->falhas > 0)
+                fprintf(saida, ", \"taxa_acerto\": %.4f", (double)m->acertos / (double)(m->acertos + m->falhas));
+            fprintf(saida, ", \"amostras\": %llu", (unsigned long long)m->amostras);
+            if(m->amostras > 0)
+                fprintf(saida, ", \"media_ns\": %llu, \"p50_ns\": %lld, \"p99_ns\": %lld",
+                        (unsigned long long)(m->somaNs / m->amostras), percentilBaldes(m, 0.50), percentilBaldes(m, 0.99));
+            fprintf(saida, "}");
+            primeiro = 0;
+        }
+        fprintf(saida, "%s]}\n", primeiro ? "" : "\n");
+        return;
+    }
+
+    fprintf(saida, "# HELP freefire_metricas_amostragem Uma a cada N buscas/adicoes/descartes tem a latencia medida (0 = nenhuma)\n");
+    fprintf(saida, "# TYPE freefire_metricas_amostragem gauge\nfreefire_metricas_amostragem %d\n", intervaloAmostragem);
+    for(int c = 0; c < totalContadores; c++) {
+        fprintf(saida, "# HELP freefire_%s_total %s\n# TYPE freefire_%s_total counter\n", contadores[c].nome,
+                contadores[c].ajuda, contadores[c].nome);
+        for(int t = 0; t < TOTAL_METRICAS; t++) {
+            if(total[t].chamadas == 0 ||
+               (contadores[c].ordenacao >= 0 && contadores[c].ordenacao != (t >= METRICA_ORDENACAO)))
+                continue;
+            rotulosSerie(t, &operacao, &estrutura);
+            fprintf(saida, "freefire_%s_total{operacao=\"%s\",estrutura=\"%s\"} %llu\n", contadores[c].nome, operacao,
+                    estrutura,
+                    (unsigned long long)*(const uint64_t *)(const void *)((const char *)&total[t] + contadores[c].campo));
+        }
+    }
+
+    fprintf(saida, "# HELP freefire_operacao_duracao_segundos Latencia das operacoes (ordenacoes: todas; demais: amostradas)\n");
+    fprintf(saida, "# TYPE freefire_operacao_duracao_segundos histogram\n");
+    for(int t = 0; t < TOTAL_METRICAS; t++) {
+        const MetricasOperacao *m = &total[t];
+        if(m->amostras == 0)
+            continue;
+        rotulosSerie(t, &operacao, &estrutura);
+        uint64_t acumulado = 0;
+        for(int i = 0; i < BALDES_HISTOGRAMA - 1; i++) {
+            acumulado += m->baldes[i];
+            fprintf(saida, "freefire_operacao_duracao_segundos_bucket{operacao=\"%s\",estrutura=\"%s\",le=\"%.9g\"} %llu\n",
+                    operacao, estrutura, (double)limiteBalde(i) / 1e9, (unsigned long long)acumulado);
+        }
+        fprintf(saida, "freefire_operacao_duracao_segundos_bucket{operacao=\"%s\",estrutura=\"%s\",le=\"+Inf\"} %llu\n",
+                operacao, estrutura, (unsigned long long)m->amostras);
+        fprintf(saida, "freefire_operacao_duracao_segundos_sum{operacao=\"%s\",estrutura=\"%s\"} %.9f\n", operacao,
+                estrutura, (double)m->somaNs / 1e9);
+        fprintf(saida, "freefire_operacao_duracao_segundos_count{operacao=\"%s\",estrutura=\"%s\"} %llu\n", operacao,
+                estrutura, (unsigned long long)m->amostras);
+    }
+}
+
+/**
+ * @brief Grava as métricas em arquivo
+ * @details Escreve em "caminho.tmp" e renomeia: quem coleta o arquivo
+ *          (ex: textfile collector do node_exporter) nunca lê um arquivo pela metade
+ */
+int metricasGravar(const char caminho[]) {
+    const char *extensao = strrchr(caminho, '.');
+    FormatoMetricas formato = extensao != NULL && strcasecmp(extensao, ".json") == 0 ? METRICAS_JSON : METRICAS_PROMETHEUS;
+    if(strcmp(caminho, "-") == 0) {
+        metricasExportar(stdout, formato);
+        return fflush(stdout) == 0;
+    }
+
+    size_t tamanho = strlen(caminho) + sizeof(".tmp");
+    char *temporario = malloc(tamanho);
+    FILE *saida = NULL;
+    if(temporario != NULL) {
+        snprintf(temporario, tamanho, "%s.tmp", caminho);
+        saida = fopen(temporario, "w");
+    }
+    if(saida == NULL) {
+        free(temporario);
+        fprintf(stderr, "[ERRO] Nao foi possivel gravar as metricas em '%s'.\n", caminho);
+        return 0;
+    }
+    metricasExportar(saida, formato);
+    int ok = !ferror(saida);
+    ok = fclose(saida) == 0 && ok && rename(temporario, caminho) == 0;
+    if(!ok) {
+        remove(temporario);
+        fprintf(stderr, "[ERRO] Nao foi possivel gravar as metricas em '%s'.\n", caminho);
+    }
+    free(temporario);
+    return ok;
+}
+
+static const char *arquivoMetricasSaida = NULL;
+
+static void gravarMetricasSaida(void) { metricasGravar(arquivoMetricasSaida); }
+
+void metricasGravarAoSair(const char caminho[]) {
+    if(arquivoMetricasSaida == NULL)
+        atexit(gravarMetricasSaida);
+    arquivoMetricasSaida = caminho;
+}
+
+/**
+ * @brief Exibe o resumo das métricas
+ *
+ * Formato (uma linha por série com chamadas):
+ * busca/indice_hash            chamadas 1200 | comparacoes 1.31/op | acertos 97.5% | p50 128 ns | p99 512 ns
+ */
+void mostrarMetricas(void) {
+    MetricasOperacao total[TOTAL_METRICAS];
+    const char *operacao, *estrutura;
+    char serie[48], p50[32], p99[32];
+    int exibidas = 0;
+    metricasSomar(total);
+    for(int t = 0; t < TOTAL_METRICAS; t++) {
+        const MetricasOperacao *m = &total[t];
+        if(m->chamadas == 0)
+            continue;
+        rotulosSerie(t, &operacao, &estrutura);
+        snprintf(serie, sizeof(serie), "%s/%s", operacao, estrutura);
+        printf("%-28s chamadas %llu | comparacoes %.2f/op", serie, (unsigned long long)m->chamadas,
+               (double)m->comparacoes / (double)m->chamadas);
+        if(t < METRICA_ORDENACAO && m->acertos + m->falhas > 0)
+            printf(" | acertos %.1f%%", 100.0 * (double)m->acertos / (double)(m->acertos + m->falhas));
+        if(m->amostras > 0) {
+            formatarDuracao(p50, sizeof(p50), percentilBaldes(m, 0.50));
+            formatarDuracao(p99, sizeof(p99), percentilBaldes(m, 0.99));
+            printf(" | p50 <= %s | p99 <= %s", p50, p99);
+        }
+        printf("\n");
+        exibidas++;
+    }
+    if(exibidas == 0)
+        printf("Nenhuma operacao registrada ainda.\n");
+    else if(intervaloAmostragem > 0)
+        printf("(latencias: limite do balde em potencia de 2; buscas/adicoes/descartes amostrados 1 a cada %d)\n",
+               intervaloAmostragem);
+}
+
+// ============================================================================
+// IMPLEMENTAÇÃO DA ORDENAÇÃO AUTOMÁTICA
+// ============================================================================
+
+/** @brief Calibração em uso (vazia até --calibracao, --calibrar ou a primeira ordenação automática) */
+static CalibracaoOrdenacao calibracaoAtiva;
+static int calibracaoPronta = 0;
+
+/** @brief Nomes de critério gravados no arquivo de calibração (os mesmos do relatório do benchmark) */
+static const char *const nomesCriterioCalibracao[TOTAL_CRITERIOS] = {"nome", "tipo", "prioridade"};
+
+/** @brief Identifica a máquina: arquitetura, kernel de comparação e threads */
+static void descreverMaquina(char destino[], size_t tamanho) {
+#if defined(__x86_64__)
+    const char *arquitetura = "x86_64";
+#elif defined(__aarch64__)
+    const char *arquitetura = "aarch64";
+#elif defined(__i386__)
+    const char *arquitetura = "i386";
+#else
+    const char *arquitetura = "outra";
+#endif
+    snprintf(destino, tamanho, "%s %s %d", arquitetura, nomeKernelComparacao(kernelComparacaoAtivo()),
+             threadsTrabalho());
+}
+
+/** @brief Chave de cardinalidade: hash do texto ou a própria prioridade */
+static unsigned long long chavePerfil(const Componente *c, CriterioOrdenacao criterio) {
+    if(criterio == CRITERIO_NOME)
+        return hashNome(c->nome);
+    if(criterio == CRITERIO_TIPO)
+        return hashNome(c->tipo);
+    return (unsigned long long)(unsigned)c->prioridade;
+}
+
+void amostrarPerfil(const Componente arr[], int tamanho, CriterioOrdenacao criterio, PerfilDados *perfil) {
+    enum { SLOTS_PERFIL = 2 * AMOSTRAS_PERFIL }; // Tabela de contagem com fator de carga <= 1/2
+    unsigned long long chaves[SLOTS_PERFIL];
+    int contagens[SLOTS_PERFIL] = {0};
+    ContextoOrdenacao ctx = {criterio, 0, 0, 0, NULL}; // Comparação na ordem do critério, sem tocar nos globais
+    int pares = tamanho > 1 ? (tamanho - 1 < AMOSTRAS_PERFIL ? tamanho - 1 : AMOSTRAS_PERFIL) : 0;
+    int descidas = 0, subidas = 0, maiorContagem = 0;
+
+    memset(perfil, 0, sizeof(*perfil));
+    perfil->tamanho = tamanho;
+    perfil->paresAmostrados = pares;
+    for(int k = 0; k < pares; k++) {
+        int i = (int)((long long)k * (tamanho - 1) / pares); // Igualmente espaçados
+        int r = compararComponentes(&ctx, &arr[i], &arr[i + 1]);
+        descidas += r > 0;
+        subidas += r < 0;
+
+        // Cardinalidade: chaves distintas e a mais frequente (sondagem linear)
+        unsigned long long chave = chavePerfil(&arr[i], criterio);
+        unsigned slot = (unsigned)((chave * 0x9E3779B97F4A7C15ULL) >> 32) & (SLOTS_PERFIL - 1);
+        while(contagens[slot] > 0 && chaves[slot] != chave)
+            slot = (slot + 1) & (SLOTS_PERFIL - 1);
+        if(contagens[slot]++ == 0) {
+            chaves[slot] = chave;
+            perfil->chavesDistintas++;
+        }
+        if(contagens[slot] > maiorContagem)
+            maiorContagem = contagens[slot];
+    }
+    if(pares > 0) {
+        perfil->descidas = (double)descidas / pares;
+        perfil->subidas = (double)subidas / pares;
+    }
+
+    perfil->chavesAmostradas = pares;
+    perfil->maiorFrequencia = pares > 0 ? (double)maiorContagem / pares : 1.0;
+
+    // Distribuição calibrada mais parecida. Com muitos empates (tipo, prioridade),
+    // o que separa "quase ordenado" de "aleatório" é a fração do sentido minoritário;
+    // itens trocados de lugar criam tantas descidas quanto subidas, a ordem inversa não
+    double minoria = perfil->descidas < perfil->subidas ? perfil->descidas : perfil->subidas;
+    if(descidas == 0)
+        perfil->forma = DIST_ORDENADA;
+    else if(minoria <= 0.05)
+        perfil->forma = descidas > 4 * subidas ? DIST_REVERSA : DIST_QUASE_ORDENADA;
+    else if(criterio == CRITERIO_TIPO && pares >= 16 && perfil->chavesDistintas <= 4)
+        perfil->forma = DIST_POUCOS_TIPOS;
+    else if(criterio == CRITERIO_PRIORIDADE && perfil->maiorFrequencia >= 0.4)
+        perfil->forma = DIST_PRIORIDADE_ENVIESADA;
+    else
+        perfil->forma = DIST_ALEATORIA;
+}
+
+int calibrarOrdenacao(int tamanhoMaximo, int repeticoes, unsigned long long semente) {
+    int totalTamanhos = 0, maiorN = 10;
+    for(long long n = 10; n <= tamanhoMaximo && totalTamanhos < MAX_TAMANHOS_CALIBRACAO; n *= 10) {
+        maiorN = (int)n;
+        totalTamanhos++;
+    }
+    if(totalTamanhos == 0)
+        totalTamanhos = 1;
+    if(repeticoes < 1)
+        repeticoes = 1;
+
+    Componente *base = malloc((size_t)maiorN * sizeof(Componente));
+    Componente *trabalho = malloc((size_t)maiorN * sizeof(Componente));
+    long long *amostras = malloc((size_t)repeticoes * sizeof(long long));
+    if(base == NULL || trabalho == NULL || amostras == NULL) {
+        fprintf(stderr, "[ERRO] Memoria insuficiente para a calibracao (n = %d).\n", maiorN);
+        free(base);
+        free(trabalho);
+        free(amostras);
+        return 0;
+    }
+
+    int silencioAnterior = modoSilencioso;
+    modoSilencioso = 1;
+    metricasPausar(1); // As ordenações da calibração não são operações do inventário
+    memset(&calibracaoAtiva, 0, sizeof(calibracaoAtiva));
+    calibracaoAtiva.totalTamanhos = totalTamanhos;
+    calibracaoAtiva.repeticoes = repeticoes;
+    descreverMaquina(calibracaoAtiva.maquina, sizeof(calibracaoAtiva.maquina));
+    for(int t = 0, n = 10; t < totalTamanhos; t++, n *= 10) {
+        for(int d = 0; d < TOTAL_DISTRIBUICOES; d++) {
+            gerarComponentes(base, n, (DistribuicaoDados)d, semente + (unsigned long long)n);
+            for(int a = 0; a < TOTAL_ALGORITMOS; a++) {
+                if(a == ALGORITMO_CLASSICO && n > CALIBRACAO_LIMITE_QUADRATICO)
+                    continue;
+                for(int c = 0; c < TOTAL_CRITERIOS; c++) {
+                    if(a == ALGORITMO_CONTAGEM && c != CRITERIO_TIPO)
+                        continue; // Por nome e prioridade é o próprio Radix: só acrescentaria ruído
+                    void (*ordenar)(Componente[], int) = funcaoOrdenacao((AlgoritmoOrdenacao)a, (CriterioOrdenacao)c);
+                    for(int r = 0; r < repeticoes; r++) {
+                        Medicao med;
+                        memcpy(trabalho, base, (size_t)n * sizeof(Componente));
+                        medirAlgoritmo(ordenar, trabalho, n, &med);
+                        amostras[r] = med.tempoParedeNs;
+                    }
+                    long long mediana, p99;
+                    resumirAmostras(amostras, repeticoes, &mediana, &p99);
+                    calibracaoAtiva.medianaNs[c][d][t][a] = mediana > 0 ? (double)mediana : 1.0;
+                }
+            }
+        }
+    }
+    modoSilencioso = silencioAnterior;
+    metricasPausar(0);
+    calibracaoPronta = 1;
+    free(base);
+    free(trabalho);
+    free(amostras);
+    return 1;
+}
+
+void calibracaoGarantir(void) {
+    if(calibracaoPronta)
         return;
+    if(!modoSilencioso)
+        printf("\n[AUTO] Sem arquivo de calibracao (--calibracao): medindo esta maquina ate n = %d...\n",
+               CALIBRACAO_RAPIDA_MAX);
+    if(calibrarOrdenacao(CALIBRACAO_RAPIDA_MAX, 3, 2026))
+        snprintf(calibracaoAtiva.origem, sizeof(calibracaoAtiva.origem), "medicao rapida");
+}
+
+/** @brief Posição de n na escala de décadas: exata nas potências de 10, linear entre elas */
+static double posicaoDecada(double n) {
+    double p = 0;
+    while(n >= 10) {
+        n /= 10;
+        p++;
+    }
+    return p + (n - 1) / 9;
+}
+
+double preverTempoOrdenacao(CriterioOrdenacao criterio, DistribuicaoDados forma, AlgoritmoOrdenacao algoritmo,
+                            int tamanho) {
+    double posicoes[MAX_TAMANHOS_CALIBRACAO], porItem[MAX_TAMANHOS_CALIBRACAO];
+    int k = 0;
+    double n = 10;
+    for(int t = 0; t < calibracaoAtiva.totalTamanhos; t++, n *= 10) {
+        double mediana = calibracaoAtiva.medianaNs[criterio][forma][t][algoritmo];
+        if(mediana > 0) {
+            posicoes[k] = t + 1;
+            porItem[k++] = mediana / n;
+        }
+    }
+    if(k == 0)
+        return -1;
+    if(tamanho < 1)
+        tamanho = 1;
+
+    double alvo = posicaoDecada(tamanho), custo;
+    if(alvo <= posicoes[0] || k == 1) {
+        custo = porItem[0]; // Abaixo de 10 (ou um só ponto): custo por item constante
+    } else if(alvo <= posicoes[k - 1]) {
+        int i = 0;
+        while(alvo > posicoes[i + 1])
+            i++;
+        double f = (alvo - posicoes[i]) / (posicoes[i + 1] - posicoes[i]);
+        custo = porItem[i] + f * (porItem[i + 1] - porItem[i]);
+    } else {
+        // Acima do maior tamanho: cada década multiplica o custo por item como a última medida
+        double razao = porItem[k - 1] / porItem[k - 2];
+        if(razao < 1)
+            razao = 1; // Ruído de medição não torna um algoritmo sublinear
+        double decadas = alvo - posicoes[k - 1];
+        custo = porItem[k - 1];
+        for(; decadas >= 1; decadas--)
+            custo *= razao;
+        custo *= 1 + (razao - 1) * decadas;
+    }
+    return custo * tamanho;
+}
+
+void escolherOrdenacao(const Componente arr[], int tamanho, CriterioOrdenacao criterio, DecisaoOrdenacao *decisao) {
+    calibracaoGarantir();
+    long long inicio = lerRelogioNs(CLOCK_MONOTONIC);
+    amostrarPerfil(arr, tamanho, criterio, &decisao->perfil);
+    decisao->algoritmo = decisao->segundo = ALGORITMO_INTROSORT; // Sem calibração: o padrão do motor
+    decisao->previstoNs = decisao->segundoNs = -1;
+    for(int a = 0; a < TOTAL_ALGORITMOS; a++) {
+        double previsto = preverTempoOrdenacao(criterio, decisao->perfil.forma, (AlgoritmoOrdenacao)a, tamanho);
+        if(previsto < 0)
+            continue;
+        if(decisao->previstoNs < 0 || previsto < decisao->previstoNs) {
+            decisao->segundo = decisao->algoritmo;
+            decisao->segundoNs = decisao->previstoNs;
+            decisao->algoritmo = (AlgoritmoOrdenacao)a;
+            decisao->previstoNs = previsto;
+        } else if(decisao->segundoNs < 0 || previsto < decisao->segundoNs) {
+            decisao->segundo = (AlgoritmoOrdenacao)a;
+            decisao->segundoNs = previsto;
+        }
+    }
+    decisao->custoDecisaoNs = lerRelogioNs(CLOCK_MONOTONIC) - inicio;
+}
+
+AlgoritmoOrdenacao ordenarAutomatico(Componente arr[], int tamanho, CriterioOrdenacao criterio) {
+    DecisaoOrdenacao decisao;
+    Medicao med;
+    char previsto[32], segundo[32], real[32], custo[32];
+
+    escolherOrdenacao(arr, tamanho, criterio, &decisao);
+    if(!modoSilencioso) {
+        const PerfilDados *p = &decisao.perfil;
+        formatarDuracao(previsto, sizeof(previsto), (long long)decisao.previstoNs);
+        formatarDuracao(segundo, sizeof(segundo), (long long)decisao.segundoNs);
+        formatarDuracao(custo, sizeof(custo), decisao.custoDecisaoNs);
+        printf("\n[AUTO] n = %d | pares fora de ordem: %.1f%% (em ordem: %.1f%%) | chaves distintas: %d/%d\n",
+               p->tamanho, p->descidas * 100, p->subidas * 100, p->chavesDistintas, p->chavesAmostradas);
+        printf("[AUTO] Formato: %s -> %s (previsto %s", nomeDistribuicao(p->forma),
+               nomeAlgoritmo(decisao.algoritmo), previsto);
+        if(decisao.segundoNs >= 0)
+            printf("; segundo: %s, %s", nomeAlgoritmo(decisao.segundo), segundo);
+        printf(") | decisao em %s, calibracao: %s\n", custo, calibracaoAtiva.origem);
+        printf("\n=== INICIANDO: %s ===\n", descricaoOrdenacao(decisao.algoritmo, criterio));
+    }
+    medirAlgoritmo(funcaoOrdenacao(decisao.algoritmo, criterio), arr, tamanho, &med);
+    if(!modoSilencioso) {
+        mostrarMedicao(&med);
+        formatarDuracao(real, sizeof(real), med.tempoParedeNs);
+        if(decisao.previstoNs > 0)
+            printf("[AUTO] Previsto %s x real %s (erro %+.1f%%)\n", previsto, real,
+                   (med.tempoParedeNs - decisao.previstoNs) * 100 / decisao.previstoNs);
+        printf("=================================\n");
+    }
+    return decisao.algoritmo;
+}
+
+/**
+ * @brief Grava (ou exibe) o melhor algoritmo de cada tamanho e os pontos de cruzamento
+ * @param saida Destino
+ * @param arquivo 1 = linhas "cruzamento ..." do arquivo de calibração; 0 = relatório legível
+ * @details Cruzamento: n em que o melhor previsto muda entre duas potências de 10
+ *          medidas, localizado por bisseção sobre as previsões interpoladas
+ */
+static void escreverCruzamentos(FILE *saida, int arquivo) {
+    for(int c = 0; c < TOTAL_CRITERIOS; c++) {
+        for(int d = 0; d < TOTAL_DISTRIBUICOES; d++) {
+            char cruzamentos[512] = "";
+            size_t usado = 0;
+            AlgoritmoOrdenacao anterior = TOTAL_ALGORITMOS;
+            int n = 10;
+            if(!arquivo)
+                fprintf(saida, "%-10s %-20s:", nomesCriterioCalibracao[c], nomeDistribuicao((DistribuicaoDados)d));
+            for(int t = 0; t < calibracaoAtiva.totalTamanhos; t++, n *= 10) {
+                AlgoritmoOrdenacao melhor = TOTAL_ALGORITMOS;
+                for(int a = 0; a < TOTAL_ALGORITMOS; a++) {
+                    double m = calibracaoAtiva.medianaNs[c][d][t][a];
+                    if(m > 0 && (melhor == TOTAL_ALGORITMOS || m < calibracaoAtiva.medianaNs[c][d][t][melhor]))
+                        melhor = (AlgoritmoOrdenacao)a;
+                }
+                if(melhor == TOTAL_ALGORITMOS)
+                    continue;
+                if(!arquivo)
+                    fprintf(saida, " %d %s (%.1f ns/item)", n, nomeAlgoritmo(melhor),
+                            calibracaoAtiva.medianaNs[c][d][t][melhor] / n);
+                if(anterior != TOTAL_ALGORITMOS && melhor != anterior) {
+                    int baixo = n / 10, alto = n; // Em baixo vence o anterior, em alto o novo
+                    while(alto - baixo > 1) {
+                        int meio = baixo + (alto - baixo) / 2;
+                        double ta = preverTempoOrdenacao((CriterioOrdenacao)c, (DistribuicaoDados)d, anterior, meio);
+                        double tm = preverTempoOrdenacao((CriterioOrdenacao)c, (DistribuicaoDados)d, melhor, meio);
+                        if(ta >= 0 && ta <= tm)
+                            baixo = meio;
+                        else
+                            alto = meio;
+                    }
+                    if(arquivo)
+                        fprintf(saida, "cruzamento %s %s %d %s %s\n", nomesCriterioCalibracao[c],
+                                nomeDistribuicao((DistribuicaoDados)d), alto, nomeAlgoritmo(anterior),
+                                nomeAlgoritmo(melhor));
+                    else if(usado < sizeof(cruzamentos))
+                        usado += (size_t)snprintf(cruzamentos + usado, sizeof(cruzamentos) - usado,
+                                                  "%s%s -> %s em n ~ %d", usado > 0 ? "; " : "",
+                                                  nomeAlgoritmo(anterior), nomeAlgoritmo(melhor), alto);
+                }
+                anterior = melhor;
+            }
+            if(!arquivo)
+                fprintf(saida, "\n%s%s%s", usado > 0 ? "    cruzamentos: " : "", cruzamentos, usado > 0 ? "\n" : "");
+        }
+    }
+}
+
+int calibracaoSalvar(const char caminho[]) {
+    FILE *f = fopen(caminho, "w");
+    if(f == NULL) {
+        fprintf(stderr, "[ERRO] Nao foi possivel criar '%s'.\n", caminho);
+        return 0;
+    }
+    fprintf(f, "# FreeFire - calibracao da ordenacao automatica\n");
+    fprintf(f, "# medida <criterio> <distribuicao> <n> <algoritmo> <mediana_ns>\n");
+    fprintf(f, "versao 1\nmaquina %s\nrepeticoes %d\n", calibracaoAtiva.maquina, calibracaoAtiva.repeticoes);
+    for(int c = 0; c < TOTAL_CRITERIOS; c++)
+        for(int d = 0; d < TOTAL_DISTRIBUICOES; d++)
+            for(int t = 0, n = 10; t < calibracaoAtiva.totalTamanhos; t++, n *= 10)
+                for(int a = 0; a < TOTAL_ALGORITMOS; a++)
+                    if(calibracaoAtiva.medianaNs[c][d][t][a] > 0)
+                        fprintf(f, "medida %s %s %d %s %.0f\n", nomesCriterioCalibracao[c],
+                                nomeDistribuicao((DistribuicaoDados)d), n, nomeAlgoritmo((AlgoritmoOrdenacao)a),
+                                calibracaoAtiva.medianaNs[c][d][t][a]);
+    escreverCruzamentos(f, 1);
+    if(fclose(f) != 0) {
+        fprintf(stderr, "[ERRO] Falha ao gravar '%s'.\n", caminho);
+        return 0;
+    }
+    return 1;
+}
+
+int calibracaoCarregar(const char caminho[]) {
+    FILE *f = fopen(caminho, "r");
+    if(f == NULL) {
+        fprintf(stderr, "[ERRO] Nao foi possivel abrir a calibracao '%s'.\n", caminho);
+        return 0;
+    }
+    static CalibracaoOrdenacao lida; // Só substitui a ativa se o arquivo inteiro for válido
+    char linha[MAX_LINHA_LOTE], criterioTxt[MAX_STR_LEN], distribuicaoTxt[MAX_STR_LEN], algoritmoTxt[MAX_STR_LEN];
+    int versao = 0, medidas = 0, invalidas = 0, n;
+    double mediana;
+
+    memset(&lida, 0, sizeof(lida));
+    while(fgets(linha, sizeof(linha), f) != NULL) {
+        linha[strcspn(linha, "\r\n")] = '\0';
+        if(strncmp(linha, "versao ", 7) == 0) {
+            versao = atoi(linha + 7);
+        } else if(strncmp(linha, "maquina ", 8) == 0) {
+            snprintf(lida.maquina, sizeof(lida.maquina), "%.95s", linha + 8);
+        } else if(strncmp(linha, "repeticoes ", 11) == 0) {
+            lida.repeticoes = atoi(linha + 11);
+        } else if(sscanf(linha, "medida %29s %29s %d %29s %lf", criterioTxt, distribuicaoTxt, &n, algoritmoTxt,
+                         &mediana) == 5) {
+            int c = 0, d = 0, t = 0, p = 10;
+            AlgoritmoOrdenacao a;
+            while(c < TOTAL_CRITERIOS && strcasecmp(criterioTxt, nomesCriterioCalibracao[c]) != 0)
+                c++;
+            while(d < TOTAL_DISTRIBUICOES && strcasecmp(distribuicaoTxt, nomeDistribuicao((DistribuicaoDados)d)) != 0)
+                d++;
+            while(t < MAX_TAMANHOS_CALIBRACAO - 1 && p < n) {
+                t++;
+                p *= 10;
+            }
+            if(c == TOTAL_CRITERIOS || d == TOTAL_DISTRIBUICOES || p != n || !algoritmoPorNome(algoritmoTxt, &a) ||
+               mediana <= 0) {
+                invalidas++;
+                continue;
+            }
+            lida.medianaNs[c][d][t][a] = mediana;
+            if(t + 1 > lida.totalTamanhos)
+                lida.totalTamanhos = t + 1;
+            medidas++;
+        }
     }
+    fclose(f);
+    if(versao != 1 || medidas == 0) {
+        fprintf(stderr, "[ERRO] '%s' nao e uma calibracao valida (versao %d, %d medida(s)).\n", caminho, versao,
+                medidas);
+        return 0;
+    }
+    if(invalidas > 0)
+        fprintf(stderr, "[AVISO] %d medida(s) ignorada(s) em '%s'.\n", invalidas, caminho);
+
+    char maquina[sizeof(lida.maquina)];
+    descreverMaquina(maquina, sizeof(maquina));
+    if(strcmp(maquina, lida.maquina) != 0)
+        fprintf(stderr, "[AVISO] Calibracao medida em '%s'; esta maquina e '%s'. Recalibre com --calibrar.\n",
+                lida.maquina, maquina);
+    snprintf(lida.origem, sizeof(lida.origem), "%.63s", caminho);
+    calibracaoAtiva = lida;
+    calibracaoPronta = 1;
+    return 1;
+}
 
-    // Cabeçalho da tabela
-    printf("\n--- INVENTARIO ATUAL (%d/10) ---\n", tamanho);
-    printf("-------------------------------------------------------------------\n");
-    printf("%-20s | %-15s | %-11s | %-10s\n", "NOME", "TIPO", "QUANTIDADE", "PRIORIDADE");
-    printf("-------------------------------------------------------------------\n");
+int executarCalibracao(const char caminho[], int tamanhoMaximo, unsigned long long semente) {
+    Medicao med;
+    medicaoIniciar(&med);
+    if(!calibrarOrdenacao(tamanhoMaximo, 5, semente))
+        return 1;
+    medicaoFinalizar(&med);
+    snprintf(calibracaoAtiva.origem, sizeof(calibracaoAtiva.origem), "%.63s", caminho);
 
-    // Linha para cada componente (iteração O(n))
-    for(int i = 0; i < tamanho; i++)
-        printf("%-20s | %-15s | %-11d | %-10d\n", arr[i].nome, arr[i].tipo, arr[i].quantidade, arr[i].prioridade);
+    printf("\n=== CALIBRACAO DA ORDENACAO AUTOMATICA ===\n");
+    printf("Maquina: %s (arquitetura, kernel de comparacao, threads) | %d repeticoes | n ate %d | %.1f s\n",
+           calibracaoAtiva.maquina, calibracaoAtiva.repeticoes, tamanhoMaximo, med.tempoParedeNs / 1e9);
+    printf("Melhor algoritmo por criterio/distribuicao e tamanho:\n");
+    escreverCruzamentos(stdout, 0);
+    if(!calibracaoSalvar(caminho))
+        return 1;
+    printf("[OK] Calibracao salva em '%s' (use --calibracao %s).\n", caminho, caminho);
+    printf("==========================================\n");
+    return 0;
+}
 
-    printf("-------------------------------------------------------------------\n");
+// ============================================================================
+// IMPLEMENTAÇÃO DO SERVIDOR LOCAL
+// ============================================================================
+
+/** @brief Pedido de encerramento por SIGINT/SIGTERM (lido pelo laço de conexões) */
+static volatile sig_atomic_t sinalEncerrarServidor = 0;
+
+static void tratarSinalServidor(int sinal) {
+    (void)sinal;
+    sinalEncerrarServidor = 1;
+}
+
+/** @brief send() completo, sem SIGPIPE se o outro lado fechou; 0 em caso de erro */
+static int socketEnviar(int fd, const char *dados, size_t tamanho) {
+    while(tamanho > 0) {
+        ssize_t n = send(fd, dados, tamanho, MSG_NOSIGNAL);
+        if(n <= 0)
+            return 0;
+        dados += n;
+        tamanho -= (size_t)n;
+    }
+    return 1;
 }
 
 /**
- * @brief Bubble Sort - Ordena componentes alfabeticamente por nome
- * @param arr Array de componentes a ordenar (MODIFICADO in-place)
- * @param tamanho Número de elementos
- *
- * Algoritmo:
- * - Compara elementos adjacentes
- * - Toca se forem maiores (ordem alfabética)
- * - Repete até que nenhuma troca seja necessária
- * - Após ordenação: elemento maior "flutua" para o final
- *
- * Complexidade:
- * - Melhor caso: O(n) - array já ordenado (com otimização)
- * - Pior caso: O(n²) - array em ordem reversa
- * - Comparações: sempre ~n(n-1)/2
- *
- * Necessário para: Busca Binária (requer array ordenado)
+ * @brief Publica uma visão nova com o estado atual da mochila (sob travaEscrita)
+ * @details Cópia O(n) em ordem de nome, lida do índice ordenado. A visão
+ *          substituída entra na lista de retiradas com a época da troca e é
+ *          liberada quando todos os leitores ativos anunciaram uma época maior
  */
-void bubbleSortNome(Componente arr[], int tamanho) {
-    if(tamanho == 0)
+static void servidorPublicar(ServidorInventario *s) {
+    Mochila *m = s->mochila;
+    VisaoInventario *nova = malloc(sizeof(VisaoInventario) + (size_t)m->quantidade * sizeof(Componente));
+    if(nova == NULL) {
+        fprintf(stderr, "[ERRO] Memoria insuficiente para publicar a visao; leituras seguem na anterior.\n");
         return;
+    }
+    nova->versao = s->versaoEscrita;
+    nova->epocaRetirada = 0;
+    nova->proximaRetirada = NULL;
+    nova->quantidade = m->quantidade;
+    mochilaCopiarEmOrdemDeNome(m, nova->itens);
 
-    Componente temp;
-    int trocas = 0;
-    comparacoesVetor = 0;
+    VisaoInventario *antiga = __atomic_exchange_n(&s->visao, nova, __ATOMIC_SEQ_CST);
+    uint64_t epoca = __atomic_fetch_add(&s->epocaGlobal, 1, __ATOMIC_SEQ_CST);
+    s->publicacoes++;
+    if(antiga != NULL) {
+        antiga->epocaRetirada = epoca;
+        antiga->proximaRetirada = s->retiradas;
+        s->retiradas = antiga;
+    }
 
-    // Loop externo: n-1 iterações
-    for(int i = 0; i < tamanho - 1; i++) {
-        // Loop interno: compara elementos adjacentes (reduz a cada iteração)
-        for(int j = 0; j < tamanho - i - 1; j++) {
-            comparacoesVetor++;
-            // Comparação alfabética: strcmp retorna > 0 se arr[j] > arr[j+1]
-            if(strcmp(arr[j].nome, arr[j + 1].nome) > 0) {
-                // Troca: arr[j] <-> arr[j+1]
-                temp = arr[j];
-                arr[j] = arr[j + 1];
-                arr[j + 1] = temp;
-                trocas++;
-            }
+    // Um leitor que anunciou a época e <= retirada pode ainda estar com a visão antiga
+    uint64_t menorAtiva = UINT64_MAX;
+    for(int i = 0; i < MAX_CLIENTES_SERVIDOR; i++) {
+        uint64_t e = __atomic_load_n(&s->leitores[i].epoca, __ATOMIC_SEQ_CST);
+        if(e != 0 && e < menorAtiva)
+            menorAtiva = e;
+    }
+    VisaoInventario **p = &s->retiradas;
+    while(*p != NULL) {
+        if((*p)->epocaRetirada < menorAtiva) {
+            VisaoInventario *livre = *p;
+            *p = livre->proximaRetirada;
+            free(livre);
+            s->visoesLiberadas++;
+        } else {
+            p = &(*p)->proximaRetirada;
         }
     }
-    printf("\n[BUBBLE SORT] Ordenacao por NOME concluida.\n");
-    printf("-> Comparacoes: %d | Trocas: %d\n", comparacoesVetor, trocas);
 }
 
 /**
- * @brief Insertion Sort - Ordena componentes alfabeticamente por tipo
- * @param arr Array de componentes a ordenar (MODIFICADO in-place)
- * @param tamanho Número de elementos
- *
- * Algoritmo:
- * - Considera primeiro elemento já "ordenado"
- * - Para cada elemento subsequente, insere na posição correta
- * - Desloca elementos maiores para a direita
- *
- * Complexidade:
- * - Melhor caso: O(n) - array já ordenado
- * - Pior caso: O(n²) - array em ordem reversa
- * - Comparações: ~n(n-1)/4 em média
- *
- * Vantagem: Eficiente para dados parcialmente ordenados
+ * @brief Entra em uma seção de leitura e devolve a visão atual
+ * @param minimaVersao Última escrita desta conexão: a visão nunca é mais antiga que ela
+ * @details Caminho comum sem trava: anuncia a época e lê o ponteiro. Só se a
+ *          visão ainda não reflete a própria escrita (publicação adiada por
+ *          outros escritores na fila) a conexão publica antes de ler
  */
-void insertionSortTipo(Componente arr[], int tamanho) {
-    if(tamanho == 0)
-        return;
+static const VisaoInventario *servidorIniciarLeitura(ServidorInventario *s, int slot, uint64_t minimaVersao) {
+    for(;;) {
+        __atomic_store_n(&s->leitores[slot].epoca, __atomic_load_n(&s->epocaGlobal, __ATOMIC_SEQ_CST),
+                         __ATOMIC_SEQ_CST);
+        const VisaoInventario *v = __atomic_load_n(&s->visao, __ATOMIC_SEQ_CST);
+        if(v->versao >= minimaVersao)
+            return v;
+        __atomic_store_n(&s->leitores[slot].epoca, 0, __ATOMIC_RELEASE);
+        pthread_mutex_lock(&s->travaEscrita);
+        if(__atomic_load_n(&s->visao, __ATOMIC_SEQ_CST)->versao < s->versaoEscrita)
+            servidorPublicar(s);
+        pthread_mutex_unlock(&s->travaEscrita);
+    }
+}
 
-    Componente chave;      // Elemento sendo inserido
-    int deslocamentos = 0; // Contador de elementos movidos
-    comparacoesVetor = 0;
+/** @brief Sai da seção de leitura: a visão pode ser liberada a partir daqui */
+static void servidorFinalizarLeitura(ServidorInventario *s, int slot) {
+    __atomic_store_n(&s->leitores[slot].epoca, 0, __ATOMIC_RELEASE);
+}
 
-    // Começa do segundo elemento (índice 1)
-    for(int i = 1; i < tamanho; i++) {
-        chave = arr[i]; // Elemento a inserir
-        int j = i - 1;  // Índice para verificar elementos anteriores
+/**
+ * @brief Aplica ADD ou DEL sob a trava de escrita
+ * @return Versão após a escrita, ou 0 se ela foi rejeitada
+ * @details Publicação agrupada: com outros escritores na fila, a visão fica
+ *          para o último deles (no máximo LOTE_PUBLICACAO escritas de atraso)
+ */
+static uint64_t servidorEscrever(ServidorInventario *s, const Componente *novo, const char nome[]) {
+    __atomic_add_fetch(&s->escritoresEsperando, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&s->travaEscrita);
+    __atomic_sub_fetch(&s->escritoresEsperando, 1, __ATOMIC_SEQ_CST);
 
-        // Move elementos maiores para a direita
-        while(j >= 0) {
-            comparacoesVetor++;
-            // Comparação alfabética por tipo (strcmp)
-            if(strcmp(arr[j].tipo, chave.tipo) > 0) {
-                arr[j + 1] = arr[j]; // Desloca para direita
-                j--;
-                deslocamentos++;
-            } else {
-                break; // Encontrou posição correta
-            }
-        }
-        arr[j + 1] = chave; // Insere elemento na posição correta
+    int ok = novo != NULL ? adicionarComponente(s->mochila, novo) : descartarComponente(s->mochila, nome);
+    if(ok) {
+        s->mochila->ordenadaPorNome = 0; // Inserção no fim / descarte com troca pelo último
+        s->versaoEscrita++;
+        __atomic_add_fetch(&s->escritas, 1, __ATOMIC_RELAXED);
     }
-    printf("\n[INSERTION SORT] Ordenacao por TIPO concluida.\n");
-    printf("-> Comparacoes: %d | Deslocamentos: %d\n", comparacoesVetor, deslocamentos);
+    uint64_t publicada = __atomic_load_n(&s->visao, __ATOMIC_SEQ_CST)->versao;
+    if(publicada < s->versaoEscrita && (__atomic_load_n(&s->escritoresEsperando, __ATOMIC_SEQ_CST) == 0 ||
+                                        s->versaoEscrita - publicada >= LOTE_PUBLICACAO))
+        servidorPublicar(s);
+    uint64_t versao = ok ? s->versaoEscrita : 0;
+    pthread_mutex_unlock(&s->travaEscrita);
+    return versao;
 }
 
+/** @struct ConexaoServidor @brief Argumento da thread de uma conexão */
+typedef struct {
+    ServidorInventario *servidor;
+    int fd;
+    int slot;
+} ConexaoServidor;
+
 /**
- * @brief Selection Sort - Ordena componentes por prioridade (decrescente)
- * @param arr Array de componentes a ordenar (MODIFICADO in-place)
- * @param tamanho Número de elementos
- *
- * Algoritmo:
- * - Encontra o elemento máximo na porção não-ordenada
- * - Coloca na posição correta
- * - Repete para a porção restante (reduz a cada iteração)
- *
- * Complexidade:
- * - Todas as variações: O(n²)
- * - Comparações: sempre n(n-1)/2
- * - Trocas: no máximo n-1
- *
- * Características:
- * - Não é "estável" (pode mudar ordem relativa de iguais)
- * - Simples de implementar
- * - Bom para dados pequenos ou análise educacional
- *
- * Nota: Ordena em ORDEM DECRESCENTE (maior prioridade primeiro)
+ * @brief Atende os comandos de uma conexão até QUIT, SHUTDOWN ou fim do fluxo
+ * @details A tabela do LIST é montada com escreverComponentes em memória
+ *          (dentro da seção de leitura) e enviada depois dela: um cliente lento
+ *          não segura a visão antiga
  */
-void selectionSortPrioridade(Componente arr[], int tamanho) {
-    if(tamanho == 0)
-        return;
+static void *servidorAtenderConexao(void *argumento) {
+    ConexaoServidor conexao = *(ConexaoServidor *)argumento;
+    ServidorInventario *s = conexao.servidor;
+    free(argumento);
 
-    int minIdx; // Índice do elemento máximo na porção não-ordenada
-    Componente temp;
-    int trocas = 0;
-    comparacoesVetor = 0;
+    int fdLeitura = dup(conexao.fd);
+    FILE *entrada = fdLeitura >= 0 ? fdopen(fdLeitura, "r") : NULL;
+    char linha[MAX_LINHA_LOTE], resposta[MAX_LINHA_LOTE + 64], nome[MAX_STR_LEN];
+    uint64_t minhaVersao = 0; // Última escrita desta conexão (leitura das próprias escritas)
 
-    // Percorre array selecionando máximo em cada iteração
-    for(int i = 0; i < tamanho - 1; i++) {
-        minIdx = i; // Assume primeiro da porção não-ordenada como máximo
+    while(entrada != NULL && fgets(linha, sizeof(linha), entrada) != NULL) {
+        linha[strcspn(linha, "\r\n")] = '\0';
+        char *cmd = linha;
+        while(*cmd == ' ' || *cmd == '\t')
+            cmd++;
+        if(*cmd == '\0')
+            continue;
+        char *args = cmd + strcspn(cmd, " \t");
+        if(*args != '\0')
+            *args++ = '\0';
 
-        // Busca o máximo na porção não-ordenada
-        for(int j = i + 1; j < tamanho; j++) {
-            comparacoesVetor++;
-            // Busca prioridade MAIOR (ordem DECRESCENTE)
-            if(arr[j].prioridade > arr[minIdx].prioridade) {
-                minIdx = j; // Atualiza índice do máximo
+        int tamanho;
+        if(strcasecmp(cmd, "ADD") == 0) {
+            Componente novo;
+            uint64_t versao = lerComponenteLote(args, &novo) ? servidorEscrever(s, &novo, NULL) : 0;
+            if(versao > 0)
+                minhaVersao = versao;
+            tamanho = versao > 0 ? snprintf(resposta, sizeof(resposta), "OK %llu\n", (unsigned long long)versao)
+                                 : snprintf(resposta, sizeof(resposta), "ERRO componente invalido ou mochila cheia\n");
+        } else if(strcasecmp(cmd, "DEL") == 0) {
+            copiarCampo(nome, args, strlen(args), sizeof(nome));
+            uint64_t versao = servidorEscrever(s, NULL, nome);
+            if(versao > 0)
+                minhaVersao = versao;
+            tamanho = versao > 0 ? snprintf(resposta, sizeof(resposta), "OK %llu\n", (unsigned long long)versao)
+                                 : snprintf(resposta, sizeof(resposta), "NAO\n");
+        } else if(strcasecmp(cmd, "FIND") == 0) {
+            // Mesma busca binária de buscaBinariaPorNome, com o contador de comparações local à conexão
+            char consulta[1][MAX_STR_LEN];
+            int posicao;
+            copiarCampo(consulta[0], args, strlen(args), sizeof(consulta[0]));
+            const VisaoInventario *v = servidorIniciarLeitura(s, conexao.slot, minhaVersao);
+            TarefaBusca busca = {v->itens, v->quantidade, consulta, &posicao, 0, 1, 0, 0};
+            long long relogio = metricasInicio(METRICA_BUSCA_BINARIA);
+            tarefaBuscarFaixa(&busca);
+            metricasRegistrar(METRICA_BUSCA_BINARIA, relogio, busca.comparacoes, posicao >= 0, posicao < 0);
+            if(posicao >= 0) {
+                const Componente *c = &v->itens[posicao];
+                tamanho = snprintf(resposta, sizeof(resposta), "OK %s;%s;%d;%d;%lld\n", c->nome, c->tipo,
+                                   c->quantidade, c->prioridade, busca.comparacoes);
+            } else {
+                tamanho = snprintf(resposta, sizeof(resposta), "NAO %lld\n", busca.comparacoes);
+            }
+            servidorFinalizarLeitura(s, conexao.slot);
+            __atomic_add_fetch(&s->leituras, 1, __ATOMIC_RELAXED);
+        } else if(strcasecmp(cmd, "LIST") == 0) {
+            int inicio = 1, quantidade = 0;
+            sscanf(args, "%d %d", &inicio, &quantidade);
+            char *tabela = NULL;
+            size_t bytes = 0;
+            EstatisticasListagem custo = {0, 0, 0, 0};
+            FILE *memoria = open_memstream(&tabela, &bytes);
+            if(memoria != NULL) {
+                const VisaoInventario *v = servidorIniciarLeitura(s, conexao.slot, minhaVersao);
+                escreverComponentes(memoria, v->itens, v->quantidade, inicio - 1, quantidade, &custo);
+                servidorFinalizarLeitura(s, conexao.slot);
+                fclose(memoria);
             }
+            __atomic_add_fetch(&s->leituras, 1, __ATOMIC_RELAXED);
+            tamanho = snprintf(resposta, sizeof(resposta), "OK %lld %zu\n", custo.linhas, bytes);
+            int ok = socketEnviar(conexao.fd, resposta, (size_t)tamanho) && socketEnviar(conexao.fd, tabela, bytes);
+            free(tabela);
+            if(!ok)
+                break;
+            continue;
+        } else if(strcasecmp(cmd, "METRICS") == 0) {
+            // Mesmo envelope do LIST: "OK bytes" e o corpo (Prometheus, ou JSON com "METRICS json")
+            char *corpo = NULL;
+            size_t bytes = 0;
+            FILE *memoria = open_memstream(&corpo, &bytes);
+            if(memoria != NULL) {
+                metricasExportar(memoria, strcasecmp(args, "json") == 0 ? METRICAS_JSON : METRICAS_PROMETHEUS);
+                fclose(memoria);
+            }
+            tamanho = snprintf(resposta, sizeof(resposta), "OK %zu\n", bytes);
+            int ok = socketEnviar(conexao.fd, resposta, (size_t)tamanho) && socketEnviar(conexao.fd, corpo, bytes);
+            free(corpo);
+            if(!ok)
+                break;
+            continue;
+        } else if(strcasecmp(cmd, "COUNT") == 0) {
+            const VisaoInventario *v = servidorIniciarLeitura(s, conexao.slot, minhaVersao);
+            tamanho = snprintf(resposta, sizeof(resposta), "OK %d %llu\n", v->quantidade,
+                               (unsigned long long)v->versao);
+            servidorFinalizarLeitura(s, conexao.slot);
+            __atomic_add_fetch(&s->leituras, 1, __ATOMIC_RELAXED);
+        } else if(strcasecmp(cmd, "QUIT") == 0 || strcasecmp(cmd, "SHUTDOWN") == 0) {
+            if(strcasecmp(cmd, "SHUTDOWN") == 0)
+                __atomic_store_n(&s->encerrar, 1, __ATOMIC_SEQ_CST);
+            socketEnviar(conexao.fd, "OK\n", 3);
+            break;
+        } else {
+            tamanho = snprintf(resposta, sizeof(resposta), "ERRO comando invalido\n");
         }
+        if(tamanho >= (int)sizeof(resposta))
+            tamanho = (int)sizeof(resposta) - 1;
+        if(!socketEnviar(conexao.fd, resposta, (size_t)tamanho))
+            break;
+    }
 
-        // Troca se encontrou máximo diferente
-        if(minIdx != i) {
-            temp = arr[i];
-            arr[i] = arr[minIdx];
-            arr[minIdx] = temp;
-            trocas++;
-        }
+    if(entrada != NULL)
+        fclose(entrada);
+    else if(fdLeitura >= 0)
+        close(fdLeitura);
+    pthread_mutex_lock(&s->travaConexoes);
+    close(conexao.fd);
+    s->leitores[conexao.slot].ocupado = 0;
+    s->leitores[conexao.slot].fd = -1;
+    if(--s->conexoesAtivas == 0)
+        pthread_cond_signal(&s->semConexoes);
+    pthread_mutex_unlock(&s->travaConexoes);
+    return NULL;
+}
+
+/** @brief Ocupa um slot livre para a conexão fd; -1 se o servidor está cheio */
+static int servidorReservarSlot(ServidorInventario *s, int fd) {
+    int slot = -1;
+    pthread_mutex_lock(&s->travaConexoes);
+    for(int i = 0; i < MAX_CLIENTES_SERVIDOR && slot < 0; i++)
+        if(!s->leitores[i].ocupado)
+            slot = i;
+    if(slot >= 0) {
+        s->leitores[slot].ocupado = 1;
+        s->leitores[slot].fd = fd;
+        s->conexoesAtivas++;
     }
-    printf("\n[SELECTION SORT] Ordenacao por PRIORIDADE concluida.\n");
-    printf("-> Comparacoes: %d | Trocas: %d\n", comparacoesVetor, trocas);
+    pthread_mutex_unlock(&s->travaConexoes);
+    return slot;
 }
 
-/**
- * @brief Busca Binária - Localiza componente por nome em O(log n)
- * @param arr Array ORDENADO alfabeticamente por nome (bubbleSortNome)
- * @param tamanho Quantidade de elementos
- * @param nome Nome do componente a buscar (string terminada em '\0')
- * @return Índice do elemento encontrado, ou -1 se não encontrado
- *
- * PRÉ-CONDIÇÃO: Array DEVE estar ordenado por nome!
- *               Use bubbleSortNome() antes de chamar esta função
- *
- * Algoritmo:
- * - Mantém intervalo [inicio, fim] onde elemento pode estar
- * - Calcula meio = (inicio + fim) / 2
- * - Compara arr[meio] com nome buscado
- * - Reduz intervalo pela metade a cada iteração
- *
- * Complexidade:
- * - Tempo: O(log n) - máximo log₂(n) iterações
- * - Comparações: máximo ~log₂(n) + 1
- * - Espaço: O(1) - não usa recursão (iterativo)
- *
- * Exemplo: Para 1024 elementos, máximo 10 comparações
- *
- * Telemetria: Incrementa comparacoesVetor para análise
- */
-int buscaBinariaPorNome(Componente arr[], int tamanho, char nome[]) {
-    if(tamanho == 0) {
-        return -1; // Array vazio
+int executarServidor(const char caminho[], int limite, const char snapshotInicial[],
+                     const ConfiguracaoDiario *configDiario) {
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if(strlen(caminho) >= sizeof(endereco.sun_path)) {
+        fprintf(stderr, "[ERRO] Caminho do socket muito longo: '%s'.\n", caminho);
+        return 1;
     }
+    memcpy(endereco.sun_path, caminho, strlen(caminho) + 1);
 
-    int inicio = 0, fim = tamanho - 1;
-    comparacoesVetor = 0; // Reset contador de comparações
+    Mochila mochila;
+    DiarioOperacoes diario; // Usado só com --diario
+    mochilaIniciar(&mochila, limite);
+    if((configDiario != NULL && configDiario->base != NULL &&
+        !diarioAbrir(&diario, &mochila, configDiario->base, configDiario->grupo, configDiario->intervaloMs,
+                     configDiario->limiteBytes)) ||
+       (snapshotInicial != NULL && !mochilaCarregar(&mochila, snapshotInicial))) {
+        if(mochila.diario != NULL)
+            diarioFechar(&diario, &mochila);
+        mochilaLiberar(&mochila);
+        return 1;
+    }
 
-    // Enquanto houver intervalo válido
-    while(inicio <= fim) {
-        // Calcula índice do meio (evita overflow)
-        int meio = inicio + (fim - inicio) / 2;
-        comparacoesVetor++;
+    int escuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(caminho); // Socket de uma execução anterior
+    if(escuta < 0 || bind(escuta, (struct sockaddr *)&endereco, sizeof(endereco)) != 0 ||
+       listen(escuta, MAX_CLIENTES_SERVIDOR) != 0) {
+        fprintf(stderr, "[ERRO] Nao foi possivel escutar em '%s'.\n", caminho);
+        if(escuta >= 0)
+            close(escuta);
+        if(mochila.diario != NULL)
+            diarioFechar(&diario, &mochila);
+        mochilaLiberar(&mochila);
+        return 1;
+    }
 
-        // Compara nome no meio com nome buscado
-        int comp = strcmp(arr[meio].nome, nome);
+    static ServidorInventario s; // Grande (slots alinhados): fora da pilha
+    memset(&s, 0, sizeof(s));
+    s.mochila = &mochila;
+    s.epocaGlobal = 1; // 0 marca um slot fora de leitura
+    pthread_mutex_init(&s.travaEscrita, NULL);
+    pthread_mutex_init(&s.travaConexoes, NULL);
+    pthread_cond_init(&s.semConexoes, NULL);
+    for(int i = 0; i < MAX_CLIENTES_SERVIDOR; i++)
+        s.leitores[i].fd = -1;
+    servidorPublicar(&s);
+    if(s.visao == NULL) {
+        close(escuta);
+        unlink(caminho);
+        if(mochila.diario != NULL)
+            diarioFechar(&diario, &mochila);
+        mochilaLiberar(&mochila);
+        return 1;
+    }
 
-        if(comp == 0) {
-            // ENCONTRADO: retorna índice
-            return meio;
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = tratarSinalServidor; // Sem SA_RESTART: o poll() retorna na hora
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+    signal(SIGPIPE, SIG_IGN);
+    modoSilencioso = 1;
+    printf("[OK] Servidor em '%s' com %d componente(s). Ctrl+C ou SHUTDOWN encerra.\n", caminho, mochila.quantidade);
+    fflush(stdout);
+
+    Medicao med;
+    medicaoIniciar(&med);
+    pthread_attr_t atributos;
+    pthread_attr_init(&atributos);
+    pthread_attr_setdetachstate(&atributos, PTHREAD_CREATE_DETACHED);
+    while(!sinalEncerrarServidor && !__atomic_load_n(&s.encerrar, __ATOMIC_SEQ_CST)) {
+        struct pollfd espera = {escuta, POLLIN, 0};
+        if(poll(&espera, 1, 200) <= 0)
+            continue; // Tempo esgotado ou sinal: reavalia o encerramento
+        int cliente = accept(escuta, NULL, NULL);
+        if(cliente < 0)
+            continue;
+        int slot = servidorReservarSlot(&s, cliente);
+        ConexaoServidor *conexao = slot >= 0 ? malloc(sizeof(ConexaoServidor)) : NULL;
+        pthread_t thread;
+        if(conexao != NULL) {
+            *conexao = (ConexaoServidor){&s, cliente, slot};
+            if(pthread_create(&thread, &atributos, servidorAtenderConexao, conexao) == 0) {
+                s.conexoes++;
+                continue;
+            }
+            free(conexao);
         }
-        if(comp < 0)
-            // Nome buscado é maior: busca na metade direita
-            inicio = meio + 1;
-        else
-            // Nome buscado é menor: busca na metade esquerda
-            fim = meio - 1;
+        socketEnviar(cliente, "ERRO servidor cheio\n", 20);
+        pthread_mutex_lock(&s.travaConexoes);
+        if(slot >= 0) {
+            s.leitores[slot].ocupado = 0;
+            s.leitores[slot].fd = -1;
+            s.conexoesAtivas--;
+        }
+        pthread_mutex_unlock(&s.travaConexoes);
+        close(cliente);
     }
+    pthread_attr_destroy(&atributos);
+    close(escuta);
+    unlink(caminho);
 
-    // NÃO ENCONTRADO
-    return -1;
+    // Encerra as conexões abertas: o fgets de cada thread recebe fim de fluxo
+    pthread_mutex_lock(&s.travaConexoes);
+    for(int i = 0; i < MAX_CLIENTES_SERVIDOR; i++)
+        if(s.leitores[i].ocupado)
+            shutdown(s.leitores[i].fd, SHUT_RDWR);
+    while(s.conexoesAtivas > 0)
+        pthread_cond_wait(&s.semConexoes, &s.travaConexoes);
+    pthread_mutex_unlock(&s.travaConexoes);
+    medicaoFinalizar(&med);
+    modoSilencioso = 0;
+
+    double decorrido = med.tempoParedeNs / 1e9;
+    printf("\n=== RELATORIO DO SERVIDOR ===\n");
+    printf("Conexoes: %lld | Leituras: %lld | Escritas: %lld\n", s.conexoes, s.leituras, s.escritas);
+    printf("Visoes publicadas: %lld (%.2f escritas por publicacao) | liberadas: %lld\n", s.publicacoes,
+           s.publicacoes > 1 ? (double)s.escritas / (s.publicacoes - 1) : 0.0, s.visoesLiberadas);
+    printf("Itens na mochila ao final: %d\n", mochila.quantidade);
+    printf("Tempo total: %.3f s | Vazao: %.0f operacoes/segundo\n", decorrido,
+           decorrido > 0 ? (s.leituras + s.escritas) / decorrido : 0.0);
+    if(mochila.diario != NULL) {
+        diarioSincronizar(mochila.diario);
+        mostrarEstatisticasDiario(mochila.diario);
+        diarioFechar(&diario, &mochila);
+    }
+    printf("=============================\n");
+
+    // Nenhum leitor restante: todas as visões podem ser liberadas
+    free(s.visao);
+    while(s.retiradas != NULL) {
+        VisaoInventario *livre = s.retiradas;
+        s.retiradas = livre->proximaRetirada;
+        free(livre);
+    }
+    pthread_mutex_destroy(&s.travaEscrita);
+    pthread_mutex_destroy(&s.travaConexoes);
+    pthread_cond_destroy(&s.semConexoes);
+    mochilaLiberar(&mochila);
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Gerador de carga
+// ---------------------------------------------------------------------------
+
+/** @brief Tipos de requisição do gerador de carga (índices das latências) */
+enum { CARGA_FIND, CARGA_LIST, CARGA_ADD, CARGA_DEL, TOTAL_TIPOS_CARGA };
+
+/** @struct ClienteCarga @brief Estado e amostras de uma thread cliente */
+typedef struct {
+    const ConfiguracaoCarga *cfg;
+    int indice;                              /**< Número do cliente (nomes próprios nas escritas) */
+    pthread_barrier_t *largada;              /**< Todos começam juntos */
+    long long *latencias[TOTAL_TIPOS_CARGA]; /**< Ida e volta de cada requisição (ns) */
+    int total[TOTAL_TIPOS_CARGA];            /**< Amostras por tipo */
+    long long erros;                         /**< Respostas inesperadas ou conexão perdida */
+} ClienteCarga;
+
+/** @brief Conecta ao socket do servidor; -1 em caso de erro */
+static int conectarServidor(const char caminho[]) {
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if(strlen(caminho) >= sizeof(endereco.sun_path))
+        return -1;
+    memcpy(endereco.sun_path, caminho, strlen(caminho) + 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd >= 0 && connect(fd, (struct sockaddr *)&endereco, sizeof(endereco)) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
 }
 
 /**
- * @brief Mede o tempo de CPU gasto em um algoritmo de ordenação
- * @param algoritmo Ponteiro para função de ordenação (bubbleSortNome, insertionSortTipo ou selectionSortPrioridade)
- * @param arr Array de componentes (será ordenado)
- * @param tamanho Número de elementos
- * @param descricao String descritiva do algoritmo (para exibição: "BUBBLE SORT - Por Nome")
- *
- * Objetivo:
- * - Executar algoritmo de ordenação
- * - Medir tempo decorrido usando clock() do <time.h>
- * - Converter de ticks para segundos
- * - Exibir resultado formatado
- *
- * Detalhes:
- * - Usa ponteiro para função (function pointer) para flexibilidade
- * - clock() retorna ticks desde início do programa
- * - CLOCKS_PER_SEC converte ticks para segundos
- * - Tempo é em CPU (não real), útil para comparação
- *
- * Formato de Saída:
- * === INICIANDO: ALGORITMO ===
- * [Executa: bubbleSortNome() imprime própria telemetria]
- * Tempo de CPU: X.XXXXXX segundos
- * =================================
+ * @brief Envia um comando e lê a resposta completa (inclusive o corpo do LIST)
+ * @return 1 se a resposta é OK ou NAO, 0 se ERRO, -1 se a conexão foi perdida
  */
-void medirTempo(void (*algoritmo)(Componente[], int), Componente arr[], int tamanho, const char descricao[]) {
-    clock_t inicio, fim; // Tipo para medir ticks do relógio
-    double tempo_cpu;    // Tempo em segundos (float/double)
+static int cargaRequisitar(int fd, FILE *respostas, const char comando[], size_t tamanho) {
+    char linha[MAX_LINHA_LOTE + 64];
+    if(!socketEnviar(fd, comando, tamanho) || fgets(linha, sizeof(linha), respostas) == NULL)
+        return -1;
+    long long linhas;
+    size_t bytes;
+    if(strncmp(comando, "LIST", 4) == 0 && sscanf(linha, "OK %lld %zu", &linhas, &bytes) == 2) {
+        char descarte[4096];
+        while(bytes > 0) {
+            size_t lidos = fread(descarte, 1, bytes < sizeof(descarte) ? bytes : sizeof(descarte), respostas);
+            if(lidos == 0)
+                return -1;
+            bytes -= lidos;
+        }
+    }
+    return strncmp(linha, "OK", 2) == 0 || strncmp(linha, "NAO", 3) == 0;
+}
 
-    // Exibe cabeçalho
-    printf("\n=== INICIANDO: %s ===\n", descricao);
+/** @brief Thread cliente: mistura de FIND/LIST/ADD/DEL com a latência de cada uma */
+static void *cargaCliente(void *argumento) {
+    ClienteCarga *c = argumento;
+    const ConfiguracaoCarga *cfg = c->cfg;
+    unsigned long long estado = cfg->semente + 0x9E3779B97F4A7C15ULL * (unsigned long long)(c->indice + 1);
+    int fd = conectarServidor(cfg->caminho);
+    FILE *respostas = fd >= 0 ? fdopen(dup(fd), "r") : NULL;
+    int adicionados = 0, descartados = 0; // Nomes próprios: "cN-k" para k em [descartados, adicionados)
+    pthread_barrier_wait(c->largada);
+    if(respostas == NULL) {
+        c->erros = cfg->operacoes;
+        if(fd >= 0)
+            close(fd);
+        return NULL;
+    }
+
+    char comando[MAX_LINHA_LOTE];
+    for(int i = 0; i < cfg->operacoes; i++) {
+        unsigned long long r = proximoAleatorio(&estado);
+        int tipo, tamanho;
+        if((int)(r % 100) < cfg->percentualEscritas) {
+            tipo = adicionados > descartados && (r >> 8) % 2 ? CARGA_DEL : CARGA_ADD;
+            if(tipo == CARGA_ADD) {
+                tamanho = snprintf(comando, sizeof(comando), "ADD c%d-%d;Carga%d;%d;%d\n", c->indice, adicionados,
+                                   (int)((r >> 16) % 8), 1 + (int)((r >> 24) % 100), 1 + (int)((r >> 32) % 10));
+                adicionados++;
+            } else {
+                tamanho = snprintf(comando, sizeof(comando), "DEL c%d-%d\n", c->indice, descartados++);
+            }
+        } else if((r >> 8) % 10 != 0) { // ~10% de nomes ausentes
+            int alvo = (int)((r >> 16) % (unsigned long long)(cfg->itensIniciais + cfg->itensIniciais / 9 + 1));
+            tamanho = snprintf(comando, sizeof(comando), "FIND carga-%07d\n", alvo);
+            tipo = CARGA_FIND;
+        } else {
+            int inicio = 1 + (int)((r >> 16) % (unsigned long long)(cfg->itensIniciais + 1));
+            tamanho = snprintf(comando, sizeof(comando), "LIST %d 20\n", inicio);
+            tipo = CARGA_LIST;
+        }
+        long long t0 = lerRelogioNs(CLOCK_MONOTONIC);
+        int resultado = cargaRequisitar(fd, respostas, comando, (size_t)tamanho);
+        if(resultado < 0) { // Servidor encerrado: o restante conta como erro
+            c->erros += cfg->operacoes - i;
+            break;
+        }
+        c->erros += resultado == 0;
+        c->latencias[tipo][c->total[tipo]++] = lerRelogioNs(CLOCK_MONOTONIC) - t0;
+    }
+    socketEnviar(fd, "QUIT\n", 5);
+    fclose(respostas);
+    close(fd);
+    return NULL;
+}
 
-    // Marca tempo ANTES de executar
-    inicio = clock();
+int executarCarga(const ConfiguracaoCarga *cfg) {
+    static const char *nomesTipo[TOTAL_TIPOS_CARGA] = {"FIND", "LIST", "ADD", "DEL"};
+    int clientes = cfg->clientes > 0 ? cfg->clientes : 1;
+    if(clientes > MAX_CLIENTES_SERVIDOR - 1)
+        clientes = MAX_CLIENTES_SERVIDOR - 1; // Um slot fica para a conexão de preparo
 
-    // EXECUTA O ALGORITMO (função apontada em algoritmo)
-    // O algoritmo imprime sua própria telemetria (comparações, trocas)
-    algoritmo(arr, tamanho);
+    // Preparo (fora da medição): itens que os FIND e LIST vão encontrar
+    int fd = conectarServidor(cfg->caminho);
+    FILE *respostas = fd >= 0 ? fdopen(dup(fd), "r") : NULL;
+    if(respostas == NULL) {
+        fprintf(stderr, "[ERRO] Nao foi possivel conectar a '%s'.\n", cfg->caminho);
+        if(fd >= 0)
+            close(fd);
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    char comando[MAX_LINHA_LOTE];
+    for(int i = 0; i < cfg->itensIniciais; i++) {
+        int tamanho = snprintf(comando, sizeof(comando), "ADD carga-%07d;Carga%d;%d;%d\n", i, i % 8, 1 + i % 100,
+                               1 + i % 10);
+        cargaRequisitar(fd, respostas, comando, (size_t)tamanho);
+    }
+
+    ClienteCarga *estados = calloc((size_t)clientes, sizeof(ClienteCarga));
+    pthread_t *threads = malloc((size_t)clientes * sizeof(pthread_t));
+    long long *amostras = malloc((size_t)clientes * (size_t)cfg->operacoes * sizeof(long long) + 1);
+    int ok = estados != NULL && threads != NULL && amostras != NULL;
+    for(int c = 0; ok && c < clientes; c++)
+        for(int t = 0; t < TOTAL_TIPOS_CARGA; t++)
+            ok = (estados[c].latencias[t] = malloc((size_t)cfg->operacoes * sizeof(long long) + 1)) != NULL && ok;
+    if(!ok) {
+        fprintf(stderr, "[ERRO] Memoria insuficiente para as amostras de latencia.\n");
+        clientes = estados != NULL ? clientes : 0;
+    }
 
-    // Marca tempo DEPOIS de executar
-    fim = clock();
+    pthread_barrier_t largada;
+    Medicao med;
+    int iniciados = 0;
+    if(ok) {
+        pthread_barrier_init(&largada, NULL, (unsigned)clientes + 1);
+        for(int c = 0; c < clientes; c++) {
+            estados[c].cfg = cfg;
+            estados[c].indice = c;
+            estados[c].largada = &largada;
+            if(pthread_create(&threads[c], NULL, cargaCliente, &estados[c]) != 0)
+                break;
+            iniciados++;
+        }
+        if(iniciados < clientes) { // Barreira nunca completaria: encerra sem medir
+            fprintf(stderr, "[ERRO] Nao foi possivel criar os %d clientes.\n", clientes);
+            exit(1);
+        }
+        pthread_barrier_wait(&largada);
+        medicaoIniciar(&med);
+        for(int c = 0; c < clientes; c++)
+            pthread_join(threads[c], NULL);
+        medicaoFinalizar(&med);
+        pthread_barrier_destroy(&largada);
+    }
 
-    // Calcula tempo decorrido em segundos
-    // (fim - inicio) = número de ticks
-    // Divide por CLOCKS_PER_SEC para converter em segundos
-    tempo_cpu = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
+    if(ok) {
+        long long total = (long long)clientes * cfg->operacoes, erros = 0;
+        double decorrido = med.tempoParedeNs / 1e9;
+        for(int c = 0; c < clientes; c++)
+            erros += estados[c].erros;
+        printf("\n=== GERADOR DE CARGA ===\n");
+        printf("Clientes: %d | Operacoes: %lld (%d%% escritas) | Itens iniciais: %d\n", clientes, total,
+               cfg->percentualEscritas, cfg->itensIniciais);
+        printf("Vazao: %.0f operacoes/segundo em %.3f s\n", decorrido > 0 ? total / decorrido : 0.0, decorrido);
+        for(int t = 0; t < TOTAL_TIPOS_CARGA; t++) {
+            int n = 0;
+            for(int c = 0; c < clientes; c++) {
+                memcpy(amostras + n, estados[c].latencias[t], (size_t)estados[c].total[t] * sizeof(long long));
+                n += estados[c].total[t];
+            }
+            if(n == 0)
+                continue;
+            long long mediana, p99;
+            resumirAmostras(amostras, n, &mediana, &p99);
+            printf("%-4s: %d requisicoes | p50 %.1f us | p99 %.1f us | max %.1f us\n", nomesTipo[t], n, mediana / 1e3,
+                   p99 / 1e3, amostras[n - 1] / 1e3);
+        }
+        printf("Erros: %lld\n", erros);
+        printf("========================\n");
+    }
 
-    // Exibe resultado (6 casas decimais para precisão)
-    printf("Tempo de CPU: %.6f segundos\n", tempo_cpu);
-    printf("=================================\n");
-}
\ No newline at end of file
+    socketEnviar(fd, "QUIT\n", 5);
+    fclose(respostas);
+    close(fd);
+    for(int c = 0; estados != NULL && c < clientes; c++)
+        for(int t = 0; t < TOTAL_TIPOS_CARGA; t++)
+            free(estados[c].latencias[t]);
+    free(estados);
+    free(threads);
+    free(amostras);
+    return ok ? 0 : 1;
+}